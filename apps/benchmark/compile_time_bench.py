@@ -0,0 +1,78 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark script for the compile time of models.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+
+from util import get_network
+
+
+def benchmark(network, target, opt_level, repeat):
+    net, params, _, _ = get_network(network, batch_size=1)
+    num_allocs = tvm.get_global_func("runtime.ObjectPoolNumAllocs")
+    num_reused = tvm.get_global_func("runtime.ObjectPoolNumReused")
+
+    costs = []
+    allocs, reused = 0, 0
+    for _ in range(repeat):
+        allocs_begin, reused_begin = num_allocs(), num_reused()
+        begin = time.time()
+        with tvm.transform.PassContext(opt_level=opt_level):
+            relay.build(net, target=target, params=params)
+        costs.append(time.time() - begin)
+        allocs = num_allocs() - allocs_begin
+        reused = num_reused() - reused_begin
+
+    costs = np.array(costs)
+    # Objects only go through the object pool when built with USE_OBJECT_POOL.
+    pool = "%d/%d objects reused" % (reused, allocs) if allocs else "object pool disabled"
+    print(
+        "%-20s %-19s (%s)  %s"
+        % (network, "%.2f s" % np.mean(costs), "%.2f s" % np.std(costs), pool)
+    )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--network",
+        type=str,
+        choices=["resnet-18", "resnet-50", "mobilenet", "bert"],
+        help="The name of neural network",
+    )
+    parser.add_argument("--target", type=str, default="llvm", help="The compilation target")
+    parser.add_argument("--opt-level", type=int, default=3)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    if args.network is None:
+        networks = ["resnet-50", "bert"]
+    else:
+        networks = [args.network]
+
+    print("--------------------------------------------------")
+    print("%-20s %-20s" % ("Network Name", "Compile Time"))
+    print("--------------------------------------------------")
+    for network in networks:
+        benchmark(network, tvm.target.Target(args.target), args.opt_level, args.repeat)
@@ -0,0 +1,73 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of FuseOps on graphs with wide fan-out, from 1k to 100k operators.
+see README.md for the usage of this script.
+"""
+import argparse
+import threading
+import time
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+
+def make_graph(num_ops, width):
+    """Blocks of parallel branches whose outputs are summed, like inception layers."""
+    x = relay.var("x", shape=(1, 16), dtype="float32")
+    y = x
+    count = 0
+    while count < num_ops:
+        branches = []
+        for i in range(width):
+            b = relay.nn.relu(y) if i % 2 == 0 else relay.exp(y)
+            branches.append(b)
+        y = branches[0]
+        for b in branches[1:]:
+            y = relay.add(y, b)
+        count += 2 * width - 1
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def benchmark(num_ops, width, max_depth):
+    mod = transform.InferType()(make_graph(num_ops, width))
+    begin = time.time()
+    with tvm.transform.PassContext(opt_level=3, config={"relay.FuseOps.max_depth": max_depth}):
+        mod = transform.FuseOps()(mod)
+    cost = time.time() - begin
+    print("%-10d width: %-4d FuseOps: %.3f s" % (num_ops, width, cost))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--max-ops", type=int, default=100000)
+    parser.add_argument("--width", type=int, default=8)
+    parser.add_argument("--max-depth", type=int, default=256)
+    args = parser.parse_args()
+
+    # Building and printing deep graphs recurses in python.
+    threading.stack_size(512 * 1024 * 1024)
+
+    def run():
+        num_ops = 1000
+        while num_ops <= args.max_ops:
+            benchmark(num_ops, args.width, args.max_depth)
+            num_ops *= 10
+
+    thread = threading.Thread(target=run)
+    thread.start()
+    thread.join()
@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file map_bench.cc
+ * \brief Microbenchmark of Map, std::unordered_map and support::PersistentMap
+ *  with the key and value types of a substitution map.
+ *
+ *  Build from the TVM root directory after building libtvm:
+ *
+ *    g++ -std=c++14 -O2 -DNDEBUG -Iinclude -Isrc -I3rdparty/dlpack/include \
+ *        -I3rdparty/dmlc-core/include apps/benchmark/map_bench.cc -Lbuild -ltvm \
+ *        -o map_bench
+ *    LD_LIBRARY_PATH=build ./map_bench 100000
+ */
+#include <tvm/node/container.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/var.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "support/persistent_map.h"
+
+using namespace tvm;
+
+using StdMap = std::unordered_map<tir::Var, PrimExpr, ObjectPtrHash, ObjectPtrEqual>;
+using PMap = support::PersistentMap<tir::Var, PrimExpr, ObjectPtrHash, ObjectPtrEqual>;
+
+double Measure(const std::function<void()>& f) {
+  auto begin = std::chrono::high_resolution_clock::now();
+  f();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+void Report(const std::string& name, double map, double stl, double pmap) {
+  printf("%-24s %12.2f %12.2f %12.2f\n", name.c_str(), map, stl, pmap);
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+  std::vector<tir::Var> keys;
+  for (int i = 0; i < n; ++i) keys.push_back(tir::Var("v" + std::to_string(i)));
+  PrimExpr value = IntImm(DataType::Int(32), 1);
+  printf("%-24s %12s %12s %12s\n", "ms", "Map", "unordered_map", "PersistentMap");
+
+  Map<tir::Var, PrimExpr> map;
+  StdMap stl;
+  PMap pmap;
+  Report("insert", Measure([&]() {
+           for (const auto& k : keys) map.Set(k, value);
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) stl[k] = value;
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) pmap.Set(k, value);
+         }));
+
+  size_t found = 0;
+  Report("lookup", Measure([&]() {
+           for (const auto& k : keys) found += map.count(k);
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) found += stl.count(k);
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) found += pmap.count(k);
+         }));
+  CHECK_EQ(found, 3 * keys.size());
+
+  // A pass that extends the map of its parent scope at each level of nesting
+  // keeps every version alive, so each update of Map copies it.
+  int depth = std::min(n, 10000);
+  Report("copy + insert (nested)", Measure([&]() {
+           std::vector<Map<tir::Var, PrimExpr>> scopes(1);
+           for (int i = 0; i < depth; ++i) {
+             Map<tir::Var, PrimExpr> next = scopes.back();
+             next.Set(keys[i], value);
+             scopes.push_back(next);
+           }
+         }),
+         Measure([&]() {
+           std::vector<StdMap> scopes(1);
+           for (int i = 0; i < depth; ++i) {
+             StdMap next = scopes.back();
+             next[keys[i]] = value;
+             scopes.push_back(next);
+           }
+         }),
+         Measure([&]() {
+           std::vector<PMap> scopes(1);
+           for (int i = 0; i < depth; ++i) {
+             PMap next = scopes.back();
+             next.Set(keys[i], value);
+             scopes.push_back(next);
+           }
+         }));
+
+  Report("erase", Measure([&]() {
+           for (const auto& k : keys) map.erase(k);
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) stl.erase(k);
+         }),
+         Measure([&]() {
+           for (const auto& k : keys) pmap.erase(k);
+         }));
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file micro_framing_bench.cc
+ * \brief Throughput of the micro RPC Framer and Unframer over a host loopback.
+ *
+ *  Build from the TVM root directory:
+ *
+ *    g++ -std=c++11 -O2 -Iinclude -Isrc/runtime/crt/include -Isrc/runtime/crt/host \
+ *        -I3rdparty/dlpack/include apps/benchmark/micro_framing_bench.cc \
+ *        src/runtime/crt/utvm_rpc_common/framing.cc \
+ *        src/runtime/crt/utvm_rpc_common/write_stream.cc -o micro_framing_bench
+ *    ./micro_framing_bench 1048576
+ */
+#include <tvm/runtime/crt/rpc_common/framing.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using tvm::runtime::micro_rpc::Framer;
+using tvm::runtime::micro_rpc::Unframer;
+using tvm::runtime::micro_rpc::WriteStream;
+
+extern "C" {
+void TVMLogf(const char* fmt, ...) {}
+void TVMPlatformAbort(int error_code) { abort(); }
+}
+
+/*! \brief Loopback transport that appends everything written to a string. */
+class StringWriteStream : public WriteStream {
+ public:
+  ssize_t Write(const uint8_t* data, size_t data_size_bytes) override {
+    data_.append(reinterpret_cast<const char*>(data), data_size_bytes);
+    return data_size_bytes;
+  }
+
+  void PacketDone(bool is_valid) override { is_valid_ = is_valid; }
+
+  std::string data_;
+  bool is_valid_{false};
+};
+
+template <typename F>
+double MegabytesPerSecond(size_t bytes, int repeat, F f) {
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) f();
+  auto end = std::chrono::steady_clock::now();
+  return bytes * repeat / 1e6 / std::chrono::duration<double>(end - begin).count();
+}
+
+int main(int argc, char** argv) {
+  size_t size = argc > 1 ? std::atol(argv[1]) : 1 << 20;
+  const int repeat = 20;
+  // Tensor-like payload, one byte in 256 needs escaping.
+  std::string payload(size, 0);
+  for (size_t i = 0; i < size; ++i) payload[i] = static_cast<char>((i * 7919) % 256);
+
+  StringWriteStream wire;
+  Framer framer(&wire);
+  double frame = MegabytesPerSecond(size, repeat, [&]() {
+    wire.data_.clear();
+    framer.Write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  });
+
+  StringWriteStream received;
+  Unframer unframer(&received);
+  double unframe = MegabytesPerSecond(size, repeat, [&]() {
+    size_t bytes_consumed;
+    received.data_.clear();
+    unframer.Write(reinterpret_cast<const uint8_t*>(wire.data_.data()), wire.data_.size(),
+                   &bytes_consumed);
+  });
+  if (!received.is_valid_ || received.data_ != payload) {
+    fprintf(stderr, "loopback mismatch\n");
+    return 1;
+  }
+  printf("payload %zu bytes: frame %.1f MB/s, unframe %.1f MB/s\n", size, frame, unframe);
+  return 0;
+}
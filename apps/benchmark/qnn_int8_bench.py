@@ -0,0 +1,164 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of the int8 TOPI kernels with a fused fixed point requantize
+against the QNN lowering of the same quantized dense and conv2d layers.
+see README.md for the usage of this script.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import relay, te, topi
+import tvm.contrib.graph_runtime as runtime
+
+DENSE_WORKLOADS = [(1, 1024, 1024), (16, 1024, 1024), (128, 768, 3072)]
+# batch, in_channel, size, out_channel, kernel
+CONV2D_WORKLOADS = [(1, 64, 56, 64, 3), (1, 256, 14, 256, 3), (1, 512, 7, 2048, 1)]
+
+INPUT_SCALE, KERNEL_SCALE, OUTPUT_SCALE, OUTPUT_ZERO_POINT = 0.05, 0.02, 0.1, 10
+
+
+def measure(func, ctx, args, repeat):
+    evaluator = func.time_evaluator(func.entry_name, ctx, number=10, repeat=repeat)
+    return np.mean(evaluator(*args).results) * 1000
+
+
+def qnn_dense(shape, target, ctx, repeat):
+    """qnn.dense followed by qnn.requantize, compiled by relay.build"""
+    m, k, n = shape
+    data = relay.var("data", shape=(m, k), dtype="uint8")
+    weight = relay.var("weight", shape=(n, k), dtype="int8")
+    out = relay.qnn.op.dense(
+        data,
+        weight,
+        relay.const(0),
+        relay.const(0),
+        relay.const(INPUT_SCALE),
+        relay.const(KERNEL_SCALE),
+        n,
+    )
+    out = relay.qnn.op.requantize(
+        out,
+        relay.const(INPUT_SCALE * KERNEL_SCALE),
+        relay.const(0),
+        relay.const(OUTPUT_SCALE),
+        relay.const(OUTPUT_ZERO_POINT),
+        out_dtype="uint8",
+    )
+    return run_relay(out, {"data": (m, k)}, {"weight": (n, k)}, target, ctx, repeat)
+
+
+def qnn_conv2d(shape, target, ctx, repeat):
+    """qnn.conv2d followed by qnn.requantize, compiled by relay.build"""
+    batch, ic, size, oc, kernel = shape
+    data = relay.var("data", shape=(batch, ic, size, size), dtype="uint8")
+    weight = relay.var("weight", shape=(oc, ic, kernel, kernel), dtype="int8")
+    out = relay.qnn.op.conv2d(
+        data,
+        weight,
+        relay.const(0),
+        relay.const(0),
+        relay.const(INPUT_SCALE),
+        relay.const(KERNEL_SCALE),
+        kernel_size=(kernel, kernel),
+        channels=oc,
+        padding=(kernel // 2, kernel // 2),
+    )
+    out = relay.qnn.op.requantize(
+        out,
+        relay.const(INPUT_SCALE * KERNEL_SCALE),
+        relay.const(0),
+        relay.const(OUTPUT_SCALE),
+        relay.const(OUTPUT_ZERO_POINT),
+        out_dtype="uint8",
+    )
+    inputs = {"data": (batch, ic, size, size)}
+    return run_relay(out, inputs, {"weight": (oc, ic, kernel, kernel)}, target, ctx, repeat)
+
+
+def run_relay(out, inputs, params, target, ctx, repeat):
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+    params = {
+        name: np.random.randint(-128, 128, size=shape).astype("int8")
+        for name, shape in params.items()
+    }
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target, params=params)
+    module = runtime.GraphModule(lib["default"](ctx))
+    for name, shape in inputs.items():
+        module.set_input(name, np.random.randint(0, 128, size=shape).astype("uint8"))
+    evaluator = module.module.time_evaluator("run", ctx, number=10, repeat=repeat)
+    return np.mean(evaluator().results) * 1000
+
+
+def topi_dense(shape, target, ctx, repeat):
+    """topi.x86.dense_int8 with the requantize computed in its tiles"""
+    m, k, n = shape
+    multiplier, shift = topi.nn.get_fixed_point_multiplier_shift(
+        INPUT_SCALE * KERNEL_SCALE / OUTPUT_SCALE
+    )
+    data = te.placeholder((m, k), name="data", dtype="uint8")
+    weight = te.placeholder((n, k), name="weight", dtype="int8")
+    with tvm.target.Target(target):
+        out = topi.x86.dense_int8(data, weight, None, "int32")
+        out = topi.nn.fixed_point_requantize(out, multiplier, shift, OUTPUT_ZERO_POINT)
+        s = topi.x86.schedule_dense_int8([out])
+    return run_topi(s, [data, weight, out], target, ctx, repeat)
+
+
+def topi_conv2d(shape, target, ctx, repeat):
+    """topi.x86.conv2d_nchw_int8 with the requantize computed in its tiles"""
+    batch, ic, size, oc, kernel = shape
+    multiplier, shift = topi.nn.get_fixed_point_multiplier_shift(
+        INPUT_SCALE * KERNEL_SCALE / OUTPUT_SCALE
+    )
+    data = te.placeholder((batch, ic, size, size), name="data", dtype="uint8")
+    weight = te.placeholder((oc, ic, kernel, kernel), name="weight", dtype="int8")
+    with tvm.target.Target(target):
+        out = topi.x86.conv2d_nchw_int8(data, weight, 1, kernel // 2, 1, "int32")
+        out = topi.nn.fixed_point_requantize(out, multiplier, shift, OUTPUT_ZERO_POINT)
+        s = topi.x86.schedule_conv2d_nchw_int8([out])
+    return run_topi(s, [data, weight, out], target, ctx, repeat)
+
+
+def run_topi(s, tensors, target, ctx, repeat):
+    func = tvm.build(s, tensors, target)
+    args = []
+    for tensor in tensors:
+        shape = [int(dim) for dim in tensor.shape]
+        args.append(tvm.nd.array(np.random.randint(0, 64, size=shape).astype(tensor.dtype), ctx))
+    return measure(func, ctx, args, repeat)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=cascadelake")
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    ctx = tvm.cpu(0)
+    print("%-28s %12s %12s %12s" % ("workload", "qnn (ms)", "topi (ms)", "speedup"))
+    for name, workloads, qnn, fused in [
+        ("dense", DENSE_WORKLOADS, qnn_dense, topi_dense),
+        ("conv2d", CONV2D_WORKLOADS, qnn_conv2d, topi_conv2d),
+    ]:
+        for shape in workloads:
+            baseline = qnn(shape, args.target, ctx, args.repeat)
+            cost = fused(shape, args.target, ctx, args.repeat)
+            workload = "%s %s" % (name, "x".join(str(dim) for dim in shape))
+            print("%-28s %12.3f %12.3f %11.2fx" % (workload, baseline, cost, baseline / cost))
@@ -0,0 +1,77 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of Relay passes on dataflow graphs from 1k to 1M nodes.
+see README.md for the usage of this script.
+"""
+import argparse
+import threading
+import time
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+
+
+def make_graph(num_nodes):
+    """A long chain of elementwise operators with some branches."""
+    x = relay.var("x", shape=(1, 16), dtype="float32")
+    y = x
+    for i in range(num_nodes):
+        if i % 16 == 0:
+            y = relay.add(y, relay.multiply(x, relay.const(2.0)))
+        else:
+            y = relay.nn.relu(y)
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def benchmark(num_nodes, passes):
+    mod = make_graph(num_nodes)
+    mod = transform.InferType()(mod)
+    results = []
+    for name, opt_pass in passes:
+        begin = time.time()
+        with tvm.transform.PassContext(opt_level=3):
+            opt_pass(mod)
+        results.append((name, time.time() - begin))
+    print(
+        "%-10d %s"
+        % (num_nodes, "  ".join("%s: %.3f s" % (name, cost) for name, cost in results))
+    )
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--max-nodes", type=int, default=1000000)
+    args = parser.parse_args()
+
+    passes = [
+        ("InferType", transform.InferType()),
+        ("FoldConstant", transform.FoldConstant()),
+        ("FuseOps", transform.FuseOps()),
+    ]
+    # Deep graphs need a large stack until every pass is iterative.
+    threading.stack_size(512 * 1024 * 1024)
+
+    def run():
+        num_nodes = 1000
+        while num_nodes <= args.max_nodes:
+            benchmark(num_nodes, passes)
+            num_nodes *= 10
+
+    thread = threading.Thread(target=run)
+    thread.start()
+    thread.join()
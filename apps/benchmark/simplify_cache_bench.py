@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of lowering with and without the memo of arith::Analyzer simplifications.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import tvm
+from tvm import te, topi
+
+
+def make_conv2d():
+    """A tiled conv2d, whose bound inference simplifies many index expressions."""
+    data = te.placeholder((1, 64, 56, 56), name="data")
+    kernel = te.placeholder((64, 64, 3, 3), name="kernel")
+    conv = topi.nn.conv2d_nchw(data, kernel, 1, 1, 1)
+    s = te.create_schedule(conv.op)
+    n, c, h, w = s[conv].op.axis
+    rc, ry, rx = s[conv].op.reduce_axis
+    co, ci = s[conv].split(c, factor=16)
+    ho, hi = s[conv].split(h, factor=7)
+    wo, wi = s[conv].split(w, factor=8)
+    rco, rci = s[conv].split(rc, factor=4)
+    s[conv].reorder(n, co, ho, wo, rco, ry, rx, rci, hi, ci, wi)
+    s[conv].vectorize(wi)
+    s[conv].unroll(ci)
+    return s, [data, kernel, conv]
+
+
+def make_matmul():
+    """A matmul tiled in two levels."""
+    A = te.placeholder((512, 512), name="A")
+    B = te.placeholder((512, 512), name="B")
+    k = te.reduce_axis((0, 512), name="k")
+    C = te.compute((512, 512), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="C")
+    s = te.create_schedule(C.op)
+    i, j = s[C].op.axis
+    io, ii = s[C].split(i, factor=32)
+    jo, ji = s[C].split(j, factor=32)
+    iio, iii = s[C].split(ii, factor=4)
+    jio, jii = s[C].split(ji, factor=8)
+    ko, ki = s[C].split(k, factor=8)
+    s[C].reorder(io, jo, ko, iio, jio, ki, iii, jii)
+    s[C].vectorize(jii)
+    return s, [A, B, C]
+
+
+def benchmark(make, enabled, number):
+    set_enabled = tvm.get_global_func("arith.SetSimplifyCacheEnabled")
+    previous = set_enabled(enabled)
+    s, args = make()
+    tvm.lower(s, args)
+    begin = time.time()
+    for _ in range(number):
+        tvm.lower(s, args)
+    set_enabled(previous)
+    return (time.time() - begin) / number
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--number", type=int, default=20)
+    args = parser.parse_args()
+
+    for name, make in [("conv2d", make_conv2d), ("matmul", make_matmul)]:
+        uncached = benchmark(make, False, args.number)
+        cached = benchmark(make, True, args.number)
+        print("%-8s without memo %8.2f ms" % (name, uncached * 1000))
+        print("%-8s with memo    %8.2f ms" % (name, cached * 1000))
+        print("%-8s speedup      %8.2fx" % (name, uncached / max(cached, 1e-9)))
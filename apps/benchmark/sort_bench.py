@@ -0,0 +1,98 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of the contrib sort kernels on the sizes of detection and
+classification models, against the stable sort of numpy.
+see README.md for the usage of this script.
+"""
+import argparse
+import timeit
+
+import numpy as np
+
+import tvm
+from tvm import te
+
+# name, shape, k; argsort_nms when k is None, topk otherwise.
+WORKLOADS = [
+    ("ssd argsort_nms", (1, 8732), None),
+    ("yolo argsort_nms", (1, 10647), None),
+    ("ssd batch argsort_nms", (16, 8732), None),
+    ("classes topk", (32, 1000), 5),
+    ("vocabulary topk", (32, 50000), 10),
+    ("vocabulary topk full", (4, 50000), 0),
+]
+
+
+def build(shape, k):
+    """Build a call of the contrib sort kernel on the last axis."""
+    data = te.placeholder(shape, name="data")
+    if k is None:
+        sort_num = te.placeholder(shape[:-1], name="sort_num", dtype="int32")
+        out = te.extern(
+            shape,
+            [data, sort_num],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.argsort_nms", ins[0], ins[1], outs[0], -1, False
+            ),
+            dtype="int32",
+        )
+        args = [data, sort_num, out]
+    else:
+        out_shape = shape[:-1] + (k if k > 0 else shape[-1],)
+        values, indices = te.extern(
+            [out_shape, out_shape],
+            [data],
+            lambda ins, outs: tvm.tir.call_packed(
+                "tvm.contrib.sort.topk", ins[0], outs[0], outs[1], k, -1, "both", False
+            ),
+            dtype=["float32", "int32"],
+        )
+        args = [data, values, indices]
+    s = te.create_schedule(args[-1].op)
+    return tvm.build(s, args, "llvm"), args
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    ctx = tvm.cpu(0)
+    print("%-28s %12s %12s %12s" % ("workload", "numpy (ms)", "tvm (ms)", "speedup"))
+    for name, shape, k in WORKLOADS:
+        func, placeholders = build(shape, k)
+        np_data = np.random.uniform(size=shape).astype("float32")
+        arrays = [tvm.nd.array(np_data, ctx)]
+        if k is None:
+            arrays.append(tvm.nd.array(np.full(shape[:-1], shape[-1], dtype="int32"), ctx))
+        for out in placeholders[len(arrays) :]:
+            shape_out = [int(dim) for dim in out.shape]
+            arrays.append(tvm.nd.array(np.zeros(shape_out, dtype=out.dtype), ctx))
+        evaluator = func.time_evaluator(func.entry_name, ctx, number=10, repeat=args.repeat)
+        cost = np.mean(evaluator(*arrays).results) * 1000
+        baseline = (
+            min(
+                timeit.repeat(
+                    lambda: np.argsort(-np_data, axis=-1, kind="stable"),
+                    number=10,
+                    repeat=args.repeat,
+                )
+            )
+            * 100
+        )
+        workload = "%s %s" % (name, "x".join(str(dim) for dim in shape))
+        print("%-28s %12.3f %12.3f %11.2fx" % (workload, baseline, cost, baseline / cost))
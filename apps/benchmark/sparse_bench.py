@@ -0,0 +1,104 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of the sparse dense and conv2d kernels against the dense ones on
+layers whose weights are pruned by blocks.
+see README.md for the usage of this script.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import relay
+import tvm.contrib.graph_runtime as runtime
+
+# batch, in_features, out_features
+DENSE_WORKLOADS = [(1, 512, 512), (32, 1024, 256), (128, 768, 3072)]
+# batch, size, in_channel, out_channel, kernel
+CONV2D_WORKLOADS = [(1, 56, 64, 64, 1), (1, 28, 128, 128, 3), (1, 14, 256, 1024, 1)]
+
+
+def prune(weight, blocksize, sparsity):
+    """Zero the blocks of the (rows, columns) matrix view of weight at random."""
+    rows = weight.shape[-1] if weight.ndim == 4 else weight.shape[0]
+    mat = weight.reshape(-1, rows).T if weight.ndim == 4 else weight
+    mask = np.random.random((mat.shape[0] // blocksize[0], mat.shape[1] // blocksize[1]))
+    mat = mat * np.kron(mask >= sparsity, np.ones(blocksize, dtype=weight.dtype))
+    return np.ascontiguousarray(mat.T).reshape(weight.shape) if weight.ndim == 4 else mat
+
+
+def dense(shape):
+    batch, in_features, out_features = shape
+    data = relay.var("data", shape=(batch, in_features), dtype="float32")
+    weight = relay.var("weight", shape=(out_features, in_features), dtype="float32")
+    out = relay.nn.relu(relay.nn.dense(data, weight))
+    return out, (batch, in_features), (out_features, in_features)
+
+
+def conv2d(shape):
+    batch, size, in_channel, out_channel, kernel = shape
+    data_shape = (batch, size, size, in_channel)
+    weight_shape = (kernel, kernel, in_channel, out_channel)
+    data = relay.var("data", shape=data_shape, dtype="float32")
+    weight = relay.var("weight", shape=weight_shape, dtype="float32")
+    out = relay.nn.conv2d(
+        data,
+        weight,
+        kernel_size=(kernel, kernel),
+        padding=(kernel // 2, kernel // 2),
+        data_layout="NHWC",
+        kernel_layout="HWIO",
+    )
+    return relay.nn.relu(out), data_shape, weight_shape
+
+
+def run(func, params, data_shape, target, ctx, repeat):
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(tvm.IRModule.from_expr(func), target, params=params)
+    module = runtime.GraphModule(lib["default"](ctx))
+    module.set_input("data", np.random.randn(*data_shape).astype("float32"))
+    evaluator = module.module.time_evaluator("run", ctx, number=10, repeat=repeat)
+    return np.mean(evaluator().results) * 1000
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--target", type=str, default="llvm -mcpu=skylake-avx512")
+    parser.add_argument("--sparsity", type=float, default=0.9)
+    parser.add_argument("--repeat", type=int, default=5)
+    args = parser.parse_args()
+
+    ctx = tvm.cpu(0)
+    target = tvm.target.Target(args.target)
+    with target:
+        blocksize = relay.data_dep_optimization.bsr_dense.get_default_blocksize()
+    print("block size %s, sparsity %.2f" % (blocksize, args.sparsity))
+    print("%-28s %12s %12s %12s" % ("workload", "dense (ms)", "sparse (ms)", "speedup"))
+    for name, workloads, build, convert in [
+        ("dense", DENSE_WORKLOADS, dense, relay.data_dep_optimization.bsr_dense.convert),
+        ("conv2d", CONV2D_WORKLOADS, conv2d, relay.data_dep_optimization.bsr_conv2d.convert),
+    ]:
+        for shape in workloads:
+            out, data_shape, weight_shape = build(shape)
+            func = relay.Function(relay.analysis.free_vars(out), out)
+            weight = np.random.randn(*weight_shape).astype("float32")
+            params = {"weight": tvm.nd.array(prune(weight, blocksize, args.sparsity))}
+            baseline = run(func, params, data_shape, target, ctx, args.repeat)
+            sparse_func, sparse_params = convert(func, params, blocksize, args.sparsity / 2)
+            cost = run(sparse_func, sparse_params, data_shape, target, ctx, args.repeat)
+            workload = "%s %s" % (name, "x".join(str(dim) for dim in shape))
+            print("%-28s %12.3f %12.3f %11.2fx" % (workload, baseline, cost, baseline / cost))
@@ -0,0 +1,70 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark of the compile engine cache lookup, which structurally hashes its key.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+
+
+def make_primitive_func(num_ops, width):
+    """A primitive function with a long chain of elementwise operators."""
+    x = relay.var("x", shape=(1, width))
+    y = x
+    for i in range(num_ops):
+        y = relay.add(relay.multiply(y, relay.const(1.0 + i)), x)
+        y = relay.tanh(y)
+    func = relay.Function([x], y)
+    func = func.with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+    return relay.transform.InferType()(tvm.IRModule.from_expr(func))["main"]
+
+
+def benchmark(funcs, target):
+    engine = relay.backend.compile_engine.get()
+    engine.clear()
+    # The first lookup compiles the function, the others hit the cache.
+    engine.lower(funcs[0], target)
+    begin = time.time()
+    for func in funcs:
+        engine.lower(func, target)
+    return (time.time() - begin) / len(funcs)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num-ops", type=int, default=500)
+    parser.add_argument("--number", type=int, default=100)
+    args = parser.parse_args()
+
+    func = make_primitive_func(args.num_ops, 16)
+    # Structurally equal copies are hashed on every lookup, the same function
+    # reuses the hash of the cache key.
+    copies = [
+        relay.Function(func.params, func.body, func.ret_type, func.type_params, func.attrs)
+        for _ in range(args.number)
+    ]
+    target = tvm.target.Target("llvm")
+    uncached = benchmark(copies, target)
+    cached = benchmark([func] * args.number, target)
+    print("%-24s %.3f ms" % ("lookup of a copy", uncached * 1000))
+    print("%-24s %.3f ms" % ("lookup of the same", cached * 1000))
+    print("%-24s %.1fx" % ("speedup", uncached / np.maximum(cached, 1e-9)))
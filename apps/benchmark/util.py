@@ -17,17 +17,92 @@
 """Utility for benchmark"""
 
 import sys
+
+import numpy as np
+import tvm
 from tvm import relay
 from tvm.relay import testing
 
 
+def get_bert_encoder(
+    batch_size, seq_len=128, hidden=768, num_heads=12, num_layers=12, dtype="float32"
+):
+    """Get a BERT-base like transformer encoder operating on embedded tokens.
+
+    Parameters
+    ----------
+    batch_size: int
+        batch size
+    seq_len: int
+        The sequence length.
+    hidden: int
+        The hidden size.
+    num_heads: int
+        The number of attention heads.
+    num_layers: int
+        The number of encoder layers.
+    dtype: str
+        Data type
+
+    Returns
+    -------
+    net: tvm.IRModule
+        The relay module of the encoder
+    params: dict
+        The random parameters
+    """
+    head_dim = hidden // num_heads
+    data = relay.var("data", shape=(batch_size, seq_len, hidden), dtype=dtype)
+    params = {}
+
+    def dense(x, name, units, in_units):
+        w = relay.var(name + "_weight", shape=(units, in_units), dtype=dtype)
+        b = relay.var(name + "_bias", shape=(units,), dtype=dtype)
+        params[w.name_hint] = np.random.uniform(-0.1, 0.1, (units, in_units)).astype(dtype)
+        params[b.name_hint] = np.zeros((units,), dtype)
+        return relay.nn.bias_add(relay.nn.dense(x, w), b, axis=-1)
+
+    def layer_norm(x, name):
+        gamma = relay.var(name + "_gamma", shape=(hidden,), dtype=dtype)
+        beta = relay.var(name + "_beta", shape=(hidden,), dtype=dtype)
+        params[gamma.name_hint] = np.ones((hidden,), dtype)
+        params[beta.name_hint] = np.zeros((hidden,), dtype)
+        return relay.nn.layer_norm(x, gamma, beta)
+
+    def split_heads(x):
+        x = relay.reshape(x, (batch_size, seq_len, num_heads, head_dim))
+        x = relay.transpose(x, (0, 2, 1, 3))
+        return relay.reshape(x, (batch_size * num_heads, seq_len, head_dim))
+
+    x = relay.reshape(data, (batch_size * seq_len, hidden))
+    for i in range(num_layers):
+        name = "layer%d" % i
+        q = split_heads(dense(x, name + "_query", hidden, hidden))
+        k = split_heads(dense(x, name + "_key", hidden, hidden))
+        v = relay.transpose(split_heads(dense(x, name + "_value", hidden, hidden)), (0, 2, 1))
+        scores = relay.nn.batch_matmul(q, k) * relay.const(1.0 / np.sqrt(head_dim), dtype)
+        attn = relay.nn.batch_matmul(relay.nn.softmax(scores), v)
+        attn = relay.reshape(attn, (batch_size, num_heads, seq_len, head_dim))
+        attn = relay.transpose(attn, (0, 2, 1, 3))
+        attn = relay.reshape(attn, (batch_size * seq_len, hidden))
+        x = layer_norm(x + dense(attn, name + "_attn_out", hidden, hidden), name + "_ln0")
+        ffn = dense(x, name + "_ffn0", 4 * hidden, hidden)
+        ffn = relay.multiply(ffn, relay.sigmoid(relay.const(1.702, dtype) * ffn))
+        x = layer_norm(x + dense(ffn, name + "_ffn1", hidden, 4 * hidden), name + "_ln1")
+    out = relay.reshape(x, (batch_size, seq_len, hidden))
+    func = relay.Function(relay.analysis.free_vars(out), out)
+    params = {k: tvm.nd.array(v) for k, v in params.items()}
+    return tvm.IRModule.from_expr(func), params
+
+
 def get_network(name, batch_size, dtype="float32"):
     """Get the symbol definition and random weight of a network
 
     Parameters
     ----------
     name: str
-        The name of the network, can be 'resnet-18', 'resnet-50', 'vgg-16', 'inception_v3', 'mobilenet', ...
+        The name of the network, can be 'resnet-18', 'resnet-50', 'vgg-16', 'inception_v3', 'mobilenet',
+        'bert', ...
     batch_size: int
         batch size
     dtype: str
@@ -72,6 +147,10 @@ def get_network(name, batch_size, dtype="float32"):
         net, params = testing.squeezenet.get_workload(
             batch_size=batch_size, version=version, dtype=dtype
         )
+    elif name == "bert":
+        input_shape = (batch_size, 128, 768)
+        output_shape = input_shape
+        net, params = get_bert_encoder(batch_size, dtype=dtype)
     elif name == "mxnet":
         # an example for mxnet model
         from mxnet.gluon.model_zoo.vision import get_model
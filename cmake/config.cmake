@@ -248,6 +248,10 @@ set(USE_TF_TVMDSOOP OFF)
 # Whether to use STL's std::unordered_map or TVM's POD compatible Map
 set(USE_FALLBACK_STL_MAP OFF)
 
+# Whether to allocate objects, e.g. IR nodes, from thread-local free lists
+# instead of calling new/delete for each of them
+set(USE_OBJECT_POOL OFF)
+
 # Whether to use hexagon device
 set(USE_HEXAGON_DEVICE OFF)
 set(USE_HEXAGON_SDK /path/to/sdk)
@@ -28,6 +28,7 @@
 #include <tvm/ir/expr.h>
 #include <tvm/support/with.h>
 
+#include <functional>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -276,6 +277,8 @@ class RewriteSimplifier {
   explicit RewriteSimplifier(Analyzer* parent);
   TVM_DLL ~RewriteSimplifier();
   class Impl;
+  /*! \brief The parent analyzer */
+  Analyzer* parent_;
   /*! \brief Internal impl */
   Impl* impl_;
 };
@@ -307,6 +310,61 @@ class CanonicalSimplifier {
   explicit CanonicalSimplifier(Analyzer* parent);
   TVM_DLL ~CanonicalSimplifier();
   class Impl;
+  /*! \brief The parent analyzer */
+  Analyzer* parent_;
+  /*! \brief Internal impl */
+  Impl* impl_;
+};
+
+/*!
+ * \brief Memo of simplification results, keyed by the identity of the expression.
+ *
+ *  The entries are only valid for the current state of the analyzer.
+ *  Binding a variable clears the memo. Each constraint scope starts
+ *  with an empty memo, and the memo of the enclosing scope is restored
+ *  when it exits.
+ */
+class SimplifyCache {
+ public:
+  /*! \brief The simplifications that are memoized. */
+  enum Kind : int {
+    kRewriteSimplify = 0,
+    kCanonicalSimplify = 1,
+    /*! \brief Analyzer::Simplify, the number of steps is added to the kind. */
+    kSimplify = 2
+  };
+  /*!
+   * \brief Get the memoized simplification of expr, or run it and memoize the result.
+   * \param expr The expression to be simplified.
+   * \param kind The kind of the simplification.
+   * \param fsimplify The simplification to run when the result is not memoized.
+   * \return The simplified expression.
+   */
+  TVM_DLL PrimExpr operator()(const PrimExpr& expr, int kind,
+                              const std::function<PrimExpr(const PrimExpr&)>& fsimplify);
+  /*!
+   * \brief Drop all the entries.
+   * \note Must be called when the information of a variable changes,
+   *       which Analyzer::Bind does.
+   */
+  TVM_DLL void Clear();
+  /*! \return The number of lookups that found a memoized result. */
+  TVM_DLL int64_t num_hits() const;
+  /*! \return The number of lookups that ran the simplification. */
+  TVM_DLL int64_t num_misses() const;
+
+ private:
+  friend class Analyzer;
+  friend class ConstraintContext;
+  SimplifyCache();
+  TVM_DLL ~SimplifyCache();
+  /*! \brief Start the memo of a new constraint scope. */
+  void EnterScope();
+  /*! \brief Drop the entries of the current scope. */
+  void ClearScope();
+  /*! \brief Restore the memo of the enclosing scope. */
+  void ExitScope();
+  class Impl;
   /*! \brief Internal impl */
   Impl* impl_;
 };
@@ -383,6 +441,7 @@ class IntSetAnalyzer {
  * NOTE for sub-analyzer developers:
  * If the analyzer uses memoization, we need to clear the internal
  * cache when information about a Var has been overridden.
+ * This includes simplify_cache when a sub-analyzer is updated directly.
  */
 class TVM_DLL Analyzer {
  public:
@@ -401,6 +460,8 @@ class TVM_DLL Analyzer {
   CanonicalSimplifier canonical_simplify;
   /*! \brief sub-analyzer: int set */
   IntSetAnalyzer int_set;
+  /*! \brief memo of the simplifiers */
+  SimplifyCache simplify_cache;
   /*! \brief constructor */
   Analyzer();
   /*!
@@ -29,6 +29,10 @@
 
 #include <string>
 
+namespace dmlc {
+class Stream;
+}  // namespace dmlc
+
 namespace tvm {
 /*!
  * \brief save the node as well as all the node it depends on as json.
@@ -47,5 +51,38 @@ TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
  */
 TVM_DLL runtime::ObjectRef LoadJSON(std::string json_str);
 
+/*!
+ * \brief Save the node and all the nodes it depends on in a compact binary format.
+ *
+ *  The NDArrays referenced by the nodes are stored as raw payloads aligned
+ *  to 64 bytes from the start of the stream. Unlike SaveJSON, the format is
+ *  tied to the version of TVM that wrote it.
+ *
+ * \param strm The output stream.
+ * \param node The node to save.
+ */
+TVM_DLL void SaveBinary(dmlc::Stream* strm, const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load a node saved by SaveBinary.
+ * \param strm The input stream.
+ * \return The loaded node.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(dmlc::Stream* strm);
+
+/*!
+ * \brief Save the node in the binary format to a string.
+ * \param node The node to save.
+ * \return The binary blob.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load a node from a binary blob created by SaveBinary.
+ * \param blob The binary blob.
+ * \return The loaded node.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(const std::string& blob);
+
 }  // namespace tvm
 #endif  // TVM_NODE_SERIALIZATION_H_
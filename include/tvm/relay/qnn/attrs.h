@@ -60,6 +60,35 @@ struct RequantizeAttrs : public tvm::AttrsNode<RequantizeAttrs> {
   }
 };
 
+/*! \brief Attribute for the fused fixed point requantize epilogue */
+struct FixedPointRequantizeAttrs : public tvm::AttrsNode<FixedPointRequantizeAttrs> {
+  int axis;
+  int fractional_bits;
+  int output_zero_point;
+  int out_min;
+  int out_max;
+  DataType compute_dtype;
+  DataType out_dtype;
+
+  TVM_DECLARE_ATTRS(FixedPointRequantizeAttrs, "relay.attrs.FixedPointRequantizeAttrs") {
+    TVM_ATTR_FIELD(axis)
+        .describe("The channel axis of the bias and of the per channel multipliers.")
+        .set_default(-1);
+    TVM_ATTR_FIELD(fractional_bits)
+        .describe("Number of fractional bits of the multipliers.")
+        .set_default(31);
+    TVM_ATTR_FIELD(output_zero_point).describe("The zero point of the output.").set_default(0);
+    TVM_ATTR_FIELD(out_min).describe("The lower bound the output is clipped to.");
+    TVM_ATTR_FIELD(out_max).describe("The upper bound the output is clipped to.");
+    TVM_ATTR_FIELD(compute_dtype)
+        .set_default(DataType::Int(64))
+        .describe(
+            "int64 to multiply in high precision, int32 when the ranges of the input and of the "
+            "multipliers are known to keep the products in int32.");
+    TVM_ATTR_FIELD(out_dtype).describe("Output data type, one of [int8, uint8, int32].");
+  }
+};
+
 /*! \brief Attribute for quantize operator */
 struct QuantizeAttrs : public tvm::AttrsNode<QuantizeAttrs> {
   DataType out_dtype;
@@ -51,6 +51,19 @@ namespace transform {
  */
 TVM_DLL Pass Legalize();
 
+/*!
+ * \brief Fuse the bias add, qnn.requantize, clip and cast that follow a qnn.conv2d or qnn.dense
+ * into a single qnn.fixed_point_requantize, which is computed in int32 when the value ranges
+ * allow it. Only requantize with UPWARD rounding and constant params is fused.
+ *
+ * The pass is not part of Legalize, it is applied on request before the build. The build keeps
+ * the fused op and computes it with topi.nn.fixed_point_requantize in the epilogue of the
+ * producer. qnn.transform.CanonicalizeOps lowers it to core Relay ops for external codegens.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass FuseRequantize();
+
 }  // namespace transform
 
 }  // namespace qnn
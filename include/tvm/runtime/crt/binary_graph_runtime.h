@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file binary_graph_runtime.h
+ * \brief Graph runtime that runs a precomputed binary graph in place.
+ *
+ * The binary graph is produced by tvm.micro.serialize_graph from the graph JSON and the params.
+ * It holds the tensor table, the storage plan with the offset of each storage in the workspace,
+ * the operator table and the params, so the runtime neither parses nor allocates: the graph
+ * can stay in flash and all the RAM is provided by the caller. The workspaces the kernels
+ * allocate while the graph runs come from a region of that RAM planned at build time, see
+ * tvm.micro.kernel_workspace_size.
+ *
+ * All the fields are little endian. The sections are aligned to 8 bytes and the param payloads
+ * to `alignment` bytes from the start of the graph.
+ */
+#ifndef TVM_RUNTIME_CRT_BINARY_GRAPH_RUNTIME_H_
+#define TVM_RUNTIME_CRT_BINARY_GRAPH_RUNTIME_H_
+
+#include <dlpack/dlpack.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/memory.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Magic number of the binary graph, "TVGB". */
+#define TVM_BINARY_GRAPH_MAGIC 0x42475654
+/*! \brief Version of the binary graph format. */
+#define TVM_BINARY_GRAPH_VERSION 1
+/*! \brief Storage id of the tensors whose data is a param in the graph. */
+#define TVM_BINARY_GRAPH_PARAM_STORAGE 0xFFFFFFFF
+
+/*! \brief Header of the binary graph, the offsets are from the start of the graph. */
+typedef struct TVMBinaryGraphHeader {
+  uint32_t magic;
+  uint32_t version;
+  /*! \brief Total size of the graph in bytes. */
+  uint32_t total_size;
+  /*! \brief Alignment of the workspace storages and of the params. */
+  uint32_t alignment;
+  /*! \brief Size of the workspace that holds all the storages. */
+  uint32_t workspace_size;
+  uint32_t num_tensors;
+  uint32_t tensors_offset;
+  /*! \brief Offset of the int64 table that holds the shapes of the tensors. */
+  uint32_t shapes_offset;
+  uint32_t num_storages;
+  uint32_t storages_offset;
+  uint32_t num_inputs;
+  uint32_t inputs_offset;
+  uint32_t num_outputs;
+  uint32_t outputs_offset;
+  uint32_t num_ops;
+  uint32_t ops_offset;
+  /*! \brief Offset of the uint32 table of the tensor ids of the op arguments. */
+  uint32_t num_op_args;
+  uint32_t op_args_offset;
+  uint32_t num_params;
+  uint32_t params_offset;
+  /*! \brief Offset of the NUL terminated names of the inputs and the functions. */
+  uint32_t strings_offset;
+  /*! \brief Size of the region that holds the workspaces of the kernels, 0 to use the heap. */
+  uint32_t kernel_workspace_size;
+} TVMBinaryGraphHeader;
+
+/*! \brief A tensor of the graph. */
+typedef struct TVMBinaryGraphTensor {
+  /*! \brief The storage of the tensor, or TVM_BINARY_GRAPH_PARAM_STORAGE. */
+  uint32_t storage_id;
+  /*! \brief Index of the first dimension in the shape table. */
+  uint32_t shape_index;
+  uint32_t ndim;
+  uint8_t dtype_code;
+  uint8_t dtype_bits;
+  uint16_t dtype_lanes;
+} TVMBinaryGraphTensor;
+
+/*! \brief A storage of the workspace. */
+typedef struct TVMBinaryGraphStorage {
+  /*! \brief Offset in the workspace. */
+  uint32_t offset;
+  uint32_t size;
+} TVMBinaryGraphStorage;
+
+/*! \brief An input of the graph. */
+typedef struct TVMBinaryGraphInput {
+  uint32_t tensor_id;
+  /*! \brief Offset of the name in the string table. */
+  uint32_t name_offset;
+} TVMBinaryGraphInput;
+
+/*! \brief An operator call. */
+typedef struct TVMBinaryGraphOp {
+  /*! \brief Offset of the function name in the string table. */
+  uint32_t func_name_offset;
+  /*! \brief Index of the first argument in the op argument table. */
+  uint32_t arg_begin;
+  uint32_t num_args;
+  uint32_t reserved;
+} TVMBinaryGraphOp;
+
+/*! \brief A param that is stored in the graph. */
+typedef struct TVMBinaryGraphParam {
+  uint32_t tensor_id;
+  /*! \brief Offset of the payload from the start of the graph. */
+  uint32_t data_offset;
+  uint32_t nbytes;
+  uint32_t reserved;
+} TVMBinaryGraphParam;
+
+/*! \brief Runtime state of a binary graph, all the arrays live in the caller memory. */
+typedef struct TVMBinaryGraphRuntime {
+  /*! \brief The graph. */
+  const TVMBinaryGraphHeader* graph;
+  /*! \brief The tensors, one per tensor of the graph. */
+  DLTensor* tensors;
+  /*! \brief The function of each op. */
+  TVMFunctionHandle* op_funcs;
+  /*! \brief The arguments of all the ops. */
+  TVMValue* arg_values;
+  int* arg_type_codes;
+  /*! \brief The memory of the storages. */
+  uint8_t* workspace;
+  /*! \brief The workspaces of the kernels. */
+  TVMStaticWorkspace kernel_workspace;
+} TVMBinaryGraphRuntime;
+
+/*!
+ * \brief Get the number of bytes of memory needed to run a graph.
+ * \param graph The binary graph.
+ * \param graph_size Size of the graph in bytes.
+ * \return The number of bytes to pass to TVMBinaryGraphRuntime_Init, 0 if the graph is invalid.
+ */
+size_t TVMBinaryGraphRuntime_MemorySize(const void* graph, size_t graph_size);
+
+/*!
+ * \brief Initialize the runtime of a binary graph, without allocating memory.
+ *
+ * \param runtime The runtime to initialize.
+ * \param graph The binary graph, it must outlive the runtime.
+ * \param graph_size Size of the graph in bytes.
+ * \param module The module with the functions, NULL to look them up in the global registry.
+ * \param ctx The context of the tensors.
+ * \param memory Memory for the workspace, the kernel workspace and the tables of the runtime,
+ *     it must outlive the runtime.
+ * \param memory_size Size of memory, at least TVMBinaryGraphRuntime_MemorySize(graph, graph_size).
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMBinaryGraphRuntime_Init(TVMBinaryGraphRuntime* runtime, const void* graph,
+                                           size_t graph_size, TVMModuleHandle module,
+                                           DLContext ctx, uint8_t* memory, size_t memory_size);
+
+/*!
+ * \brief Get the index of an input.
+ * \param runtime The runtime.
+ * \param name The name of the input.
+ * \return The index of the input, -1 if there is no input with the name.
+ */
+int TVMBinaryGraphRuntime_GetInputIndex(const TVMBinaryGraphRuntime* runtime, const char* name);
+
+/*!
+ * \brief Get an input tensor, the caller writes the input into its data.
+ * \param runtime The runtime.
+ * \param index The index of the input.
+ * \return The tensor, NULL if the index is out of range.
+ */
+DLTensor* TVMBinaryGraphRuntime_GetInput(TVMBinaryGraphRuntime* runtime, uint32_t index);
+
+/*!
+ * \brief Get an output tensor, its data is valid until the next run.
+ * \param runtime The runtime.
+ * \param index The index of the output.
+ * \return The tensor, NULL if the index is out of range.
+ */
+DLTensor* TVMBinaryGraphRuntime_GetOutput(TVMBinaryGraphRuntime* runtime, uint32_t index);
+
+/*!
+ * \brief Run all the ops of the graph.
+ *
+ * When the graph has a kernel workspace, TVMBackendAllocWorkspace is served from it while the
+ * ops run, so nothing is allocated from the heap.
+ *
+ * \param runtime The runtime.
+ * \return 0 on success, otherwise the error of the first op that failed.
+ */
+int TVMBinaryGraphRuntime_Run(TVMBinaryGraphRuntime* runtime);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_BINARY_GRAPH_RUNTIME_H_
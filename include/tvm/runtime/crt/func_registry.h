@@ -78,17 +78,35 @@ tvm_crt_error_t TVMFuncRegistry_GetByIndex(const TVMFuncRegistry* reg, tvm_funct
 
 /*!
  * \brief A TVMFuncRegistry that supports adding and changing the functions.
+ *
+ * Functions are also indexed in an open addressing hash table of their names, so that lookup does
+ * not need to scan `names`.
  */
 typedef struct TVMMutableFuncRegistry {
   TVMFuncRegistry registry;
 
   /*! \brief maximum number of functions in this registry. */
   size_t max_functions;
+
+  /*! \brief Offset of the name of each function in `registry.names`. */
+  uint16_t* name_offsets;
+
+  /*! \brief Hash table of 1 + the function index, 0 marks an empty bucket. */
+  uint8_t* buckets;
+
+  /*! \brief Number of entries in `buckets`. */
+  size_t num_buckets;
 } TVMMutableFuncRegistry;
 
 // Defined to work around compiler limitations.
 #define TVM_AVERAGE_FUNCTION_NAME_STRLEN_BYTES 10
 
+/*! \brief Number of hash buckets per function in a TVMMutableFuncRegistry. */
+#define TVM_MUTABLE_FUNC_REGISTRY_BUCKETS_PER_FUNCTION 2
+
+/*! \brief Maximum number of functions in a TVMMutableFuncRegistry, byte 0 of names counts them. */
+#define TVM_MUTABLE_FUNC_REGISTRY_MAX_FUNCTIONS 255
+
 /*!
  * \brief Size of an average function name in a TVMMutableFuncRegistry, in bytes.
  *
@@ -99,10 +117,12 @@ static const size_t kTvmAverageFunctionNameStrlenBytes = TVM_AVERAGE_FUNCTION_NA
 /*!
  * \brief Size of an average entry in a TVMMutableFuncRegistry, in bytes.
  *
- * Assumes a constant average function name length.
+ * Assumes a constant average function name length. Besides the name and the function pointer,
+ * an entry holds the offset of the name and its hash buckets.
  */
-static const size_t kTvmAverageFuncEntrySizeBytes =
-    TVM_AVERAGE_FUNCTION_NAME_STRLEN_BYTES + 1 + sizeof(void*);
+static const size_t kTvmAverageFuncEntrySizeBytes = TVM_AVERAGE_FUNCTION_NAME_STRLEN_BYTES + 1 +
+                                                    sizeof(void*) + sizeof(uint16_t) +
+                                                    TVM_MUTABLE_FUNC_REGISTRY_BUCKETS_PER_FUNCTION;
 
 /*!
  * \brief Create a new mutable function registry from a block of memory.
@@ -130,6 +150,21 @@ tvm_crt_error_t TVMMutableFuncRegistry_Create(TVMMutableFuncRegistry* reg, uint8
 tvm_crt_error_t TVMMutableFuncRegistry_Set(TVMMutableFuncRegistry* reg, const char* name,
                                            TVMBackendPackedCFunc func, int override);
 
+/*!
+ * \brief Get packed function from a mutable registry by name, using its hash table.
+ *
+ * Equivalent to TVMFuncRegistry_Lookup on `reg->registry`, without scanning all the names.
+ *
+ * \param reg The mutable function registry that contains the function.
+ * \param name The function name
+ * \param function_index Pointer to receive the 0-based index of the function in the registry, if it
+ *     was found. Unmodified otherwise.
+ * \return kTvmErrorNoError when successful. kTvmErrorFunctionNameNotFound when no function matched
+ * `name`.
+ */
+tvm_crt_error_t TVMMutableFuncRegistry_Lookup(const TVMMutableFuncRegistry* reg, const char* name,
+                                              tvm_function_index_t* function_index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,8 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 extern int vleak_size;
@@ -55,6 +57,43 @@ void* vrealloc(void* ptr, size_t size);
  */
 void vfree(void* ptr);
 
+/*!
+ * \brief A statically planned region that serves the workspaces of the kernels.
+ *
+ * The kernels free their workspaces in reverse order of allocation, so the region is a stack.
+ */
+typedef struct TVMStaticWorkspace {
+  /*! \brief The memory of the region, aligned to alignment. */
+  uint8_t* data;
+  size_t size;
+  /*! \brief Alignment of each workspace. */
+  size_t alignment;
+  /*! \brief Number of bytes in use. */
+  size_t used;
+  /*! \brief Largest number of bytes in use so far. */
+  size_t peak;
+} TVMStaticWorkspace;
+
+/*!
+ * \brief Initialize a static workspace.
+ * \param workspace The workspace to initialize.
+ * \param data The memory of the region, it must be aligned to alignment.
+ * \param size Size of the region in bytes.
+ * \param alignment Alignment of each workspace, a power of two.
+ */
+void TVMStaticWorkspace_Init(TVMStaticWorkspace* workspace, uint8_t* data, size_t size,
+                             size_t alignment);
+
+/*!
+ * \brief Serve TVMBackendAllocWorkspace from a static workspace instead of the heap.
+ *
+ * While a static workspace is set, an allocation that does not fit in it fails.
+ *
+ * \param workspace The workspace, NULL to allocate from the heap again.
+ * \return The workspace that was set before.
+ */
+TVMStaticWorkspace* TVMSetStaticWorkspace(TVMStaticWorkspace* workspace);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -39,6 +39,24 @@ extern "C" {
  */
 void __attribute__((noreturn)) TVMPlatformAbort(tvm_crt_error_t code);
 
+/*! \brief Start a device timer.
+ *
+ * Only one timer runs at a time. The timer is used to time functions on the device, see
+ * tvm/runtime/crt/time_evaluator.h. The micro RPC server registers the time evaluator, so ports
+ * that use it should implement TVMPlatformTimerStart and TVMPlatformTimerStop. Without them, weak
+ * defaults that return an error are linked and timing calls fail.
+ *
+ * \return 0 on success, non-zero when the timer is already running.
+ */
+int TVMPlatformTimerStart(void);
+
+/*! \brief Stop the device timer started by TVMPlatformTimerStart.
+ *
+ * \param res_us Pointer that receives the time elapsed since the timer started, in microseconds.
+ * \return 0 on success, non-zero when the timer is not running.
+ */
+int TVMPlatformTimerStop(double* res_us);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -40,7 +40,7 @@ class WriteStream {
   virtual ssize_t Write(const uint8_t* data, size_t data_size_bytes) = 0;
   virtual void PacketDone(bool is_valid) = 0;
 
-  tvm_crt_error_t WriteAll(uint8_t* data, size_t data_size_bytes, size_t* bytes_consumed);
+  tvm_crt_error_t WriteAll(const uint8_t* data, size_t data_size_bytes, size_t* bytes_consumed);
 };
 
 }  // namespace micro_rpc
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/crt/time_evaluator.h
+ * \brief Time functions on the device with the platform timer.
+ *
+ * The calls are timed on the device, so when the device is driven over RPC neither the transport
+ * of the arguments nor the function lookup is measured. The platform provides
+ * TVMPlatformTimerStart and TVMPlatformTimerStop. Platforms that do not define them link
+ * against weak defaults that fail, so the timing functions return an error.
+ */
+
+#ifndef TVM_RUNTIME_CRT_TIME_EVALUATOR_H_
+#define TVM_RUNTIME_CRT_TIME_EVALUATOR_H_
+
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Time a function, like the time evaluator of the host runtime.
+ *
+ * Each repeat calls `f_preproc` once and then times `number` calls of `func`. While the calls
+ * of a repeat take less than `min_repeat_ms`, `number` grows and the repeat is timed again. It
+ * doubles while the timer reads 0, and the repeat fails after 20 rounds.
+ *
+ * \param func The function to time.
+ * \param args The arguments of the function, also passed to `f_preproc`.
+ * \param type_codes The type codes of the arguments.
+ * \param num_args The number of arguments.
+ * \param number The number of calls of the first repeat.
+ * \param repeat The number of repeats.
+ * \param min_repeat_ms The minimum duration of a repeat, in milliseconds.
+ * \param f_preproc Function called before each repeat, e.g. to flush the cache, or NULL.
+ * \param results Receives the mean time of one call of each repeat, in seconds. It holds
+ *     `repeat` entries.
+ * \return 0 on success, otherwise the error of the first call that failed.
+ */
+int TVMTimeEvaluator_Run(TVMFunctionHandle func, TVMValue* args, int* type_codes, int num_args,
+                         int number, int repeat, int min_repeat_ms, TVMFunctionHandle f_preproc,
+                         double* results);
+
+/*!
+ * \brief Register the timing functions in the global function registry.
+ *
+ * tvm.rpc.server.CallRepeated(mod, name, number, args...) calls a function `number` times and
+ * returns the mean time of one call in seconds.
+ *
+ * tvm.rpc.server.TimeEvaluate(mod, name, number, repeat, min_repeat_ms, f_preproc_name, args...)
+ * calls the function once, then times it with TVMTimeEvaluator_Run. It returns the mean times of
+ * the repeats as bytes of doubles, like the time evaluator of the host runtime. `f_preproc_name`
+ * names a global function, it is ignored when empty.
+ *
+ * In both, `mod` is a module handle, or null to look `name` up in the global functions.
+ *
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMTimeEvaluator_RegisterGlobals(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_TIME_EVALUATOR_H_
@@ -25,7 +25,10 @@
 
 #include <tvm/runtime/object.h>
 
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -45,9 +48,11 @@ inline ObjectPtr<T> make_object(Args&&... args);
 // The current design allows swapping the
 // allocator pattern when necessary.
 //
+// Every object records the deleter of the allocator that created it, so
+// objects created by different allocators can be mixed freely.
+//
 // Possible future allocator optimizations:
 // - Arena allocator that gives ownership of memory to arena (deleter_= nullptr)
-// - Thread-local object pools: one pool per size and alignment requirement.
 // - Can specialize by type of object to give the specific allocator to each object.
 
 /*!
@@ -191,15 +196,121 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
   };
 };
 
+/*!
+ * \brief Thread-local free lists of small memory blocks, one per size class.
+ *
+ *  Freed blocks are cached by the freeing thread and handed out again by its
+ *  next allocation of the same size class. Blocks are plain heap memory, so a
+ *  block allocated on one thread may be freed on another. Each list caches a
+ *  bounded number of bytes, larger blocks always go to the heap.
+ */
+class ObjectPool {
+ public:
+  /*! \brief The granularity of the size classes. */
+  static constexpr size_t kSizeClassUnit = 16;
+  /*! \brief Blocks larger than this are not cached. */
+  static constexpr size_t kMaxPooledSize = 512;
+  /*!
+   * \brief Allocate a block aligned to alignof(std::max_align_t).
+   * \param size The size of the block.
+   * \return The block.
+   */
+  TVM_DLL static void* Alloc(size_t size);
+  /*!
+   * \brief Free a block allocated by Alloc.
+   * \param ptr The block.
+   * \param size The size the block was allocated with.
+   */
+  TVM_DLL static void Free(void* ptr, size_t size);
+  /*! \brief Return the blocks cached by the calling thread to the heap. */
+  TVM_DLL static void Release();
+  /*! \return The number of allocations of the calling thread. */
+  TVM_DLL static uint64_t NumAllocs();
+  /*! \return The number of allocations of the calling thread served from a free list. */
+  TVM_DLL static uint64_t NumReused();
+};
+
+// Allocator that recycles the memory of small objects through ObjectPool.
+class PoolObjAllocator : public ObjAllocatorBase<PoolObjAllocator> {
+ public:
+  template <typename T>
+  class Handler {
+   public:
+    using StorageType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    static_assert(alignof(StorageType) <= alignof(std::max_align_t),
+                  "over-aligned objects are not supported by PoolObjAllocator");
+
+    template <typename... Args>
+    static T* New(PoolObjAllocator*, Args&&... args) {
+      void* data = ObjectPool::Alloc(sizeof(StorageType));
+      // Match the value initialization done by SimpleObjAllocator.
+      std::memset(data, 0, sizeof(StorageType));
+      new (data) T(std::forward<Args>(args)...);
+      return reinterpret_cast<T*>(data);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      T* tptr = static_cast<T*>(objptr);
+      tptr->T::~T();
+      ObjectPool::Free(tptr, sizeof(StorageType));
+    }
+  };
+
+  // The size of an array is only known at allocation time,
+  // so it is stored in a header in front of the array.
+  template <typename ArrayType, typename ElemType>
+  class ArrayHandler {
+   public:
+    static constexpr size_t kHeaderSize = alignof(std::max_align_t);
+    static_assert(alignof(ArrayType) <= alignof(std::max_align_t) &&
+                      alignof(ArrayType) % alignof(ElemType) == 0 &&
+                      sizeof(ArrayType) % alignof(ElemType) == 0,
+                  "element alignment constraint");
+
+    template <typename... Args>
+    static ArrayType* New(PoolObjAllocator*, size_t num_elems, Args&&... args) {
+      size_t size = kHeaderSize + sizeof(ArrayType) + num_elems * sizeof(ElemType);
+      char* block = static_cast<char*>(ObjectPool::Alloc(size));
+      *reinterpret_cast<size_t*>(block) = size;
+      void* data = block + kHeaderSize;
+      new (data) ArrayType(std::forward<Args>(args)...);
+      return reinterpret_cast<ArrayType*>(data);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      ArrayType* tptr = static_cast<ArrayType*>(objptr);
+      tptr->ArrayType::~ArrayType();
+      char* block = reinterpret_cast<char*>(tptr) - kHeaderSize;
+      ObjectPool::Free(block, *reinterpret_cast<size_t*>(block));
+    }
+  };
+};
+
+/*!
+ * \brief The allocator used by make_object.
+ *  Build with TVM_USE_OBJECT_POOL=1 to recycle objects through ObjectPool.
+ */
+#if defined(TVM_USE_OBJECT_POOL) && TVM_USE_OBJECT_POOL
+using DefaultObjAllocator = PoolObjAllocator;
+#else
+using DefaultObjAllocator = SimpleObjAllocator;
+#endif
+
 template <typename T, typename... Args>
 inline ObjectPtr<T> make_object(Args&&... args) {
-  return SimpleObjAllocator().make_object<T>(std::forward<Args>(args)...);
+  return DefaultObjAllocator().make_object<T>(std::forward<Args>(args)...);
 }
 
 template <typename ArrayType, typename ElemType, typename... Args>
 inline ObjectPtr<ArrayType> make_inplace_array_object(size_t num_elems, Args&&... args) {
-  return SimpleObjAllocator().make_inplace_array<ArrayType, ElemType>(num_elems,
-                                                                      std::forward<Args>(args)...);
+  return DefaultObjAllocator().make_inplace_array<ArrayType, ElemType>(
+      num_elems, std::forward<Args>(args)...);
 }
 
 }  // namespace runtime
@@ -67,6 +67,21 @@ TVM_DLL std::vector<std::vector<int>> rr_partitioner(int begin, int end, int ste
 TVM_DLL void parallel_for(int begin, int end, const std::function<void(int)>& f, int step = 1,
                           const PartitionerFuncType partitioner = rr_partitioner);
 
+/*!
+ * \brief Run a task function on a shared pool of worker threads, handing out the indexes
+ * one at a time.
+ * \param begin The start index of this parallel loop(inclusive).
+ * \param end The end index of this parallel loop(exclusive).
+ * \param num_threads The number of threads, including the calling thread, to run the loop with.
+ * \param f The task function, called with the id of the thread in [0, num_threads) and the index.
+ * \note Unlike parallel_for, this can be nested and called from several threads at once. The
+ * worker threads are created once and reused. The calling thread runs tasks too, so the loop
+ * finishes even if all workers are busy. If f throws, the remaining indexes are skipped and the
+ * first exception is rethrown in the calling thread once the running tasks finish.
+ */
+TVM_DLL void parallel_for_dynamic(int begin, int end, int num_threads,
+                                  const std::function<void(int thread_id, int index)>& f);
+
 }  // namespace support
 }  // namespace tvm
 
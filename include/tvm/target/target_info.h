@@ -72,5 +72,38 @@ class MemoryInfo : public ObjectRef {
  */
 TVM_DLL MemoryInfo GetMemoryInfo(const std::string& scope);
 
+/*!
+ * \brief Resolve the memory info of every scope that has a registered
+ *  "tvm.info.mem" function, by calling the functions on the current thread.
+ * \return The map from scope name to memory info.
+ */
+TVM_DLL Map<String, MemoryInfo> ResolveMemoryInfo();
+
+/*!
+ * \brief RAII scope in which GetMemoryInfo on the current thread looks up a
+ *  resolved map instead of calling the registered functions.
+ *
+ *  The functions can be registered from python. Resolve them on the thread
+ *  that holds the interpreter lock and enter this scope on worker threads.
+ */
+class MemoryInfoScope {
+ public:
+  /*!
+   * \brief Enter the scope.
+   * \param infos The memory info resolved by ResolveMemoryInfo.
+   */
+  TVM_DLL explicit MemoryInfoScope(Map<String, MemoryInfo> infos);
+  /*! \brief Restore the previous scope of the thread. */
+  TVM_DLL ~MemoryInfoScope();
+
+ private:
+  /*! \brief The resolved memory info. */
+  Map<String, MemoryInfo> infos_;
+  /*! \brief The scope that was active when entering. */
+  const MemoryInfoScope* prev_;
+
+  friend MemoryInfo GetMemoryInfo(const std::string& scope);
+};
+
 }  // namespace tvm
 #endif  // TVM_TARGET_TARGET_INFO_H_
@@ -120,6 +120,21 @@ TVM_DLL bool VerifySSA(const PrimFunc& func);
  */
 TVM_DLL bool VerifyMemory(const PrimFunc& func);
 
+/*!
+ * \brief Calculate the peak number of bytes of the workspaces a function allocates.
+ *
+ *  The workspaces are the allocations that LowerTVMBuiltin turns into
+ *  TVMBackendAllocWorkspace calls. They are freed in reverse order of allocation,
+ *  so nested allocations add up and sequential ones reuse the same memory.
+ *  The function is assumed to run on the CPU, where small constant allocations
+ *  stay on the stack.
+ *
+ * \param func The function, after the lowering passes.
+ * \param alignment Each workspace is rounded up to a multiple of alignment.
+ * \return The peak number of bytes, or -1 if the size of a workspace is not a constant.
+ */
+TVM_DLL int64_t CalculateWorkspaceBytes(const PrimFunc& func, int64_t alignment);
+
 /*!
  * \brief Verify the correctness of a GPU code
  *        It will check the whether the amount of memory usage or the number of threads
@@ -49,12 +49,15 @@ using tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param thread_safe Whether pass_func can run on different functions at the same time.
+ *        Passes that call global functions which can be registered from python must
+ *        pass false, the threads cannot take the interpreter lock held by the caller.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe = true);
 
 /*!
  * \brief Inject prefetch instructions into stmt.
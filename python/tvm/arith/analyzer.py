@@ -90,6 +90,7 @@ class Analyzer:
         self._canonical_simplify = _mod("canonical_simplify")
         self._int_set = _mod("int_set")
         self._enter_constraint_context = _mod("enter_constraint_context")
+        self._simplify_cache_stats = _mod("simplify_cache_stats")
 
     def const_int_bound(self, expr):
         """Find constant integer bound for expr.
@@ -251,3 +252,15 @@ class Analyzer:
             self._const_int_bound_update(var, info, override)
         else:
             raise TypeError("Do not know how to handle type {}".format(type(info)))
+
+    @property
+    def simplify_cache_stats(self):
+        """The hits and misses of the memo of simplification results.
+
+        Returns
+        -------
+        stats : tuple of int
+            The number of hits and misses.
+        """
+        hits, misses = self._simplify_cache_stats()
+        return int(hits), int(misses)
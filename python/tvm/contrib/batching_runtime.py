@@ -0,0 +1,144 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Dynamic request batching on top of the graph runtime and the VM."""
+import tvm._ffi
+from tvm.runtime import ndarray
+
+
+def create_graph(buckets, max_batch_size=None, timeout_us=1000):
+    """Create a batching runtime over graph runtimes compiled per batch size.
+
+    Parameters
+    ----------
+    buckets : dict of int to GraphModule or tvm.runtime.Module
+        Graph runtime modules keyed by the batch size they were compiled for.
+        Requests are padded up to the smallest bucket that fits.
+
+    max_batch_size : int, optional
+        The maximum number of rows run at once. Defaults to the largest bucket,
+        and must not exceed it.
+
+    timeout_us : int
+        How long, in microseconds, the oldest pending request waits for others.
+
+    Returns
+    -------
+    module : BatchingModule
+        The batching runtime.
+    """
+    assert buckets, "At least one bucket is required"
+    if max_batch_size is None:
+        max_batch_size = max(buckets.keys())
+    args = []
+    for batch_size, mod in sorted(buckets.items()):
+        args.append(batch_size)
+        args.append(getattr(mod, "module", mod))
+    fcreate = tvm._ffi.get_global_func("tvm.batching_runtime.create_graph")
+    return BatchingModule(fcreate(max_batch_size, timeout_us, *args))
+
+
+def create_vm(vm, max_batch_size, timeout_us=1000, func_name="main"):
+    """Create a batching runtime over a VM function with an Any batch dimension.
+
+    Parameters
+    ----------
+    vm : tvm.runtime.vm.VirtualMachine
+        The initialized virtual machine.
+
+    max_batch_size : int
+        The maximum number of rows run at once.
+
+    timeout_us : int
+        How long, in microseconds, the oldest pending request waits for others.
+
+    func_name : str
+        The function to invoke.
+
+    Returns
+    -------
+    module : BatchingModule
+        The batching runtime.
+    """
+    fcreate = tvm._ffi.get_global_func("tvm.batching_runtime.create_vm")
+    return BatchingModule(fcreate(max_batch_size, timeout_us, vm.module, func_name))
+
+
+class BatchingModule(object):
+    """Wrapper of the batching runtime module.
+
+    :py:meth:`submit` may be called concurrently from many threads. Each call
+    blocks until the batch containing the request has been executed.
+
+    The Cython FFI does not release the GIL while :py:meth:`submit` blocks, so
+    concurrent Python threads are run one request at a time. Python callers use
+    :py:meth:`submit_many` to queue several requests together. Threads of a C++
+    host process are coalesced as expected.
+
+    Parameters
+    ----------
+    module : tvm.runtime.Module
+        The internal batching runtime module.
+    """
+
+    def __init__(self, module):
+        self.module = module
+        self._submit = module["submit"]
+        self._submit_many = module["submit_many"]
+        self._get_num_batches = module["get_num_batches"]
+
+    def submit(self, *inputs):
+        """Run one request.
+
+        Parameters
+        ----------
+        inputs : list of numpy.ndarray or tvm.nd.NDArray
+            The inputs of the request, all with the same extent on axis 0.
+
+        Returns
+        -------
+        outputs : list of tvm.nd.NDArray
+            The outputs of the request.
+        """
+        args = [x if isinstance(x, ndarray.NDArray) else ndarray.array(x) for x in inputs]
+        return list(self._submit(*args))
+
+    def submit_many(self, requests):
+        """Run several requests, queued together so that they are batched.
+
+        Parameters
+        ----------
+        requests : list of list of numpy.ndarray or tvm.nd.NDArray
+            The inputs of each request. All requests have the same number of inputs.
+
+        Returns
+        -------
+        outputs : list of list of tvm.nd.NDArray
+            The outputs of each request.
+        """
+        if not requests:
+            return []
+        num_inputs = len(requests[0])
+        args = []
+        for inputs in requests:
+            assert len(inputs) == num_inputs, "All requests must have the same number of inputs"
+            args.extend(x if isinstance(x, ndarray.NDArray) else ndarray.array(x) for x in inputs)
+        return [list(outputs) for outputs in self._submit_many(num_inputs, *args)]
+
+    @property
+    def num_batches(self):
+        """The number of batches executed so far."""
+        return self._get_num_batches()
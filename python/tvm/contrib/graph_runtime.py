@@ -295,6 +295,57 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def set_stream_schedule(self, enable=True):
+        """Enable or disable stream scheduled execution.
+
+        When enabled, kernels of each non-CPU device run on a compute stream and
+        cross device copies on a separate copy stream, so that transfers overlap
+        with computation. Dependencies between the streams are derived from the graph.
+
+        Parameters
+        ----------
+        enable : bool
+            Whether to use stream scheduled execution.
+        """
+        self.module["set_stream_schedule"](enable)
+
+    def set_storage_arena(self, arena=None, use_huge_pages=False):
+        """Place the intermediate storage in one contiguous arena per device.
+
+        The storage pool entries are laid out at aligned offsets in the arena
+        instead of being allocated separately. Entries whose lifetimes in the
+        execution order do not overlap share bytes, so intermediate results
+        other than the outputs are not kept after a run. The current contents,
+        such as loaded parameters, are preserved.
+
+        Parameters
+        ----------
+        arena : tvm.nd.NDArray, optional
+            The arena used for the device it resides on. It must hold at least
+            :py:meth:`get_storage_arena_size` bytes. When not given, the runtime
+            allocates the arena.
+
+        use_huge_pages : bool
+            Whether to back the CPU arena allocated by the runtime with
+            transparent huge pages.
+        """
+        self.module["set_storage_arena"](use_huge_pages, arena)
+
+    def get_storage_arena_size(self, ctx):
+        """Get the number of bytes of the storage arena on a device.
+
+        Parameters
+        ----------
+        ctx : TVMContext
+            The device.
+
+        Returns
+        -------
+        size : int
+            The arena size in bytes.
+        """
+        return self.module["get_storage_arena_size"](ctx.device_type)
+
     def __getitem__(self, key):
         """Get internal module function
 
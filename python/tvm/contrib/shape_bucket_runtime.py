@@ -0,0 +1,204 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Cache of static-shape graph runtimes for a dynamic-shape model."""
+import time
+
+import tvm._ffi
+from tvm.runtime import ndarray
+
+
+def _encode_shapes(shapes):
+    key = []
+    for shape in shapes:
+        key.append(len(shape))
+        key.extend(int(x) for x in shape)
+    return key
+
+
+def _decode_shapes(key):
+    shapes = []
+    i = 0
+    while i < len(key):
+        ndim = key[i]
+        shapes.append(tuple(key[i + 1 : i + 1 + ndim]))
+        i += 1 + ndim
+    return shapes
+
+
+def specialize(mod, shapes, func_name="main"):
+    """Replace the input shapes of a Relay function with static shapes.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module, typically with Any dimensions in the inputs.
+
+    shapes : list of tuple of int
+        The static shape of each parameter of the function. Parameters that
+        should not be specialized, such as weights, must be bound beforehand.
+
+    func_name : str
+        The function to specialize.
+
+    Returns
+    -------
+    mod : tvm.IRModule
+        A new module whose function has static input shapes.
+    """
+    from tvm import relay  # pylint: disable=import-outside-toplevel
+
+    func = mod[func_name]
+    assert len(shapes) == len(func.params), "Expect one shape per function parameter"
+    binds = {}
+    params = []
+    for param, shape in zip(func.params, shapes):
+        new_param = relay.var(param.name_hint, shape=shape, dtype=param.type_annotation.dtype)
+        binds[param] = new_param
+        params.append(new_param)
+    new_func = relay.Function(params, relay.bind(func.body, binds), attrs=func.attrs)
+    new_mod = tvm.IRModule(mod.functions, mod.type_definitions)
+    new_mod[func_name] = new_func
+    return relay.transform.InferType()(new_mod)
+
+
+def create(mod, target, ctx, shapes=None, params=None, hot_threshold=0, func_name="main"):
+    """Create a shape bucketed runtime for a dynamic-shape Relay module.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module, with Any dimensions in the inputs.
+
+    target : str or tvm.target.Target
+        The compilation target.
+
+    ctx : TVMContext
+        The context to run on.
+
+    shapes : list of list of tuple of int, optional
+        The input shape signatures compiled ahead of time into graph runtimes.
+        Each signature has one shape per input that is not in `params`.
+
+    params : dict of str to NDArray, optional
+        The parameters bound into every compiled variant. They are not
+        inputs of the returned module.
+
+    hot_threshold : int
+        When positive, a shape signature run this many times on the VM
+        fallback is compiled in the background into a graph runtime.
+
+    func_name : str
+        The function to run.
+
+    Returns
+    -------
+    module : ShapeBucketModule
+        The shape bucketed runtime.
+    """
+    from tvm import relay  # pylint: disable=import-outside-toplevel
+
+    if params:
+        # Bind the parameters once, so that the VM and the specializations take
+        # the same free inputs and the shape signatures only cover those.
+        bound_func = relay.build_module.bind_params_by_name(mod[func_name], params)
+        mod = tvm.IRModule(mod.functions, mod.type_definitions)
+        mod[func_name] = bound_func
+
+    def build_graph(static_shapes):
+        with tvm.transform.PassContext(opt_level=3):
+            lib = relay.build(specialize(mod, static_shapes, func_name), target)
+        return lib["default"](ctx)
+
+    exe = relay.vm.compile(mod, target)
+    vm = tvm.runtime.vm.VirtualMachine(exe, ctx)
+
+    fcompile = None
+    if hot_threshold > 0:
+
+        def fcompile(*key):
+            return build_graph(_decode_shapes(key))
+
+    fcreate = tvm._ffi.get_global_func("tvm.shape_bucket_runtime.create")
+    ret = ShapeBucketModule(fcreate(vm.module, func_name, hot_threshold, fcompile))
+    for static_shapes in shapes or []:
+        ret.add_specialization(build_graph(static_shapes), static_shapes)
+    return ret
+
+
+class ShapeBucketModule(object):
+    """Wrapper of the shape bucketed runtime module.
+
+    Parameters
+    ----------
+    module : tvm.runtime.Module
+        The internal shape bucketed runtime module.
+    """
+
+    def __init__(self, module):
+        self.module = module
+        self._run = module["run"]
+        self._add_specialization = module["add_specialization"]
+        self._get_num_specializations = module["get_num_specializations"]
+        self._get_num_fallback_runs = module["get_num_fallback_runs"]
+        self._get_num_pending_compiles = module["get_num_pending_compiles"]
+
+    def add_specialization(self, graph_module, shapes):
+        """Register a graph runtime compiled for the given input shapes.
+
+        Parameters
+        ----------
+        graph_module : GraphModule or tvm.runtime.Module
+            The graph runtime.
+
+        shapes : list of tuple of int
+            The static shape of each input.
+        """
+        self._add_specialization(
+            getattr(graph_module, "module", graph_module), *_encode_shapes(shapes)
+        )
+
+    def run(self, *inputs):
+        """Run the model.
+
+        Parameters
+        ----------
+        inputs : list of numpy.ndarray or tvm.nd.NDArray
+            The inputs in the order of the function parameters.
+
+        Returns
+        -------
+        outputs : list of tvm.nd.NDArray
+            The outputs.
+        """
+        args = [x if isinstance(x, ndarray.NDArray) else ndarray.array(x) for x in inputs]
+        return list(self._run(*args))
+
+    def wait_for_compile(self):
+        """Block until all background compilations finished."""
+        # Poll instead of blocking in C++ so the compile callback can take the GIL.
+        while self._get_num_pending_compiles() > 0:
+            time.sleep(0.01)
+
+    @property
+    def num_specializations(self):
+        """The number of graph runtime specializations."""
+        return self._get_num_specializations()
+
+    @property
+    def num_fallback_runs(self):
+        """The number of runs that fell back to the VM."""
+        return self._get_num_fallback_runs()
@@ -89,11 +89,164 @@ class CSRNDArray(object):
         return full
 
 
-def array(source_array, ctx=None, shape=None, stype="csr"):
-    """Construct a sparse NDArray from numpy.ndarray"""
+class BSRNDArray(object):
+    """Sparse tensor object in BSR (block compressed sparse row) format."""
+
+    def __init__(self, arg1, ctx=None, shape=None, blocksize=(1, 1)):
+        """Construct a sparse matrix in BSR format. The nonzero blocks of row
+        block i are data[indptr[i]:indptr[i + 1]], at the column blocks
+        indices[indptr[i]:indptr[i + 1]].
+
+        Parameters
+        ----------
+        arg1 : numpy.ndarray or a tuple with (data, indices, indptr)
+            The corresponding a dense numpy array,
+            or a tuple for constructing a sparse matrix directly.
+
+        ctx: tvmContext
+            The corresponding context.
+
+        shape : tuple of int
+            The shape of the array
+
+        blocksize : tuple of int
+            The (rows, columns) of a block, they divide the shape.
+        """
+        if isinstance(arg1, tuple):
+            assert len(arg1) == 3
+            self.data, self.indices, self.indptr = arg1
+            self.shape = shape
+        elif isinstance(arg1, _np.ndarray):
+            source_array = arg1
+            self.shape = source_array.shape
+            rows, cols = self.shape
+            bs_r, bs_c = blocksize
+            assert rows % bs_r == 0 and cols % bs_c == 0, "blocksize must divide the shape"
+            blocks = source_array.reshape(rows // bs_r, bs_r, cols // bs_c, bs_c)
+            blocks = blocks.transpose(0, 2, 1, 3)
+            nonzero_blocks = _np.any(blocks != 0, axis=(2, 3))
+            block_rows, block_cols = _np.nonzero(nonzero_blocks)
+            self.data = _nd.array(_np.ascontiguousarray(blocks[block_rows, block_cols]), ctx)
+            self.indices = _nd.array(block_cols.astype(itype), ctx)
+            indptr = _np.cumsum([0] + nonzero_blocks.sum(axis=1).tolist())
+            self.indptr = _nd.array(indptr.astype(itype), ctx)
+        else:
+            raise RuntimeError(
+                "Construct BSRNDArray with either a tuple (data, indices, indptr) "
+                "or a numpy.array, can't handle type %s." % (type(arg1),)
+            )
+        self.stype = "bsr"
+        self.dtype = self.data.dtype
+        assert self.shape is not None
+        assert isinstance(self.data, _nd.NDArray) and len(self.data.shape) == 3
+        assert isinstance(self.indices, _nd.NDArray)
+        assert isinstance(self.indptr, _nd.NDArray)
+        self.blocksize = tuple(self.data.shape[1:])
+
+    def asnumpy(self):
+        """Construct a full matrix and convert it to numpy array."""
+        bs_r, bs_c = self.blocksize
+        full = _np.zeros(self.shape, self.dtype)
+        data = self.data.asnumpy()
+        indices = self.indices.asnumpy()
+        indptr = self.indptr.asnumpy()
+        for row in range(len(indptr) - 1):
+            for elem in range(indptr[row], indptr[row + 1]):
+                col = indices[elem]
+                full[row * bs_r : (row + 1) * bs_r, col * bs_c : (col + 1) * bs_c] = data[elem]
+        return full
+
+
+class ELLNDArray(object):
+    """Sparse tensor object in ELL (ELLPACK) format."""
+
+    def __init__(self, arg1, ctx=None, shape=None):
+        """Construct a sparse matrix in ELL format. Every row stores the same
+        number of elements, data[i, j] at column indices[i, j]. Rows with fewer
+        nonzeros are padded with zeros, so kernels loop over a fixed width.
+
+        Parameters
+        ----------
+        arg1 : numpy.ndarray or a tuple with (data, indices)
+            The corresponding a dense numpy array,
+            or a tuple for constructing a sparse matrix directly.
+
+        ctx: tvmContext
+            The corresponding context.
+
+        shape : tuple of int
+            The shape of the array
+        """
+        if isinstance(arg1, tuple):
+            assert len(arg1) == 2
+            self.data, self.indices = arg1
+            self.shape = shape
+        elif isinstance(arg1, _np.ndarray):
+            source_array = arg1
+            self.shape = source_array.shape
+            counts = _np.count_nonzero(source_array, axis=1)
+            width = max(int(counts.max()) if counts.size else 0, 1)
+            data = _np.zeros((self.shape[0], width), source_array.dtype)
+            indices = _np.zeros((self.shape[0], width), itype)
+            for row in range(self.shape[0]):
+                cols = _np.nonzero(source_array[row])[0]
+                data[row, : len(cols)] = source_array[row, cols]
+                indices[row, : len(cols)] = cols
+            self.data = _nd.array(data, ctx)
+            self.indices = _nd.array(indices, ctx)
+        else:
+            raise RuntimeError(
+                "Construct ELLNDArray with either a tuple (data, indices) "
+                "or a numpy.array, can't handle type %s." % (type(arg1),)
+            )
+        self.stype = "ell"
+        self.dtype = self.data.dtype
+        assert self.shape is not None
+        assert isinstance(self.data, _nd.NDArray) and len(self.data.shape) == 2
+        assert isinstance(self.indices, _nd.NDArray)
+        assert tuple(self.indices.shape) == tuple(self.data.shape)
+
+    def asnumpy(self):
+        """Construct a full matrix and convert it to numpy array."""
+        full = _np.zeros(self.shape, self.dtype)
+        data = self.data.asnumpy()
+        rows = _np.repeat(_np.arange(self.shape[0]), data.shape[1])
+        _np.add.at(full, (rows, self.indices.asnumpy().ravel()), data.ravel())
+        return full
+
+
+def array(source_array, ctx=None, shape=None, stype="csr", blocksize=(1, 1)):
+    """Construct a sparse NDArray from numpy.ndarray
+
+    Parameters
+    ----------
+    source_array : numpy.ndarray or tuple
+        The dense array, or the arrays of the format.
+
+    ctx : tvmContext
+        The context of the arrays.
+
+    shape : tuple of int
+        The shape of the array, needed when source_array is a tuple.
+
+    stype : str
+        The storage type, one of csr, bsr or ell.
+
+    blocksize : tuple of int
+        The block shape of bsr.
+
+    Returns
+    -------
+    ret : CSRNDArray, BSRNDArray or ELLNDArray
+        The sparse array.
+    """
     ret = None
     if stype == "csr":
         ret = CSRNDArray(source_array, shape=shape, ctx=ctx)
+    elif stype == "bsr":
+        ret = BSRNDArray(source_array, shape=shape, ctx=ctx, blocksize=blocksize)
+    elif stype == "ell":
+        ret = ELLNDArray(source_array, shape=shape, ctx=ctx)
     else:
         raise NotImplementedError("stype=%s is not supported yet." % (stype,))
     return ret
@@ -156,7 +309,71 @@ class CSRPlaceholderOp(SparsePlaceholderOp):
         assert isinstance(self.indptr, _tensor.Tensor)
 
 
-def placeholder(shape, nonzeros=None, dtype=None, name="placeholder", stype=None):
+class BSRPlaceholderOp(SparsePlaceholderOp):
+    """Placeholder class for BSR based sparse tensor representation."""
+
+    def __init__(self, shape, nonzeros, dtype, name, blocksize=(1, 1)):
+        """Contructing a bare bone structure for a bsr_matrix
+
+        Parameters
+        ----------
+        shape: Tuple of Expr
+            The shape of the tensor
+
+        nonzeros: int
+            The number of non-zero blocks
+
+        dtype: str, optional
+            The data type of the tensor
+
+        name: str, optional
+            The name hint of the tensor
+
+        blocksize: Tuple of int
+            The (rows, columns) of a block
+        """
+        SparsePlaceholderOp.__init__(self, shape, nonzeros, dtype, name)
+        self.stype = "bsr"
+        self.blocksize = tuple(blocksize)
+        bs_r, bs_c = self.blocksize
+        self.data = te.placeholder((nonzeros, bs_r, bs_c), dtype=dtype, name=self.name + "_data")
+        self.indices = te.placeholder((nonzeros,), dtype=itype, name=self.name + "_indices")
+        self.indptr = te.placeholder(
+            (self.shape[0] // bs_r + 1,), dtype=itype, name=self.name + "_indptr"
+        )
+
+
+class ELLPlaceholderOp(SparsePlaceholderOp):
+    """Placeholder class for ELL based sparse tensor representation."""
+
+    def __init__(self, shape, nonzeros, dtype, name):
+        """Contructing a bare bone structure for an ell_matrix
+
+        Parameters
+        ----------
+        shape: Tuple of Expr
+            The shape of the tensor
+
+        nonzeros: int
+            The number of elements stored per row
+
+        dtype: str, optional
+            The data type of the tensor
+
+        name: str, optional
+            The name hint of the tensor
+        """
+        SparsePlaceholderOp.__init__(self, shape, nonzeros, dtype, name)
+        self.stype = "ell"
+        self.data = te.placeholder((self.shape[0], nonzeros), dtype=dtype, name=self.name + "_data")
+        self.indices = te.placeholder(
+            (self.shape[0], nonzeros), dtype=itype, name=self.name + "_indices"
+        )
+
+
+def placeholder(
+    shape, nonzeros=None, dtype=None, name="placeholder", stype=None, blocksize=(1, 1)
+):
     """Construct an empty sparse tensor object.
 
     Parameters
@@ -165,7 +382,8 @@ def placeholder(shape, nonzeros=None, dtype=None, name="placeholder", stype=None
         The shape of the tensor
 
     nonzeros: int
-        The number of non-zero values
+        The number of non-zero values, the number of blocks for bsr and the
+        number of elements per row for ell
 
     dtype: str, optional
         The data type of the tensor
@@ -174,7 +392,10 @@ def placeholder(shape, nonzeros=None, dtype=None, name="placeholder", stype=None
         The name hint of the tensor
 
     stype: str, optional
-        The name storage type of the sparse tensor (e.g. csr, coo, ell)
+        The name storage type of the sparse tensor (e.g. csr, bsr, ell)
+
+    blocksize: Tuple of int, optional
+        The block shape of bsr
 
     Returns
     -------
@@ -188,6 +409,12 @@ def placeholder(shape, nonzeros=None, dtype=None, name="placeholder", stype=None
     ret = None
     if stype == "csr":
         ret = CSRPlaceholderOp(shape=shape, nonzeros=nonzeros, dtype=dtype, name=name)
+    elif stype == "bsr":
+        ret = BSRPlaceholderOp(
+            shape=shape, nonzeros=nonzeros, dtype=dtype, name=name, blocksize=blocksize
+        )
+    elif stype == "ell":
+        ret = ELLPlaceholderOp(shape=shape, nonzeros=nonzeros, dtype=dtype, name=name)
     else:
         raise NotImplementedError("stype=%s is not supported yet." % (stype,))
     return ret
@@ -157,6 +157,41 @@ def save_json(node):
     return tvm.runtime._ffi_node_api.SaveJSON(node)
 
 
+def load_binary(blob):
+    """Load tvm object from a blob created by save_binary.
+
+    Parameters
+    ----------
+    blob : bytes or bytearray
+        The binary blob.
+
+    Returns
+    -------
+    node : Object
+        The loaded tvm node.
+    """
+    return tvm.runtime._ffi_node_api.LoadBinary(bytearray(blob))
+
+
+def save_binary(node):
+    """Save tvm object in the compact binary format.
+
+    The format stores tensors as raw payloads and is much faster to save
+    and load than json, but it can only be loaded by the same version of TVM.
+
+    Parameters
+    ----------
+    node : Object
+        A TVM object to be saved.
+
+    Returns
+    -------
+    blob : bytearray
+        The binary blob.
+    """
+    return tvm.runtime._ffi_node_api.SaveBinary(node)
+
+
 def structural_equal(lhs, rhs, map_free_vars=False):
     """Check structural equality of lhs and rhs.
 
@@ -17,6 +17,7 @@
 """MicroTVM module for bare-metal backends"""
 
 from .artifact import Artifact
+from .binary_graph import kernel_workspace_size, memory_size, serialize_graph
 from .build import build_static_runtime, default_options, TVM_ROOT_DIR
 from .build import CRT_ROOT_DIR, Workspace
 from .compiler import Compiler, DefaultCompiler, Flasher
@@ -0,0 +1,354 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Serialize a graph into the binary graph format of the C runtime.
+
+The layout is described in include/tvm/runtime/crt/binary_graph_runtime.h.
+"""
+import ctypes
+import json
+import struct
+
+import numpy as np
+
+from tvm import tir
+from tvm._ffi.runtime_ctypes import TVMArray
+
+MAGIC = 0x42475654
+VERSION = 1
+PARAM_STORAGE = 0xFFFFFFFF
+
+_HEADER_FORMAT = "<22I"
+_DTYPE_CODES = {"int": 0, "uint": 1, "float": 2, "bfloat": 4}
+
+
+def _align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def _dltensor_size(pointer_size):
+    """Get sizeof(DLTensor) on a device with pointer_size byte pointers.
+
+    The layout follows the ctypes DLTensor of the runtime, with the pointers
+    resized. Other fields keep the size and alignment they have on the host.
+    """
+    offset = 0
+    struct_alignment = 1
+    for _, field_type in TVMArray._fields_:
+        if field_type is ctypes.c_void_p or issubclass(field_type, ctypes._Pointer):
+            size = alignment = pointer_size
+        else:
+            size = ctypes.sizeof(field_type)
+            alignment = ctypes.alignment(field_type)
+        offset = _align(offset, alignment) + size
+        struct_alignment = max(struct_alignment, alignment)
+    return _align(offset, struct_alignment)
+
+
+def _parse_dtype(dtype):
+    """Return (code, bits, lanes) of a dtype string."""
+    if dtype == "bool":
+        return 1, 1, 1
+    lanes = 1
+    if "x" in dtype:
+        dtype, lanes = dtype.split("x")
+        lanes = int(lanes)
+    for prefix in sorted(_DTYPE_CODES, key=len, reverse=True):
+        if dtype.startswith(prefix) and dtype[len(prefix) :].isdigit():
+            return _DTYPE_CODES[prefix], int(dtype[len(prefix) :]), lanes
+    raise ValueError("Unsupported dtype %s in binary graph" % dtype)
+
+
+class _StringTable(object):
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, name):
+        if name not in self.offsets:
+            self.offsets[name] = len(self.data)
+            self.data += name.encode("utf-8") + b"\0"
+        return self.offsets[name]
+
+
+def kernel_workspace_size(lowered_funcs, alignment=64):
+    """Calculate the size of the region that holds the workspaces of the kernels.
+
+    The ops run one after the other and each frees its workspaces before it
+    returns, so the region is as large as the largest need of a single kernel.
+
+    Parameters
+    ----------
+    lowered_funcs : IRModule or dict of str to IRModule
+        The lowered functions, as returned by relay.build_module.BuildModule.get_irmodule.
+
+    alignment : int
+        The alignment of the binary graph.
+
+    Returns
+    -------
+    size : int
+        The size of the region in bytes.
+
+    Raises
+    ------
+    ValueError
+        If a kernel allocates a workspace whose size is not a constant.
+    """
+    mods = lowered_funcs.values() if hasattr(lowered_funcs, "values") else [lowered_funcs]
+    size = 0
+    for mod in mods:
+        for gvar, func in mod.functions.items():
+            if isinstance(func, tir.PrimFunc):
+                func_size = tir.analysis.calculate_workspace_bytes(func, alignment)
+                if func_size < 0:
+                    raise ValueError(
+                        "Cannot plan the workspaces of %s statically, "
+                        "the size of a workspace is not a constant" % gvar.name_hint
+                    )
+                size = max(size, func_size)
+    return size
+
+
+def memory_size(blob, pointer_size=4):
+    """Get the RAM needed to run a binary graph on the device.
+
+    This is the size TVMBinaryGraphRuntime_MemorySize returns on the device,
+    the graph itself can stay in flash.
+
+    Parameters
+    ----------
+    blob : bytes or bytearray
+        The binary graph.
+
+    pointer_size : int
+        The size of a pointer on the device, 4 or 8.
+
+    Returns
+    -------
+    size : int
+        The number of bytes.
+    """
+    header = parse_header(blob)
+    dltensor_size = _dltensor_size(pointer_size)
+    return (
+        header["alignment"]
+        - 1
+        + _align(header["workspace_size"], header["alignment"])
+        + _align(header["kernel_workspace_size"], 8)
+        + _align(dltensor_size * header["num_tensors"], 8)
+        + _align(pointer_size * header["num_ops"], 8)
+        + _align(8 * header["num_op_args"], 8)
+        + _align(4 * header["num_op_args"], 8)
+    )
+
+
+def serialize_graph(graph_json, params=None, alignment=64, kernel_workspace_size=0):  # pylint: disable=redefined-outer-name
+    """Convert a graph into the binary graph run in place by the C runtime.
+
+    Parameters
+    ----------
+    graph_json : str
+        The graph JSON produced by relay.build.
+
+    params : dict of str to NDArray or numpy.ndarray, optional
+        The params stored in the graph. They are used in place by the
+        runtime and are not inputs of the binary graph.
+
+    alignment : int
+        The alignment of the params and of the storages in the workspace.
+        The graph must be placed at an address aligned to it.
+
+    kernel_workspace_size : int
+        The size of the region that holds the workspaces of the kernels, see
+        kernel_workspace_size. With 0 the kernels allocate their workspaces
+        from the heap.
+
+    Returns
+    -------
+    graph : bytearray
+        The binary graph.
+    """
+    graph = json.loads(graph_json)
+    params = params or {}
+    nodes = graph["nodes"]
+    node_row_ptr = graph["node_row_ptr"]
+    attrs = graph["attrs"]
+    storage_ids = attrs["storage_id"][1]
+    shapes = attrs["shape"][1]
+    dtypes = attrs["dltype"][1]
+    if "device_index" in attrs and len(set(attrs["device_index"][1])) > 1:
+        raise ValueError("The binary graph does not support heterogeneous execution")
+    num_tensors = node_row_ptr[-1]
+    strings = _StringTable()
+
+    # Inputs and params.
+    inputs = []
+    param_entries = {}
+    for nid in graph["arg_nodes"]:
+        name = nodes[nid]["name"]
+        eid = node_row_ptr[nid]
+        if name in params:
+            data = params[name]
+            data = data.asnumpy() if hasattr(data, "asnumpy") else np.asarray(data)
+            param_entries[eid] = np.ascontiguousarray(data)
+        else:
+            inputs.append((eid, strings.add(name)))
+
+    # Tensors and the storage plan, storages only used by params take no space.
+    num_storages = max(storage_ids) + 1 if storage_ids else 0
+    storage_sizes = [0] * num_storages
+    tensors = []
+    shape_table = []
+    for eid in range(num_tensors):
+        code, bits, lanes = _parse_dtype(dtypes[eid])
+        shape = shapes[eid]
+        tensors.append(
+            (
+                PARAM_STORAGE if eid in param_entries else storage_ids[eid],
+                len(shape_table),
+                len(shape),
+                code,
+                bits,
+                lanes,
+            )
+        )
+        shape_table.extend(shape)
+        nbytes = int(np.prod(shape)) * ((bits * lanes + 7) // 8)
+        if eid not in param_entries:
+            storage_sizes[storage_ids[eid]] = max(storage_sizes[storage_ids[eid]], nbytes)
+        elif param_entries[eid].nbytes != nbytes:
+            raise ValueError("The param of tensor %d does not match its shape" % eid)
+    storages = []
+    workspace_size = 0
+    for size in storage_sizes:
+        storages.append((workspace_size, size))
+        workspace_size += _align(size, alignment)
+
+    # Ops.
+    ops = []
+    op_args = []
+    for nid, node in enumerate(nodes):
+        if node["op"] == "null":
+            continue
+        if node["op"] != "tvm_op":
+            raise ValueError("Can only take tvm_op as op, but %s is found" % node["op"])
+        node_attrs = node["attrs"]
+        func_name = node_attrs["func_name"]
+        if func_name == "__nop":
+            continue
+        if func_name == "__copy":
+            raise ValueError("__copy is not supported by the binary graph")
+        if int(node_attrs.get("flatten_data", 0)):
+            raise ValueError("flatten_data is not supported by the binary graph")
+        args = [node_row_ptr[e[0]] + e[1] for e in node["inputs"]]
+        args += [node_row_ptr[nid] + i for i in range(int(node_attrs["num_outputs"]))]
+        ops.append((strings.add(func_name), len(op_args), len(args), 0))
+        op_args.extend(args)
+    outputs = [node_row_ptr[e[0]] + e[1] for e in graph["heads"]]
+
+    # Layout.
+    body = bytearray()
+    header_size = struct.calcsize(_HEADER_FORMAT)
+
+    def section(data, align=8):
+        offset = _align(header_size + len(body), align)
+        body.extend(b"\0" * (offset - header_size - len(body)))
+        body.extend(data)
+        return offset
+
+    tensors_offset = section(b"".join(struct.pack("<3I2BH", *t) for t in tensors))
+    shapes_offset = section(struct.pack("<%dq" % len(shape_table), *shape_table))
+    storages_offset = section(b"".join(struct.pack("<2I", *s) for s in storages))
+    inputs_offset = section(b"".join(struct.pack("<2I", *i) for i in inputs))
+    outputs_offset = section(struct.pack("<%dI" % len(outputs), *outputs))
+    ops_offset = section(b"".join(struct.pack("<4I", *op) for op in ops))
+    op_args_offset = section(struct.pack("<%dI" % len(op_args), *op_args))
+    param_table = []
+    params_offset = section(b"\0" * (16 * len(param_entries)))
+    for eid, data in sorted(param_entries.items()):
+        param_table.append((eid, section(data.tobytes(), alignment), data.nbytes, 0))
+    table = b"".join(struct.pack("<4I", *p) for p in param_table)
+    start = params_offset - header_size
+    body[start : start + len(table)] = table
+    strings_offset = section(bytes(strings.data), 1)
+
+    header = struct.pack(
+        _HEADER_FORMAT,
+        MAGIC,
+        VERSION,
+        header_size + len(body),
+        alignment,
+        workspace_size,
+        len(tensors),
+        tensors_offset,
+        shapes_offset,
+        len(storages),
+        storages_offset,
+        len(inputs),
+        inputs_offset,
+        len(outputs),
+        outputs_offset,
+        len(ops),
+        ops_offset,
+        len(op_args),
+        op_args_offset,
+        len(param_table),
+        params_offset,
+        strings_offset,
+        kernel_workspace_size,
+    )
+    return bytearray(header) + body
+
+
+def parse_header(blob):
+    """Parse the header of a binary graph.
+
+    Parameters
+    ----------
+    blob : bytes or bytearray
+        The binary graph.
+
+    Returns
+    -------
+    header : dict of str to int
+        The fields of the header.
+    """
+    fields = [
+        "magic",
+        "version",
+        "total_size",
+        "alignment",
+        "workspace_size",
+        "num_tensors",
+        "tensors_offset",
+        "shapes_offset",
+        "num_storages",
+        "storages_offset",
+        "num_inputs",
+        "inputs_offset",
+        "num_outputs",
+        "outputs_offset",
+        "num_ops",
+        "ops_offset",
+        "num_op_args",
+        "op_args_offset",
+        "num_params",
+        "params_offset",
+        "strings_offset",
+        "kernel_workspace_size",
+    ]
+    return dict(zip(fields, struct.unpack_from(_HEADER_FORMAT, blob)))
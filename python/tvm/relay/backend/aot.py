@@ -0,0 +1,91 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Ahead of time executor.
+
+The graph runtime interprets the graph: it looks up each kernel by name and
+calls it through a PackedFunc. The AOT executor instead generates a C function
+
+.. code-block:: c
+
+    int32_t <mod_name>_run_model(void* const* inputs, void* const* outputs);
+
+that calls each kernel directly, with static tensors and arguments and one
+static buffer for the activations. The generated source is compiled together
+with the kernels, which may be generated by the c or the llvm target.
+"""
+from tvm import nd
+from tvm.relay import build_module
+from . import _backend
+
+
+def generate_c(graph_json, params=None, mod_name="default", alignment=64):
+    """Generate the C source of the AOT executor of a graph.
+
+    Parameters
+    ----------
+    graph_json : str
+        The graph JSON produced by relay.build.
+
+    params : dict of str to NDArray or numpy.ndarray, optional
+        The params, they are embedded as constants in the source.
+
+    mod_name : str
+        The prefix of the generated symbols.
+
+    alignment : int
+        The alignment of the params and of the storages of the activations.
+
+    Returns
+    -------
+    module : tvm.runtime.Module
+        A C source module to import into the module of the kernels.
+    """
+    params = params or {}
+    params = {k: v if isinstance(v, nd.NDArray) else nd.array(v) for k, v in params.items()}
+    return _backend._AotCodegen(graph_json, params, mod_name, alignment)
+
+
+def build(mod, target="c", target_host=None, params=None, mod_name="default"):
+    """Build a Relay module into kernels and the AOT executor that runs them.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module to build.
+
+    target : str or tvm.target.Target
+        The target of the kernels, it must run on the CPU.
+
+    target_host : str or tvm.target.Target, optional
+        The host target.
+
+    params : dict of str to NDArray or numpy.ndarray, optional
+        The params, they are embedded in the generated source.
+
+    mod_name : str
+        The prefix of the generated symbols.
+
+    Returns
+    -------
+    lib : tvm.runtime.Module
+        The module of the kernels, with the AOT executor imported. Use
+        export_library to compile them into one library.
+    """
+    factory = build_module.build(mod, target=target, target_host=target_host, params=params)
+    lib = factory.get_lib()
+    lib.import_module(generate_c(factory.get_json(), factory.get_params(), mod_name))
+    return lib
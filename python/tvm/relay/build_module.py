@@ -80,6 +80,7 @@ class BuildModule(object):
         self._optimize = self.mod["optimize"]
         self._set_params_func = self.mod["set_params"]
         self._get_params_func = self.mod["get_params"]
+        self._get_irmodule = self.mod["get_irmodule"]
 
     def build(self, mod, target=None, target_host=None, params=None):
         """
@@ -177,6 +178,10 @@ class BuildModule(object):
         """Return the built module."""
         return self._get_module()
 
+    def get_irmodule(self):
+        """Return the lowered functions of the built program, by target."""
+        return self._get_irmodule()
+
     def get_params(self):
         """Return the updated weights."""
         params = self._get_params_func()
@@ -17,13 +17,24 @@
 # pylint: disable=unused-argument, not-context-manager
 """Automatic convert model from dense to block sparse"""
 
-from tvm import relay
+from tvm import relay, topi
 from tvm.relay.analysis.sparse_dense import process_params
 
 from .utils import _run_opt_pass
 
 
-def convert(func, params, blocksize, sparsity_threshold):
+def get_default_blocksize():
+    """Get the BSR block size of the sparse kernels of the current target.
+
+    Returns
+    -------
+    blocksize : Tuple(int, int)
+        The block size, a vector of rows by one column on CPUs.
+    """
+    return topi.nn.sparse_default_block_size()
+
+
+def convert(func, params, blocksize=None, sparsity_threshold=0.9):
     """Convert a dense func and according parameters to block sparse
 
     Parameters
@@ -32,8 +43,9 @@ def convert(func, params, blocksize, sparsity_threshold):
         Expr will be optimized to sparse operation
     params : Dict[Srting, tvm.nd.array]
         Parameters of the Expr
-    blocksize : Tuple(int, int)
-        Blocksize for BSR matrix
+    blocksize : Tuple(int, int), optional
+        Blocksize for BSR matrix. Defaults to the block size of the sparse
+        kernels of the current target, see get_default_blocksize.
     sparsity_threshold : float
         Minimal sparsity requirement for converting.
         If weight sparsity is lower than this threshold,
@@ -47,6 +59,7 @@ def convert(func, params, blocksize, sparsity_threshold):
     params: Dict[Srting, tvm.nd.array]
         New params with BSR matrix for mutated Expr
     """
+    blocksize = blocksize or get_default_blocksize()
     weight_info = process_params(func, params, blocksize, sparsity_threshold)
     new_func = _run_opt_pass(
         func, relay.transform.DenseToSparse(weight_info.weight_name, weight_info.weight_shape)
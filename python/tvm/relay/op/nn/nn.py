@@ -1409,6 +1409,39 @@ def dense(data, weight, units=None, out_dtype=""):
     return _make.dense(data, weight, units, out_dtype)
 
 
+def contrib_dense_pack(data, weight, weight_layout="NC16n4c", out_dtype=""):
+    """Dense operator with a pre-packed weight.
+    Applies a linear transformation
+
+    .. math::
+
+    `Y = X * W`
+
+    This operator is produced by the alter op layout of dense, which packs
+    the weight once in the graph.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data to the operator, of shape `(batch, input_dim)`.
+
+    weight : tvm.relay.Expr
+        The packed weight, of shape `(units // lanes, input_dim // 4, lanes, 4)`.
+
+    weight_layout : str, optional
+        The layout of the packed weight, NC{lanes}n4c.
+
+    out_dtype : str, optional
+        Specifies the output data type for mixed precision dense.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The computed result.
+    """
+    return _make.contrib_dense_pack(data, weight, weight_layout, out_dtype)
+
+
 def fifo_buffer(data, buffer, axis):
     """FIFO buffer to enable computation reuse in CNNs with sliding indow input
 
@@ -2021,6 +2054,53 @@ def sparse_dense(data, weight):
     return _make.sparse_dense(data, weight.data, weight.indices, weight.indptr)
 
 
+def sparse_conv2d(
+    data, weight, kernel_size=(1, 1), strides=(1, 1), padding=(0, 0), layout="NHWC"
+):
+    r"""
+    Computes a 2-D convolution of `data` with a sparse (either BSR or CSR)
+    weight, a namedtuple with fields `data`, `indices`, and `indptr`.
+
+    The sparse weight is the matrix of the HWIO kernel reshaped to
+    (kernel_h * kernel_w * in_channel, out_channel) and transposed, so its row
+    oc holds the kernel of output channel oc in (kh, kw, ic) order. A 1x1
+    kernel multiplies every pixel with the weight like sparse_dense.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data, 4-D in NHWC layout.
+
+    weight : namedtuple.
+        The sparse weight matrix.
+
+    kernel_size : tuple of int, optional
+        The (kernel_h, kernel_w) of the kernel.
+
+    strides : tuple of int, optional
+        The strides of the convolution.
+
+    padding : tuple of int, optional
+        The padding of the convolution on both sides of the inputs.
+
+    layout : str, optional
+        The layout of data and output, only NHWC is supported.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result.
+    """
+    if isinstance(kernel_size, int):
+        kernel_size = (kernel_size, kernel_size)
+    if isinstance(strides, int):
+        strides = (strides, strides)
+    padding = get_pad_tuple2d(padding)
+    return _make.sparse_conv2d(
+        data, weight.data, weight.indices, weight.indptr, kernel_size, strides, padding, layout
+    )
+
+
 def sparse_transpose(x):
     r"""
     Computes the fast matrix transpose of x,
@@ -332,6 +332,15 @@ def dense_strategy_cpu(attrs, inputs, out_type, target):
                 name="dense_mkldnn.x86",
                 plevel=15,
             )
+    if u8s8s32 and topi.x86.is_int8_hw_support(dtype, inputs[1].dtype):
+        n, k = get_const_tuple(inputs[1].shape)
+        if n % topi.x86.util.get_int32_lanes() == 0 and k % 4 == 0:
+            strategy.add_implementation(
+                wrap_compute_dense(topi.x86.dense_int8),
+                wrap_topi_schedule(topi.x86.schedule_dense_int8),
+                name="dense_int8.x86",
+                plevel=12,
+            )
     with SpecializedCondition(m >= 16):
         # this implementation may not be well-optimized, so use plevel=8 for now.
         strategy.add_implementation(
@@ -343,6 +352,33 @@ def dense_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@dense_pack_strategy.register("cpu")
+def dense_pack_strategy_cpu(attrs, inputs, out_type, target):
+    """dense_pack x86 strategy"""
+    strategy = _op.OpStrategy()
+    u8s8s32 = (
+        inputs[0].dtype == "uint8" and inputs[1].dtype == "int8" and out_type.dtype == "int32"
+    )
+    _, _, lanes, _ = get_const_tuple(inputs[1].shape)
+    if (
+        u8s8s32
+        and topi.x86.is_int8_hw_support(inputs[0].dtype, inputs[1].dtype)
+        and lanes == topi.x86.util.get_int32_lanes()
+    ):
+        strategy.add_implementation(
+            wrap_compute_dense(topi.x86.dense_int8),
+            wrap_topi_schedule(topi.x86.schedule_dense_int8),
+            name="dense_int8.x86",
+        )
+    else:
+        strategy.add_implementation(
+            wrap_compute_dense(topi.nn.dense_pack),
+            wrap_topi_schedule(topi.generic.schedule_dense),
+            name="dense_pack.generic",
+        )
+    return strategy
+
+
 @batch_matmul_strategy.register("cpu")
 def batch_matmul_strategy_cpu(attrs, inputs, out_type, target):
     """batch_matmul x86 strategy"""
@@ -376,6 +412,19 @@ def sparse_dense_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@sparse_conv2d_strategy.register("cpu")
+def sparse_conv2d_strategy_cpu(attrs, inputs, out_type, target):
+    """sparse conv2d x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_sparse_conv2d(topi.nn.sparse_conv2d),
+        wrap_topi_schedule(topi.x86.schedule_sparse_conv2d),
+        name="sparse_conv2d.x86",
+        plevel=10,
+    )
+    return strategy
+
+
 @roi_align_strategy.register("cpu")
 def roi_align_strategy_cpu(attrs, inputs, out_type, target):
     """roi_align x86 strategy"""
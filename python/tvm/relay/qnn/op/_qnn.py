@@ -0,0 +1,43 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, unused-argument
+"""Compute and schedules of the QNN ops that are not canonicalized."""
+from tvm import topi
+from tvm.relay.op import op as _reg
+
+
+@_reg.register_compute("qnn.fixed_point_requantize")
+def compute_fixed_point_requantize(attrs, inputs, output_type):
+    """Compute definition of qnn.fixed_point_requantize"""
+    return [
+        topi.nn.fixed_point_requantize(
+            inputs[0],
+            inputs[2],
+            inputs[3],
+            attrs.output_zero_point,
+            attrs.out_dtype,
+            attrs.axis,
+            bias=inputs[1],
+            out_min=attrs.out_min,
+            out_max=attrs.out_max,
+            fractional_bits=attrs.fractional_bits,
+            compute_dtype=str(attrs.compute_dtype),
+        )
+    ]
+
+
+_reg.register_broadcast_schedule("qnn.fixed_point_requantize")
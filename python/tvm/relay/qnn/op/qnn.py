@@ -86,6 +86,89 @@ def requantize(
     )
 
 
+def fixed_point_requantize(
+    data,
+    bias,
+    multiplier,
+    shift,
+    axis=-1,
+    fractional_bits=31,
+    output_zero_point=0,
+    out_min=None,
+    out_max=None,
+    compute_dtype="int64",
+    out_dtype="int8",
+):
+    r"""Fixed point requantize epilogue of a quantized conv2d or dense.
+
+    It is created by qnn.transform.FuseRequantize from a bias add, a requantize,
+    a clip and a cast, and is computed as a single elementwise stage
+
+    Q_output = clip(zp_output + round((data + bias) * multiplier * 2^(shift - fractional_bits)),
+                    out_min, out_max)
+
+    where the midpoints are rounded up.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The int32 accumulator.
+
+    bias : tvm.relay.Expr
+        The scalar or per channel int32 bias, with the input zero point folded in.
+
+    multiplier : tvm.relay.Expr
+        The scalar or per channel int32 fixed point multiplier.
+
+    shift : tvm.relay.Expr
+        The scalar or per channel int32 shift, positive to shift left.
+
+    axis : int
+        The channel axis of the per channel inputs.
+
+    fractional_bits : int
+        The number of fractional bits of the multipliers.
+
+    output_zero_point : int
+        The zero point of the output.
+
+    out_min : int, optional
+        The lower bound of the output, defaults to the minimum of out_dtype.
+
+    out_max : int, optional
+        The upper bound of the output, defaults to the maximum of out_dtype.
+
+    compute_dtype : str, optional
+        int64, or int32 when the products are known to fit in int32.
+
+    out_dtype : str, optional
+        Specifies the output data type.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The computed result.
+    """
+    bits = int(out_dtype[out_dtype.index("int") + 3 :])
+    if out_min is None:
+        out_min = 0 if out_dtype.startswith("uint") else -(1 << (bits - 1))
+    if out_max is None:
+        out_max = (1 << bits) - 1 if out_dtype.startswith("uint") else (1 << (bits - 1)) - 1
+    return _make.fixed_point_requantize(
+        data,
+        bias,
+        multiplier,
+        shift,
+        axis,
+        fractional_bits,
+        output_zero_point,
+        out_min,
+        out_max,
+        compute_dtype,
+        out_dtype,
+    )
+
+
 def quantize(data, output_scale, output_zero_point, axis=-1, out_dtype="int8"):
     r"""Quantize op
     This operator takes float32 as input and produces quantized int8 or unit8 as output.
@@ -18,8 +18,11 @@
 """
 QNN pass transformation infrastructure.
 """
+import tvm
 from tvm import relay
 
+from . import _transform
+
 
 def CanonicalizeOps():
     """Converts/Lowers an expression containing QNN ops to an expression containing only core
@@ -65,7 +68,12 @@ def CanonicalizeOps():
         The registered pass that canonicalizes QNN ops to Relay ops.
     """
 
-    return relay.transform.Legalize("FTVMQnnCanonicalize")
+    return tvm.transform.Sequential(
+        [
+            relay.transform.Legalize("FTVMQnnCanonicalize"),
+            relay.transform.Legalize("FTVMQnnCanonicalizeFused"),
+        ]
+    )
 
 
 def Legalize():
@@ -107,6 +115,10 @@ def Legalize():
     transformation for qnn.conv2d (and not nn.relu). This pass can be followed by CanonicalizeOps to
     further lower the qnn.requantize and qnn.conv2d into an expr containing only Relay ops.
 
+    The fused ops created by FuseRequantize are kept by relay.build, which computes them
+    with their TOPI compute. This pass also lowers them to core Relay ops, for external
+    codegens that only take core ops.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -114,3 +126,42 @@ def Legalize():
     """
 
     return relay.transform.Legalize("FTVMQnnLegalize")
+
+
+def FuseRequantize():
+    """Fuses the bias add, requantize, clip and cast that follow a qnn.conv2d or
+    qnn.dense into a single qnn.fixed_point_requantize, computed in one elementwise
+    stage. The input zero point of the requantize is folded into the bias, and the
+    multiplication is done in int32 when the ranges of the inputs, the zero points
+    and the reduction size of the producer prove that no product overflows. The
+    result is bit exact with the canonicalized requantize, so only requantize with
+    UPWARD rounding and constant params is fused.
+
+    The pass is not run by relay.build, apply it to the module before building.
+    The build keeps the fused op, FuseOps puts it in the epilogue of the conv2d or
+    dense, and it is computed with topi.nn.fixed_point_requantize. CanonicalizeOps
+    lowers it to core Relay ops for external codegens.
+
+    Examples
+    ________
+
+    .. code-block:: python
+
+        # Original expression
+        %0 = qnn.conv2d(%data, %weight, ...) /* ty=Tensor[(1, 16, 8, 8), int32] */;
+        %1 = nn.bias_add(%0, %bias) /* ty=Tensor[(1, 16, 8, 8), int32] */;
+        %2 = qnn.requantize(%1, ..., axis=1, out_dtype="uint8");
+        clip(%2, a_min=3f, a_max=255f)
+
+        # After FuseRequantize
+        %0 = qnn.conv2d(%data, %weight, ...) /* ty=Tensor[(1, 16, 8, 8), int32] */;
+        qnn.fixed_point_requantize(%0, %bias', %multiplier, %shift, axis=1, out_min=3,
+                                   out_max=255, out_dtype="uint8")
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass that fuses requantize epilogues.
+    """
+
+    return _transform.FuseRequantize()
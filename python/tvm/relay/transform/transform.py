@@ -91,6 +91,12 @@ class FunctionPass(tvm.ir.transform.Pass):
 def InferType():
     """Infer the type of an expr.
 
+    When the ``relay.InferType.incremental`` option of the PassContext is set,
+    subexpressions that still carry a tensor or tuple checked type from a
+    previous inference keep it and are not visited again. Function passes
+    then also skip checking functions they return unchanged, unless they
+    call a function the pass changed.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -1003,6 +1009,28 @@ def DenseToSparse(weight_name, weight_shape):
     return _ffi_api.DenseToSparse(weight_name, weight_shape)
 
 
+def Conv2dToSparse(weight_name, weight_shape):
+    """
+    Rewrite qualified ```nn.conv2d operation``` to ```nn.sparse_conv2d```
+    This pass is used in ```data_dep_optimization.bsr_conv2d```
+    Parameters of this pass is generated by ```analysis.sparse_conv2d.process_params```
+
+    Parameters
+    ----------
+    weight_name: Array[String]
+      Names of weights which qualified sparse contrains
+
+    weight_shape: Array[Array[IntImm]]
+      Weights shape in BSR format.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered Conv2dToSparse pass.
+    """
+    return _ffi_api.Conv2dToSparse(weight_name, weight_shape)
+
+
 def SimplifyFCTranspose(target_weight_name):
     """
     Rewrite ```y = nn.dense(x, transpose(w, [1, 0]))``` to ```y = nn.dense(x, wt)```
@@ -0,0 +1,53 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Defines functions to analyze the instruction sets of x86 -mcpu values."""
+
+
+def target_has_avx2(mcpu):
+    """Whether the mcpu has the AVX2 instructions used by the int8 kernels"""
+    return target_has_avx512(mcpu) or mcpu in (
+        "haswell",
+        "broadwell",
+        "skylake",
+        "core-avx2",
+        "znver1",
+        "znver2",
+    )
+
+
+def target_has_avx512(mcpu):
+    """Whether the mcpu has the AVX512 BW instructions used by the int8 kernels"""
+    return mcpu in (
+        "skylake-avx512",
+        "skx",
+        "cascadelake",
+        "cooperlake",
+        "icelake-client",
+        "icelake-server",
+        "tigerlake",
+    )
+
+
+def target_has_vnni(mcpu):
+    """Whether the mcpu has the AVX512 VNNI instructions"""
+    return mcpu in (
+        "cascadelake",
+        "cooperlake",
+        "icelake-client",
+        "icelake-server",
+        "tigerlake",
+    )
@@ -89,6 +89,27 @@ def verify_memory(func):
     return _ffi_api.verify_memory(func)
 
 
+def calculate_workspace_bytes(func, alignment):
+    """Calculate the peak number of bytes of the workspaces func allocates
+    through TVMBackendAllocWorkspace when it runs on the CPU.
+
+    Parameters
+    ----------
+    func: tvm.tir.PrimFunc
+        The function, after the lowering passes.
+
+    alignment: int
+        Each workspace is rounded up to a multiple of alignment.
+
+    Returns
+    -------
+    result : int
+        The peak number of bytes, or -1 if the size of a workspace is not
+        a constant.
+    """
+    return _ffi_api.calculate_workspace_bytes(func, alignment)
+
+
 def verify_gpu_code(func, constraints):
     """Verify if module contains illegal host side direct memory access.
 
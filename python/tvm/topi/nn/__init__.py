@@ -46,3 +46,4 @@ from .pad import *
 from .fifo_buffer import *
 from .depth_to_space import *
 from .space_to_depth import *
+from .qnn import *
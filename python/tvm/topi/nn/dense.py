@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """TVM operator fully connected compute."""
+import tvm
 from tvm import te
 from .. import tag
 
@@ -62,3 +63,80 @@ def dense(data, weight, bias=None, out_dtype=None):
             tag=tag.BROADCAST,
         )
     return matmul
+
+
+def dense_pack(data, weight, bias=None, out_dtype=None):
+    """The default implementation of dense with a packed weight in topi.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        2-D with shape [batch, in_dim]
+
+    weight : tvm.te.Tensor
+        4-D with shape [out_dim // lanes, in_dim // 4, lanes, 4], the layout NC{lanes}n4c
+        produced by the alter op layout of dense
+
+    bias : tvm.te.Tensor, optional
+        1-D with shape [out_dim]
+
+    out_dtype : str
+        The output type. This is used for mixed precision.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D with shape [batch, out_dim]
+    """
+    assert len(data.shape) == 2 and len(weight.shape) == 4, "only support 2-dim dense"
+    if bias is not None:
+        assert len(bias.shape) == 1
+    if out_dtype is None:
+        out_dtype = data.dtype
+    batch, in_dim = data.shape
+    out_dim_outer, _, lanes, _ = weight.shape
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+    k = te.reduce_axis((0, in_dim), name="k")
+    matmul = te.compute(
+        (batch, out_dim_outer * lanes),
+        lambda i, j: te.sum(
+            data[i, k].astype(out_dtype)
+            * weight[idxdiv(j, lanes), idxdiv(k, 4), idxmod(j, lanes), idxmod(k, 4)].astype(
+                out_dtype
+            ),
+            axis=k,
+        ),
+        name="T_dense",
+        tag="dense",
+    )
+    if bias is not None:
+        matmul = te.compute(
+            (batch, out_dim_outer * lanes),
+            lambda i, j: matmul[i, j] + bias[j].astype(out_dtype),
+            tag=tag.BROADCAST,
+        )
+    return matmul
+
+
+@tvm.target.generic_func
+def dense_alter_layout(attrs, inputs, tinfos, out_type):
+    """Change dense layout.
+
+    Parameters
+    ----------
+    attrs : tvm.ir.Attrs
+        Attributes of current dense op
+    inputs : tvm.relay.Expr
+        Grouped input symbols
+    tinfos : list
+        Input shape and dtype
+    out_type: type
+        The output type
+
+    Note
+    ----
+    Unlike other TOPI functions, this function operates on both graph level and operator level.
+    """
+    # not to change by default
+    return None
@@ -0,0 +1,157 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Fixed point requantization epilogues of quantized operators"""
+import math
+
+import tvm
+from tvm import te
+from .. import tag
+
+
+def get_fixed_point_multiplier_shift(scale):
+    """Express a floating point scale as multiplier * 2^(shift - 31), where the
+    multiplier is an int32 Q-number with 31 fractional bits. This is the
+    decomposition the QNN canonicalization uses for requantize.
+
+    Parameters
+    ----------
+    scale : float
+        The scale, for requantize input_scale / output_scale.
+
+    Returns
+    -------
+    multiplier : int
+        The int32 multiplier.
+
+    shift : int
+        The shift, positive to shift left.
+    """
+    if scale == 0:
+        return 0, 0
+    significand, shift = math.frexp(scale)
+    multiplier = int(round(significand * (1 << 31)))
+    if multiplier == (1 << 31):
+        multiplier //= 2
+        shift += 1
+    return multiplier, shift
+
+
+@tvm.te.tag_scope(tag=tag.BROADCAST)
+def fixed_point_requantize(
+    data,
+    multiplier,
+    shift,
+    output_zero_point=0,
+    out_dtype="uint8",
+    axis=1,
+    bias=None,
+    out_min=None,
+    out_max=None,
+    fractional_bits=31,
+    compute_dtype="int64",
+):
+    """Requantize an int32 accumulator in a single elementwise stage:
+    add the bias, multiply by the fixed point scale, add the output zero
+    point, clip and cast. Schedules of the int8 operators compute it in
+    the tiles of the accumulator, so the int32 result is never stored.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        The int32 accumulator, with the zero point corrections of the inputs applied.
+
+    multiplier : int or tvm.te.Tensor
+        The fixed point multiplier, or an int32 tensor of per channel multipliers,
+        see get_fixed_point_multiplier_shift.
+
+    shift : int or tvm.te.Tensor
+        The shift, or an int32 tensor of per channel shifts.
+
+    output_zero_point : int
+        The zero point of the output.
+
+    out_dtype : str
+        The quantized output type.
+
+    axis : int
+        The channel axis of data, indexes the bias and the per channel scales.
+
+    bias : tvm.te.Tensor, optional
+        A scalar or 1-D int32 bias added before the multiplication.
+
+    out_min : int, optional
+        The lower bound of the output, for instance the zero point to fuse a relu.
+        Defaults to the minimum of out_dtype.
+
+    out_max : int, optional
+        The upper bound of the output. Defaults to the maximum of out_dtype.
+
+    fractional_bits : int
+        The number of fractional bits of the multiplier, 31 for the multipliers
+        of get_fixed_point_multiplier_shift.
+
+    compute_dtype : str
+        "int64" rounds with tir.q_multiply_shift. "int32" multiplies and shifts in
+        int32, which is exact only when the product and the rounding term of every
+        element fit in int32.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        The requantized tensor of type out_dtype.
+    """
+    assert data.dtype == "int32", "Can only requantize an int32 accumulator"
+    axis = axis % len(data.shape)
+    dtype = tvm.DataType(out_dtype)
+    if out_min is None:
+        out_min = -(1 << (dtype.bits - 1)) if dtype.type_code == tvm.DataTypeCode.INT else 0
+    if out_max is None:
+        out_max = (
+            (1 << (dtype.bits - 1)) - 1
+            if dtype.type_code == tvm.DataTypeCode.INT
+            else (1 << dtype.bits) - 1
+        )
+
+    def _channel_param(value, channel):
+        if isinstance(value, te.Tensor):
+            return value() if len(value.shape) == 0 else value[channel]
+        return tvm.tir.const(value, "int32")
+
+    def _compute(*indices):
+        value = data(*indices)
+        if bias is not None:
+            value = value + _channel_param(bias, indices[axis]).astype("int32")
+        channel_multiplier = _channel_param(multiplier, indices[axis])
+        channel_shift = _channel_param(shift, indices[axis])
+        if compute_dtype == "int32":
+            total_shift = tvm.tir.const(fractional_bits, "int32") - channel_shift
+            rounding = tvm.tir.const(1, "int32") << (total_shift - 1)
+            value = (value * channel_multiplier + rounding) >> total_shift
+        else:
+            assert compute_dtype == "int64", "Unsupported compute_dtype %s" % compute_dtype
+            value = tvm.tir.q_multiply_shift(
+                value,
+                channel_multiplier,
+                tvm.tir.const(fractional_bits, "int32"),
+                channel_shift,
+            )
+        value = value + tvm.tir.const(output_zero_point, "int32")
+        value = te.min(value, tvm.tir.const(out_max, "int32"))
+        value = te.max(value, tvm.tir.const(out_min, "int32"))
+        return value.astype(out_dtype)
+
+    return te.compute(data.shape, _compute, name="requantize")
@@ -21,6 +21,8 @@ import tvm
 from tvm import te
 
 from ..util import get_const_tuple
+from .pad import pad
+from .util import get_pad_tuple
 
 
 def sparse_dense(data, weight_data, weight_indices, weight_indptr):
@@ -103,6 +105,133 @@ def _sparse_dense_bsrmm(data, weight_data, weight_indices, weight_indptr):
     )
 
 
+def sparse_conv2d(
+    data,
+    weight_data,
+    weight_indices,
+    weight_indptr,
+    kernel_size=(1, 1),
+    strides=(1, 1),
+    padding=(0, 0),
+    layout="NHWC",
+):
+    """
+    Computes a 2-D convolution of NHWC `data` with a sparse weight.
+
+    The weight is the sparse matrix of the HWIO kernel reshaped to
+    [kernel_h * kernel_w * in_channel, out_channel] and transposed, so its
+    column kh * kernel_w * in_channel + kw * in_channel + ic holds kernel[kh, kw, ic].
+    A 1x1 kernel is a sparse dense of the pixels.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        4-D with shape [batch, in_height, in_width, in_channel]
+
+    weight_data : tvm.te.Tensor
+        1-D with shape [nnz] (CSR) or
+        3-D with shape [num_blocks, bs_r, bs_c] (BSR)
+
+    weight_indices : tvm.te.Tensor
+        1-D with shape [nnz] (CSR) or
+        1-D with shape [num_blocks] (BSR)
+
+    weight_indptr : tvm.te.Tensor
+        1-D with shape [out_channel + 1] (CSR) or
+        1-D with shape [out_channel // bs_r + 1] (BSR)
+
+    kernel_size : tuple of int
+        The (kernel_h, kernel_w) of the kernel.
+
+    strides : tuple of int
+        The strides of the convolution.
+
+    padding : int, tuple of int or str
+        The padding, see get_pad_tuple.
+
+    layout : str
+        The layout of data and output, only NHWC is supported.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, out_height, out_width, out_channel]
+    """
+    assert layout == "NHWC", "sparse_conv2d only supports NHWC, not %s" % layout
+    assert len(weight_data.shape) in (1, 3)
+    batch, in_height, in_width, in_channel = get_const_tuple(data.shape)
+    kernel_h, kernel_w = kernel_size
+    stride_h, stride_w = strides
+    pad_top, pad_left, pad_down, pad_right = get_pad_tuple(padding, (kernel_h, kernel_w))
+    out_height = (in_height + pad_top + pad_down - kernel_h) // stride_h + 1
+    out_width = (in_width + pad_left + pad_right - kernel_w) // stride_w + 1
+    if pad_top or pad_left or pad_down or pad_right:
+        data = pad(data, [0, pad_top, pad_left, 0], [0, pad_down, pad_right, 0], name="pad_temp")
+
+    idxd = tvm.tir.indexdiv
+    idxm = tvm.tir.indexmod
+
+    def _patch(n, h, w, col):
+        """The element of the im2col row of output pixel (h, w) at the weight column col."""
+        if kernel_h == 1 and kernel_w == 1:
+            return data[n, h * stride_h, w * stride_w, col]
+        kh = idxd(col, kernel_w * in_channel)
+        kw = idxm(idxd(col, in_channel), kernel_w)
+        return data[n, h * stride_h + kh, w * stride_w + kw, idxm(col, in_channel)]
+
+    if len(weight_data.shape) == 1:
+        out_channel = get_const_tuple(weight_indptr.shape)[0] - 1
+
+        def _compute_csr(n, h, w, oc):
+            row_start = weight_indptr[oc]
+            row_elems = weight_indptr[oc + 1] - row_start
+            elem_idx = te.reduce_axis((0, row_elems), name="elem_idx")
+            elem = row_start + elem_idx
+            return te.sum(
+                weight_data[elem] * _patch(n, h, w, weight_indices[elem]), axis=elem_idx
+            )
+
+        return te.compute(
+            (batch, out_height, out_width, out_channel), _compute_csr, tag="sparse_conv2d_csr"
+        )
+
+    (_, bs_r, bs_c) = get_const_tuple(weight_data.shape)
+    num_blocks = get_const_tuple(weight_indptr.shape)[0] - 1
+
+    def _compute_block(n, h, w, nb_j, j):
+        row_start = weight_indptr[nb_j]
+        row_elems = weight_indptr[nb_j + 1] - row_start
+        elem_idx = te.reduce_axis((0, row_elems), name="elem_idx")
+        block_offset = row_start + elem_idx
+        c = te.reduce_axis((0, bs_c), name="c")
+        block_j = weight_indices[block_offset]
+        block_ij_val = weight_data[block_offset][j][c]
+        return te.sum(block_ij_val * _patch(n, h, w, bs_c * block_j + c), axis=[elem_idx, c])
+
+    block = te.compute(
+        (batch, out_height, out_width, num_blocks, bs_r),
+        _compute_block,
+        tag="sparse_conv2d_bsr_block",
+    )
+    return te.compute(
+        (batch, out_height, out_width, num_blocks * bs_r),
+        lambda n, h, w, oc: block[n, h, w, idxd(oc, bs_r), idxm(oc, bs_r)],
+        tag="sparse_conv2d_bsr",
+    )
+
+
+@tvm.target.generic_func
+def sparse_default_block_size():
+    """The BSR block size of a weight that suits the sparse kernels of the current target.
+
+    Returns
+    -------
+    blocksize : tuple of int
+        The (rows, columns) of a block.
+    """
+    return (1, 1)
+
+
 def sparse_transpose(sparse_data, sparse_indices, sparse_indptr):
     """
     Transpose a square sparse matrix,
@@ -14,12 +14,13 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
-"""TVM operator compute Dense in CSR format."""
+"""TVM operator compute Dense in CSR, BSR and ELL formats."""
 from __future__ import absolute_import
 import tvm
 from tvm import te
 from .. import tag
 from ..util import simplify
+from ..nn.sparse import sparse_dense
 
 
 def dense_si(data, indices, indptr, weight, bias=None):
@@ -180,16 +181,62 @@ def dense_sw(data, w_data, w_indices, w_indptr, bias=None):
     return matmul
 
 
+def dense_sw_ell(data, w_data, w_indices, bias=None):
+    # pylint: disable=invalid-name
+    """The implementation of dense in topi, assuming sparse weight in ELL format.
+
+    Every row of the weight stores the same number of elements, so the
+    reduction has a constant extent and the padding elements are zeros.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        2-D with shape [m, k]
+
+    w_data : tvm.te.Tensor
+        2-D with shape [n, width]
+
+    w_indices : tvm.te.Tensor
+        2-D with shape [n, width]
+
+    bias : tvm.te.Tensor, optional
+        1-D with shape [n]
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D with shape [m, n]
+    """
+    assert (
+        len(w_data.shape) == 2 and len(w_indices.shape) == 2 and len(data.shape) == 2
+    ), "only support 2-dim dense"
+    if bias is not None:
+        assert len(bias.shape) == 1
+    M, _ = data.shape
+    N, width = w_data.shape
+    elem = te.reduce_axis((0, width), name="elem")
+    oshape = (M, N)
+    matmul = te.compute(
+        oshape,
+        lambda i, j: te.sum(w_data[j, elem] * data[i, w_indices[j, elem]], axis=elem),
+        tag="dense_sw_ell",
+    )
+    if bias is not None:
+        matmul = te.compute(oshape, lambda i, j: matmul[i, j] + bias[j], tag=tag.BROADCAST)
+    return matmul
+
+
 def dense(data, weight, bias=None):
     """Applies a linear transformation: :math:`Y = XW^T + b`.
-    Either data or weight should be tvm.contrib.sparse.CSRNDArray.
+    Either data or weight should be a sparse placeholder. The data can be CSR,
+    the weight CSR, BSR or ELL.
 
     Parameters
     ----------
-    data : tvm.contrib.sparse.CSRNDArray or te.tensor.Tensor
+    data : tvm.contrib.sparse.CSRPlaceholderOp or te.tensor.Tensor
         2-D with shape [batch, in_dim]
 
-    weight : te.tensor.Tensor or tvm.contrib.sparse.CSRNDArray
+    weight : te.tensor.Tensor or tvm.contrib.sparse.SparsePlaceholderOp
         2-D with shape [out_dim, in_dim]
 
     bias : te.tensor.Tensor, optional
@@ -209,6 +256,16 @@ def dense(data, weight, bias=None):
         weight, tvm.contrib.sparse.CSRPlaceholderOp
     ):
         ret = dense_sw(data, weight.data, weight.indices, weight.indptr, bias)
+    elif isinstance(data, te.tensor.Tensor) and isinstance(
+        weight, tvm.contrib.sparse.BSRPlaceholderOp
+    ):
+        ret = sparse_dense(data, weight.data, weight.indices, weight.indptr)
+        if bias is not None:
+            ret = te.compute(ret.shape, lambda i, j: ret[i, j] + bias[j], tag=tag.BROADCAST)
+    elif isinstance(data, te.tensor.Tensor) and isinstance(
+        weight, tvm.contrib.sparse.ELLPlaceholderOp
+    ):
+        ret = dense_sw_ell(data, weight.data, weight.indices, bias)
     else:
         raise NotImplementedError(
             "implementation for %s as data and %s as weights, "
@@ -16,12 +16,15 @@
 # under the License.
 # pylint: disable=invalid-name,too-many-locals,unused-variable
 """x86 batch_matmul operators"""
+import tvm
 from tvm import te
 from tvm import autotvm
 from tvm.autotvm.task.space import SplitEntity
 from tvm.contrib import cblas
 from .. import generic
 from ..util import traverse_inline, get_const_tuple, get_max_power2_factor
+from .dense import _default_dense_int8_config, pack_int8_weight, schedule_int8_matmul_template
+from .util import get_int32_lanes
 
 
 @autotvm.register_topi_compute("batch_matmul.x86")
@@ -128,6 +131,86 @@ def _default_batch_matmul_config(cfg, M, N, K):
     cfg["tile_y"] = SplitEntity([M // y_bn, y_bn])
 
 
+@autotvm.register_topi_compute("batch_matmul_int8.x86")
+def batch_matmul_int8(cfg, x, y, out_dtype="int32"):
+    """Computes uint8 x int8 batch matrix multiplication with int32 accumulation,
+    using the int8 dot product instructions of the target.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        Autotvm tuning space config file
+    x : tvm.te.Tensor
+        3-D uint8 with shape [batch, M, K], K is a multiple of 4
+    y : tvm.te.Tensor
+        3-D int8 with shape [batch, N, K], N is a multiple of the int32 lanes of the target
+    out_dtype : str
+        The output type, only int32 is supported.
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, M, N]
+    """
+    assert len(x.shape) == 3 and len(y.shape) == 3, "only support 3-dim batch_matmul"
+    assert x.dtype == "uint8" and y.dtype == "int8" and out_dtype == "int32"
+    XB, M, XK = get_const_tuple(x.shape)
+    YB, N, YK = get_const_tuple(y.shape)
+    assert XB == YB, "batch dimension doesn't match"
+    assert XK == YK, "shapes of x and y is inconsistant"
+    B = XB
+    K = XK
+    int32_lanes = get_int32_lanes()
+    cfg.define_split("tile_y", M, num_outputs=2)
+    cfg.define_split("tile_x", N, num_outputs=2, filter=lambda s: s.size[-1] % int32_lanes == 0)
+    cfg.define_split("tile_k", K // 4, num_outputs=2)
+    if cfg.is_fallback:
+        _default_dense_int8_config(cfg, M, N, K, int32_lanes)
+    cfg.add_flop(2 * B * M * N * K)
+
+    packy = pack_int8_weight(y, int32_lanes)
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+    ko = te.reduce_axis((0, K // 4), name="ko")
+    ki = te.reduce_axis((0, 4), name="ki")
+    C = te.compute(
+        (B, M, N),
+        lambda b, i, j: te.sum(
+            x[b, i, ko * 4 + ki].astype(out_dtype)
+            * packy[b, idxdiv(j, int32_lanes), ko, idxmod(j, int32_lanes), ki].astype(out_dtype),
+            axis=[ko, ki],
+        ),
+        tag="batch_matmul_int8",
+    )
+    return C
+
+
+@autotvm.register_topi_schedule("batch_matmul_int8.x86")
+def schedule_batch_matmul_int8(cfg, outs):
+    """Schedule for batch_matmul_int8
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        AutoTVM tuning space config file.
+    outs : Array of Tensor
+        The computation graph description of batch_matmul_int8
+        in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "batch_matmul_int8" in op.tag:
+            schedule_int8_matmul_template(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
 @autotvm.register_topi_compute("batch_matmul_cblas.x86")
 def batch_matmul_cblas(cfg, x, y):
     """Computes batch matrix multiplication of `x` and `y` when `x` and `y` are
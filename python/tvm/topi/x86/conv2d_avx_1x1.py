@@ -25,8 +25,8 @@ from ..nn.pad import pad
 from ..nn.util import get_pad_tuple
 from ..generic import conv2d as conv2d_generic
 from ..util import get_const_tuple, simplify
-from .tensor_intrin import dot_16x1x16_uint8_int8_int32
-from .util import get_fp32_len
+from .tensor_intrin import dot_16x1x16_uint8_int8_int32, dot_uint8_int8_int32
+from .util import get_fp32_len, get_int32_lanes
 
 
 def _fallback_schedule(cfg, wkl):
@@ -154,8 +154,8 @@ def _schedule_conv_NCHWc_int8(s, cfg, data_vec, kernel_vec, conv_out, last):
         kernel_vec,
         conv_out,
         last,
-        int32_lanes=16,
-        intrin=dot_16x1x16_uint8_int8_int32(),
+        int32_lanes=get_int32_lanes(),
+        intrin=dot_uint8_int8_int32(),
     )
 
 
@@ -30,6 +30,7 @@ from ..nn.depthwise_conv2d import _get_workload as _get_depthwise_conv2d_workloa
 from ..util import get_const_tuple, traverse_inline
 from .. import nn
 from . import conv2d_avx_1x1, conv2d_avx_common
+from .util import get_int32_lanes, target_has_avx2
 
 
 def _get_default_config_int8(
@@ -47,22 +48,23 @@ def _get_default_config_int8(
     else:
         wkl = _get_conv2d_workload(data, kernel, strides, padding, out_dtype, layout)
         is_kernel_1x1 = wkl.hkernel == 1 and wkl.wkernel == 1
+        int32_lanes = get_int32_lanes()
         if is_kernel_1x1:
             conv2d_generic.fallback_schedule_cpu_1x1_int8(
-                cfg, wkl, int32_lanes=16, num_int8_elements=4
+                cfg, wkl, int32_lanes=int32_lanes, num_int8_elements=4
             )
         else:
             conv2d_generic.fallback_schedule_cpu_common_int8(
-                cfg, wkl, int32_lanes=16, num_int8_elements=4
+                cfg, wkl, int32_lanes=int32_lanes, num_int8_elements=4
             )
 
 
 def is_int8_hw_support(data_dtype, kernel_dtype):
     """
-    Checks to ensure that we can use Intel DLBoost instructions
+    Checks to ensure that we can use Intel DLBoost or AVX2 instructions
     1) The datatypes are correct.
     2) LLVM version has support for the instructions.
-    3) Target is skylake and above.
+    3) Target has AVX2, int8 is fastest with AVX512 and VNNI.
     """
     # 1) Check datatypes
     is_dtype_support = data_dtype == "uint8" and kernel_dtype == "int8"
@@ -73,9 +75,7 @@ def is_int8_hw_support(data_dtype, kernel_dtype):
 
     # 3) Check target
     mcpu = tvm.target.Target.current().mcpu
-    is_target_support = False
-    if mcpu in ("skylake-avx512", "cascadelake"):
-        is_target_support = True
+    is_target_support = target_has_avx2(mcpu)
 
     return is_dtype_support and is_llvm_support and is_target_support
 
@@ -142,7 +142,10 @@ def conv2d_NCHWc_int8(cfg, data, kernel, strides, padding, dilation, layout, out
     ow = (iw - kernel_width + pl + pr) // sw + 1
 
     cfg.define_split("tile_ic", in_channel, num_outputs=2, filter=lambda y: y.size[-1] % 4 == 0)
-    cfg.define_split("tile_oc", num_filter, num_outputs=2, filter=lambda y: y.size[-1] % 16 == 0)
+    int32_lanes = get_int32_lanes()
+    cfg.define_split(
+        "tile_oc", num_filter, num_outputs=2, filter=lambda y: y.size[-1] % int32_lanes == 0
+    )
     cfg.define_split("tile_ow", ow, num_outputs=2, filter=lambda y: y.size[-1] <= 64)
     if is_kernel_1x1:
         cfg.define_knob("tile_oh", [1, 2] if oh > 1 else [1])
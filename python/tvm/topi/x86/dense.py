@@ -25,9 +25,10 @@ from tvm.contrib import cblas
 from tvm.contrib import mkl
 from tvm.contrib import mkldnn
 
-from .util import get_fp32_len
+from .tensor_intrin import dot_uint8_int8_int32
+from .util import get_fp32_len, get_int32_lanes
 from .. import generic, tag
-from ..util import traverse_inline, get_const_tuple
+from ..util import traverse_inline, get_const_tuple, get_max_power2_factor
 
 
 def _schedule_dense_pack_template(cfg, s, C):
@@ -232,6 +233,133 @@ def schedule_dense_pack(cfg, outs):
     return s
 
 
+def _default_dense_int8_config(cfg, M, N, K, int32_lanes):
+    # Keep the int32 accumulators of a tile in the vector registers.
+    if isinstance(M, tvm.tir.Var):
+        M = 16
+    y_bn = get_max_power2_factor(M, 4)
+    x_bn = int32_lanes * get_max_power2_factor(N // int32_lanes, 2)
+    k_bn = get_max_power2_factor(K // 4, 16)
+    cfg["tile_y"] = SplitEntity([M // y_bn, y_bn])
+    cfg["tile_x"] = SplitEntity([N // x_bn, x_bn])
+    cfg["tile_k"] = SplitEntity([K // 4 // k_bn, k_bn])
+
+
+def pack_int8_weight(weight, int32_lanes):
+    """Pack a [..., N, K] int8 weight into [..., N // int32_lanes, K // 4, int32_lanes, 4],
+    the layout read by the int8 dot product intrinsics."""
+    *batch, N, K = get_const_tuple(weight.shape)
+    assert N % int32_lanes == 0, "N=%d is not a multiple of %d" % (N, int32_lanes)
+    assert K % 4 == 0, "K=%d is not a multiple of 4" % K
+    return te.compute(
+        (*batch, N // int32_lanes, K // 4, int32_lanes, 4),
+        lambda *i: weight(*i[:-4], i[-4] * int32_lanes + i[-2], i[-3] * 4 + i[-1]),
+        name="packed_weight",
+    )
+
+
+def schedule_int8_matmul_template(cfg, s, C, O):
+    """Schedule the uint8 x int8 matmul C, whose last stage is O, for dense_int8 and
+    batch_matmul_int8. The reduction over 4 elements and int32_lanes columns is
+    tensorized by the dot product intrinsic of the target."""
+    int32_lanes = get_int32_lanes()
+    if C == O:
+        CC = s.cache_write(C, "global")
+    else:
+        CC = C
+
+    *batch, y, x = s[O].op.axis
+    yo, yi = cfg["tile_y"].apply(s, O, y)
+    xo, xi = cfg["tile_x"].apply(s, O, x)
+    s[O].reorder(*batch, yo, xo, yi, xi)
+    fused = s[O].fuse(*batch, yo, xo)
+    s[O].parallel(fused)
+    s[O].vectorize(xi)
+    s[CC].compute_at(s[O], fused)
+
+    y, x = s[CC].op.axis[-2:]
+    ko, ki = s[CC].op.reduce_axis
+    xo, xi = s[CC].split(x, factor=int32_lanes)
+    koo, koi = cfg["tile_k"].apply(s, CC, ko)
+    s[CC].reorder(koo, koi, y, xo, xi, ki)
+    s[CC].unroll(y)
+    s[CC].unroll(xo)
+    s[CC].tensorize(xi, dot_uint8_int8_int32())
+
+    for packed_weight in C.op.input_tensors:
+        if isinstance(packed_weight.op, te.ComputeOp) and packed_weight.op.name == "packed_weight":
+            axes = s[packed_weight].op.axis
+            s[packed_weight].parallel(s[packed_weight].fuse(*axes[:-3]))
+            s[packed_weight].vectorize(s[packed_weight].fuse(*axes[-2:]))
+    return s
+
+
+@autotvm.register_topi_compute("dense_int8.x86")
+def dense_int8(cfg, data, weight, bias=None, out_dtype=None):
+    """Compute uint8 x int8 dense with int32 accumulation.
+
+    The weight is packed so the innermost computation maps onto the VNNI,
+    AVX512 or AVX2 dot product instructions of the target. N must be a
+    multiple of the int32 lanes of the target and K a multiple of 4. A 4-D
+    weight is taken as already packed by the alter op layout of dense.
+    """
+    if out_dtype is None:
+        out_dtype = "int32"
+    assert data.dtype == "uint8" and weight.dtype == "int8" and out_dtype == "int32"
+    M, K = get_const_tuple(data.shape)
+    int32_lanes = get_int32_lanes()
+    if len(weight.shape) == 4:
+        N_outer, _, lanes, _ = get_const_tuple(weight.shape)
+        assert lanes == int32_lanes, "weight packed for %d lanes, target has %d" % (
+            lanes,
+            int32_lanes,
+        )
+        N = N_outer * lanes
+        packw = weight
+    else:
+        N, _ = get_const_tuple(weight.shape)
+        packw = pack_int8_weight(weight, int32_lanes)
+    # create tuning space
+    cfg.define_split("tile_y", 32 if isinstance(M, tvm.tir.Var) else M, num_outputs=2)
+    cfg.define_split("tile_x", N, num_outputs=2, filter=lambda y: y.size[-1] % int32_lanes == 0)
+    cfg.define_split("tile_k", K // 4, num_outputs=2)
+    if cfg.is_fallback:
+        _default_dense_int8_config(cfg, M, N, K, int32_lanes)
+    if not isinstance(M, tvm.tir.Var):
+        cfg.add_flop(2 * M * N * K)
+
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+    ko = te.reduce_axis((0, K // 4), name="ko")
+    ki = te.reduce_axis((0, 4), name="ki")
+    C = te.compute(
+        (M, N),
+        lambda y, x: te.sum(
+            data[y, ko * 4 + ki].astype(out_dtype)
+            * packw[idxdiv(x, int32_lanes), ko, idxmod(x, int32_lanes), ki].astype(out_dtype),
+            axis=[ko, ki],
+        ),
+        tag="dense_int8",
+    )
+    if bias is not None:
+        C = te.compute((M, N), lambda i, j: C[i, j] + bias[j].astype(out_dtype), tag=tag.BROADCAST)
+    return C
+
+
+@autotvm.register_topi_schedule("dense_int8.x86")
+def schedule_dense_int8(cfg, outs):
+    """Create the schedule for dense_int8, elementwise epilogues such as the
+    requantization are computed in the tiles of the matmul."""
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "dense_int8" in op.tag:
+            schedule_int8_matmul_template(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
 def dense_blas_common(cfg, data, weight, bias, out_dtype, lib):
     """Compute dense using a BLAS library"""
     M, K = get_const_tuple(data.shape)
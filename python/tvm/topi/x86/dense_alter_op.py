@@ -0,0 +1,56 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,unused-variable,unused-argument,no-member
+"""Dense alter op functions for x86"""
+
+import tvm
+from tvm import te
+from tvm import relay
+from tvm import autotvm
+from .util import get_int32_lanes
+from ..util import get_const_tuple
+from ..nn import dense_alter_layout
+
+
+@dense_alter_layout.register("cpu")
+def _alter_dense_layout(attrs, inputs, tinfos, out_type):
+    target = tvm.target.Target.current(allow_none=False)
+    dispatch_ctx = autotvm.task.DispatchContext.current
+    data_tensor, weight_tensor = tinfos
+    if data_tensor.dtype != "uint8" or weight_tensor.dtype != "int8":
+        return None
+    _, outs = relay.backend.compile_engine.select_implementation(
+        relay.op.get("nn.dense"), attrs, tinfos, out_type, target
+    )
+    workload = autotvm.task.get_workload(outs)
+    if workload is None or workload[0] != "dense_int8.x86":
+        return None
+    cfg = dispatch_ctx.query(target, workload)
+
+    # Pack the weight once in the graph, so that a constant weight is folded
+    # by FoldConstant instead of being re-packed by every call of the kernel.
+    lanes = get_int32_lanes()
+    weight_layout = "NC%dn4c" % lanes
+    N, K = get_const_tuple(weight_tensor.shape)
+    new_weight = te.placeholder((N // lanes, K // 4, lanes, 4), dtype=weight_tensor.dtype)
+    new_workload = autotvm.task.args_to_workload(
+        [data_tensor, new_weight, None, out_type.dtype], workload[0]
+    )
+    dispatch_ctx.update(target, new_workload, cfg)
+    return relay.nn.contrib_dense_pack(
+        inputs[0], inputs[1], weight_layout=weight_layout, out_dtype=attrs.out_dtype
+    )
@@ -16,10 +16,46 @@
 # under the License.
 
 """sparse_dense schedule on x86"""
+import tvm
 from tvm import te
 
+from ..nn.sparse import sparse_default_block_size
 from ..util import traverse_inline, get_const_int
-from .util import get_fp32_len
+from .util import get_fp32_len, target_has_avx512
+
+
+def default_block_size(mcpu=""):
+    """The BSR block size of a weight that suits the sparse kernels of the CPU.
+
+    A block of one column and a vector of rows multiplies a broadcast input
+    element with a contiguous vector of weights.
+
+    Parameters
+    ----------
+    mcpu : str
+        The -mcpu of the target.
+
+    Returns
+    -------
+    blocksize : tuple of int
+        The (rows, columns) of a block.
+    """
+    return (16 if target_has_avx512(mcpu) else 8, 1)
+
+
+@sparse_default_block_size.register("cpu")
+def _sparse_default_block_size_cpu():
+    target = tvm.target.Target.current(allow_none=False)
+    return default_block_size(target.mcpu)
+
+
+def _vectorize_block_rows(stage, b_r, bs_r, simd_width):
+    """Vectorize the rows of a block, in SIMD sized pieces when the block is larger."""
+    if bs_r > simd_width and bs_r % simd_width == 0:
+        _, b_ri = stage.split(b_r, simd_width)
+        stage.vectorize(b_ri)
+    else:
+        stage.vectorize(b_r)
 
 
 def schedule_sparse_dense(outs):
@@ -42,7 +78,7 @@ def schedule_sparse_dense(outs):
             bs_r = get_const_int(b_r.dom.extent)
             (elem_idx, c) = s[y_bsrmm].op.reduce_axis
             s[y_bsrmm].reorder(num_blocks, m, elem_idx, b_r, c)
-            s[y_bsrmm].vectorize(b_r)
+            _vectorize_block_rows(s[y_bsrmm], b_r, bs_r, simd_width)
             (m_o, n_o) = s[y_reshape].op.axis
             (noo, noi) = s[y_reshape].split(n_o, bs_r)
             s[y_bsrmm].compute_at(s[y_reshape], noi)
@@ -58,3 +94,42 @@ def schedule_sparse_dense(outs):
 
     traverse_inline(s, outs[0].op, _callback)
     return s
+
+
+def schedule_sparse_conv2d(outs):
+    """Create schedule for sparse conv2d"""
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        simd_width = get_fp32_len()
+        if op.tag == "sparse_conv2d_csr":
+            out = outs[0]
+            (n, h, w, _) = s[out].op.axis
+            if op != out.op:
+                s[op].compute_at(s[out], w)
+            s[out].parallel(s[out].fuse(n, h))
+        if op.tag == "sparse_conv2d_bsr":
+            block = op.input_tensors[0]
+            assert block.op.tag == "sparse_conv2d_bsr_block"
+            (_, _, _, num_blocks, b_r) = s[block].op.axis
+            bs_r = get_const_int(b_r.dom.extent)
+            (elem_idx, c) = s[block].op.reduce_axis
+            s[block].reorder(num_blocks, elem_idx, c, b_r)
+            _vectorize_block_rows(s[block], b_r, bs_r, simd_width)
+            # Each pixel computes its blocks and reshapes them while they are in cache.
+            (n, h, _, oc) = s[op].op.axis
+            (oc_o, oc_i) = s[op].split(oc, bs_r)
+            s[block].compute_at(s[op], oc_o)
+            s[op].vectorize(oc_i)
+            if op != outs[0].op:
+                out = outs[0]
+                (n, h, _, oc) = s[out].op.axis
+                (oc_o, oc_i) = s[out].split(oc, bs_r)
+                s[op].compute_at(s[out], oc_o)
+                s[out].vectorize(oc_i)
+                s[out].parallel(s[out].fuse(n, h))
+            else:
+                s[op].parallel(s[op].fuse(n, h))
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
@@ -19,22 +19,136 @@
 import tvm
 from tvm import te
 import tvm.target.codegen
+from .util import target_has_avx2, target_has_avx512, target_has_vnni
+
+
+def dot_uint8_int8_int32():
+    """Dispatch the intrin producing get_int32_lanes() int32 lanes on the target"""
+    mcpu = tvm.target.Target.current().mcpu
+
+    assert target_has_avx2(mcpu), "An old machine that does not have fast Int8 support."
+    if target_has_avx512(mcpu):
+        return dot_16x1x16_uint8_int8_int32()
+    return dot_8x1x8_uint8_int8_int32_avx2()
 
 
 def dot_16x1x16_uint8_int8_int32():
     """Dispatch the most optimized intrin depending on the target"""
     mcpu = tvm.target.Target.current().mcpu
 
-    assert mcpu in (
-        "skylake-avx512",
-        "cascadelake",
-    ), "An old Intel machine that does not have fast Int8 support."
-    if mcpu == "skylake-avx512":
+    assert target_has_avx512(mcpu), "An old Intel machine that does not have fast Int8 support."
+    if not target_has_vnni(mcpu):
         return dot_16x1x16_uint8_int8_int32_skylake()
-    # cascadelake
+    # cascadelake and later
     return dot_16x1x16_uint8_int8_int32_cascadelake()
 
 
+def dot_8x1x8_uint8_int8_int32_avx2():
+    """
+    Int8 dot product by every 4 elements using AVX2 instructions.
+    This function takes two arrays of uint8 and int8 datatype -- data[4] and
+    kernel[8][4] -- and computes a dot product of data[4] with every
+    4 elements of kernels, resulting in output[8] of int32 datatype.
+    The pseudo code is as follows.
+    .. code-block:: c
+        void dot_8x1x8_uint8_int8_int32_avx2(uint8 data[4], int8 kernel[8][4],
+                int32 output[8]){
+            for (int i = 0; i < 8; i++){
+                output[i] = 0;
+                for (int k = 0; k < 4; k++){
+                    output[i] += data[k] * kernel[i][k]
+                }
+            }
+        }
+
+    Physically, the kernel array sits in an AVX2 vector register and
+    the data[4] is broadcasted to another AVX2 vector register. The bytes
+    are widened to int16, the even and the odd ones apart, and multiplied
+    with vpmaddwd. Unlike vpmaddubsw, this does not saturate the sum of a
+    pair of products, so the result is exact for the full uint8 range.
+    This function returns a TensorIntrin that can be used to tensorize a
+    schedule.
+
+    Returns
+    -------
+    intrin : TensorIntrin
+        The AVX2 int8 TensorIntrin that can be used in tensorizing schedule
+    """
+
+    int32_lanes = 8  # 8 int32 lanes in AVX2
+    num_int8_elements = 4  # 4 int8 elements in int32
+    data = te.placeholder((num_int8_elements,), dtype="uint8", name="data")
+    kernel = te.placeholder((int32_lanes, num_int8_elements), dtype="int8", name="kernel")
+    k = te.reduce_axis((0, num_int8_elements), name="k")
+    C = te.compute(
+        (int32_lanes,),
+        lambda i: te.sum(data[k].astype("int32") * kernel[i, k].astype("int32"), axis=k),
+        name="C",
+    )
+
+    a_buffer = tvm.tir.decl_buffer(
+        data.shape, dtype="uint8", name="a_buffer", offset_factor=1, strides=[1]
+    )
+    b_buffer = tvm.tir.decl_buffer(
+        kernel.shape, dtype="int8", name="b_buffer", offset_factor=1, strides=[te.var("ldw"), 1]
+    )
+
+    def _intrin_func(ins, outs):
+        def _instr(index):
+            ib = tvm.tir.ir_builder.create()
+            if index == 1:
+                ib.emit(outs[0].vstore(0, tvm.tir.const(0, "int32x8")))
+                return ib.get()
+
+            a_int8 = ins[0].vload([0], "uint8x4")
+            re_int32 = tvm.tir.call_intrin("int32", "tir.reinterpret", a_int8)
+            vec_ai32 = re_int32.astype("int32x8")
+            # Each int16 lane holds two bytes, data[0..1] or data[2..3] of a lane.
+            vec_a = tvm.tir.call_intrin("int16x16", "tir.reinterpret", vec_ai32)
+            vec_b = ins[1].vload([0, 0], "int8x32")
+            vec_b = tvm.tir.call_intrin("int16x16", "tir.reinterpret", vec_b)
+            byte_bits = tvm.tir.const(8, "int16x16")
+            byte_mask = tvm.tir.const(0xFF, "int16x16")
+            # Zero extend the uint8 data and sign extend the int8 kernel, the low bytes
+            # hold data[0], data[2] and the high bytes data[1], data[3].
+            vec_a_low = vec_a & byte_mask
+            vec_a_high = (vec_a >> byte_bits) & byte_mask
+            vec_b_low = (vec_b << byte_bits) >> byte_bits
+            vec_b_high = vec_b >> byte_bits
+            # A product of uint8 and int8 fits in int16 and vpmaddwd adds the pairs in int32.
+            low_reduction = tvm.tir.call_llvm_pure_intrin(
+                "int32x8",
+                "llvm.x86.avx2.pmadd.wd",
+                tvm.tir.const(0, "uint32"),
+                vec_a_low,
+                vec_b_low,
+            )
+            high_reduction = tvm.tir.call_llvm_pure_intrin(
+                "int32x8",
+                "llvm.x86.avx2.pmadd.wd",
+                tvm.tir.const(0, "uint32"),
+                vec_a_high,
+                vec_b_high,
+            )
+            quad_reduction = low_reduction + high_reduction
+            if index == 0:
+                ib.emit(outs[0].vstore(0, quad_reduction))
+            else:
+                ib.emit(outs[0].vstore(0, quad_reduction + outs[0].vload([0], "int32x8")))
+            return ib.get()
+
+        # body, reset, update
+        return _instr(0), _instr(1), _instr(2)
+
+    buffer_params = {"offset_factor": 1}
+    return te.decl_tensor_intrin(
+        C.op,
+        _intrin_func,
+        binds={data: a_buffer, kernel: b_buffer},
+        default_buffer_params=buffer_params,
+    )
+
+
 def dot_16x1x16_uint8_int8_int32_skylake():
     """
     Int8 dot product by every 4 elements using AVX512 Skylake instructions.
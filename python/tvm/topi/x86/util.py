@@ -16,11 +16,22 @@
 # under the License.
 """Common x86 related utilities"""
 import tvm
+from tvm.target.x86 import (  # pylint: disable=unused-import
+    target_has_avx2,
+    target_has_avx512,
+    target_has_vnni,
+)
 
 
 def get_fp32_len():
     mcpu = tvm.target.Target.current().mcpu
     fp32_vec_len = 8
-    if mcpu in ("skylake-avx512", "cascadelake"):
+    if target_has_avx512(mcpu):
         fp32_vec_len = 16
     return fp32_vec_len
+
+
+def get_int32_lanes():
+    """The number of int32 lanes produced by the int8 dot product intrinsic of the target"""
+    mcpu = tvm.target.Target.current().mcpu
+    return 16 if target_has_avx512(mcpu) else 8
@@ -44,6 +44,7 @@ void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
   this->modular_set.Update(var, this->modular_set(new_expr), allow_override);
   this->rewrite_simplify.Update(var, new_expr, allow_override);
   this->canonical_simplify.Update(var, new_expr, allow_override);
+  this->simplify_cache.Clear();
 }
 
 void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
@@ -52,6 +53,7 @@ void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
     this->Bind(var, range->min, allow_override);
   } else {
     this->const_int_bound.Bind(var, range, allow_override);
+    this->simplify_cache.Clear();
   }
   // skip modular_set
   // skip rewrite simplify
@@ -66,9 +68,12 @@ void Analyzer::Bind(const Map<Var, Range>& variables, bool allow_override) {
 void ConstraintContext::EnterWithScope() {
   CHECK(exit_ == nullptr);
   // entering the scope.
+  analyzer_->simplify_cache.EnterScope();
   auto f0 = analyzer_->const_int_bound.EnterConstraint(constraint_);
   auto f1 = analyzer_->modular_set.EnterConstraint(constraint_);
   auto f2 = analyzer_->rewrite_simplify.EnterConstraint(constraint_);
+  // drop the results memoized while the constraint was partially entered.
+  analyzer_->simplify_cache.ClearScope();
   // recovery function.
   exit_ = [f0, f1, f2]() {
     if (f2 != nullptr) f2();
@@ -80,6 +85,7 @@ void ConstraintContext::EnterWithScope() {
 void ConstraintContext::ExitWithScope() {
   CHECK(exit_ != nullptr);
   exit_();
+  analyzer_->simplify_cache.ExitScope();
 }
 
 bool Analyzer::CanProveGreaterEqual(const PrimExpr& expr, int64_t lower_bound) {
@@ -117,14 +123,17 @@ bool Analyzer::CanProve(const PrimExpr& expr) {
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
   if (tir::is_const_int(expr)) return expr;
-  PrimExpr res = expr;
-  for (int i = 0; i < steps; ++i) {
-    res = this->rewrite_simplify(res);
-    if (tir::is_const_int(res) || ++i == steps) return res;
-    res = this->canonical_simplify(res);
-    if (tir::is_const_int(res)) return res;
-  }
-  return res;
+  auto fsimplify = [this, steps](const PrimExpr& expr) {
+    PrimExpr res = expr;
+    for (int i = 0; i < steps; ++i) {
+      res = this->rewrite_simplify(res);
+      if (tir::is_const_int(res) || ++i == steps) return res;
+      res = this->canonical_simplify(res);
+      if (tir::is_const_int(res)) return res;
+    }
+    return res;
+  };
+  return simplify_cache(expr, SimplifyCache::kSimplify + steps, fsimplify);
 }
 
 TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValue* ret) {
@@ -141,6 +150,7 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "const_int_bound_update") {
       return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
         self->const_int_bound.Update(args[0], args[1], args[2]);
+        self->simplify_cache.Clear();
       });
     } else if (name == "Simplify") {
       return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
@@ -158,6 +168,11 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "canonical_simplify") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->canonical_simplify(args[0]); });
+    } else if (name == "simplify_cache_stats") {
+      return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
+        *ret = Array<Integer>({Integer(static_cast<int>(self->simplify_cache.num_hits())),
+                               Integer(static_cast<int>(self->simplify_cache.num_misses()))});
+      });
     } else if (name == "int_set") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->int_set(args[0], args[1]); });
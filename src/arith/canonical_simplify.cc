@@ -1072,14 +1072,16 @@ PrimExpr CanonicalSimplifier::Impl::VisitExpr_(const ReduceNode* op) {
 }
 
 PrimExpr CanonicalSimplifier::operator()(const PrimExpr& expr) {
-  return impl_->CanonicalSimplify(expr);
+  auto fsimplify = [this](const PrimExpr& expr) { return impl_->CanonicalSimplify(expr); };
+  return parent_->simplify_cache(expr, SimplifyCache::kCanonicalSimplify, fsimplify);
 }
 
 void CanonicalSimplifier::Update(const Var& var, const PrimExpr& info, bool override) {
   impl_->Update(var, info, override);
 }
 
-CanonicalSimplifier::CanonicalSimplifier(Analyzer* parent) : impl_(new Impl(parent)) {}
+CanonicalSimplifier::CanonicalSimplifier(Analyzer* parent)
+    : parent_(parent), impl_(new Impl(parent)) {}
 
 CanonicalSimplifier::~CanonicalSimplifier() { delete impl_; }
 
@@ -1590,15 +1590,18 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const LetNode* op) {
 }
 
 PrimExpr RewriteSimplifier::operator()(const PrimExpr& expr) {
-  // Run simplification in post order
-  PrimExpr res = expr;
-  int max_iter = 2;
-  for (int i = 0; i < max_iter; ++i) {
-    PrimExpr new_expr = impl_->operator()(res);
-    if (new_expr.same_as(res)) return res;
-    res = new_expr;
-  }
-  return res;
+  auto fsimplify = [this](const PrimExpr& expr) {
+    // Run simplification in post order
+    PrimExpr res = expr;
+    int max_iter = 2;
+    for (int i = 0; i < max_iter; ++i) {
+      PrimExpr new_expr = impl_->operator()(res);
+      if (new_expr.same_as(res)) return res;
+      res = new_expr;
+    }
+    return res;
+  };
+  return parent_->simplify_cache(expr, SimplifyCache::kRewriteSimplify, fsimplify);
 }
 
 void RewriteSimplifier::Update(const Var& var, const PrimExpr& info, bool allow_override) {
@@ -1609,7 +1612,8 @@ std::function<void()> RewriteSimplifier::EnterConstraint(const PrimExpr& constra
   return impl_->EnterConstraint(constraint);
 }
 
-RewriteSimplifier::RewriteSimplifier(Analyzer* parent) : impl_(new Impl(parent)) {}
+RewriteSimplifier::RewriteSimplifier(Analyzer* parent)
+    : parent_(parent), impl_(new Impl(parent)) {}
 
 RewriteSimplifier::~RewriteSimplifier() { delete impl_; }
 
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/arith/simplify_cache.cc
+ * \brief Memo of simplification results.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/expr.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace arith {
+
+// Whether the analyzers use their memo, only turned off to measure its effect.
+static std::atomic<bool> simplify_cache_enabled{true};
+
+class SimplifyCache::Impl {
+ public:
+  /*! \brief The number of entries of a scope after which its memo is cleared. */
+  static constexpr size_t kMaxEntries = 1 << 14;
+
+  // Entries are keyed by the identity of the expression. Structural equality would
+  // match expressions that bind different variables, such as reductions over distinct
+  // IterVars, and return the variables of the first one. The key holds a reference,
+  // so the address cannot be reused by another expression while the entry exists.
+  struct Key {
+    PrimExpr expr;
+    int kind;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return dmlc::HashCombine(ObjectPtrHash()(key.expr), key.kind);
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.kind == rhs.kind && lhs.expr.same_as(rhs.expr);
+    }
+  };
+
+  using Memo = std::unordered_map<Key, PrimExpr, KeyHash, KeyEqual>;
+
+  /*! \brief The memo of the current scope. */
+  Memo memo;
+  /*! \brief The memos of the enclosing scopes, with the epoch they were saved at. */
+  std::vector<std::pair<Memo, uint64_t>> saved;
+  /*! \brief Incremented whenever the information of a variable changes. */
+  uint64_t epoch{0};
+  int64_t num_hits{0};
+  int64_t num_misses{0};
+};
+
+SimplifyCache::SimplifyCache() : impl_(new Impl()) {}
+
+SimplifyCache::~SimplifyCache() { delete impl_; }
+
+PrimExpr SimplifyCache::operator()(const PrimExpr& expr, int kind,
+                                   const std::function<PrimExpr(const PrimExpr&)>& fsimplify) {
+  // Leaves are cheaper to simplify than to look up.
+  if (!simplify_cache_enabled || expr.as<tir::VarNode>() || expr.as<IntImmNode>() ||
+      expr.as<FloatImmNode>() || expr.as<tir::StringImmNode>()) {
+    return fsimplify(expr);
+  }
+  Impl::Key key{expr, kind};
+  auto it = impl_->memo.find(key);
+  if (it != impl_->memo.end()) {
+    ++impl_->num_hits;
+    return it->second;
+  }
+  ++impl_->num_misses;
+  uint64_t epoch = impl_->epoch;
+  size_t depth = impl_->saved.size();
+  PrimExpr res = fsimplify(expr);
+  // Only memoize when the state did not change during the simplification,
+  // e.g. by a Let binding its variable.
+  if (epoch == impl_->epoch && depth == impl_->saved.size()) {
+    if (impl_->memo.size() >= Impl::kMaxEntries) impl_->memo.clear();
+    impl_->memo.emplace(std::move(key), res);
+  }
+  return res;
+}
+
+void SimplifyCache::Clear() {
+  ++impl_->epoch;
+  impl_->memo.clear();
+}
+
+int64_t SimplifyCache::num_hits() const { return impl_->num_hits; }
+
+int64_t SimplifyCache::num_misses() const { return impl_->num_misses; }
+
+void SimplifyCache::EnterScope() {
+  impl_->saved.emplace_back(std::move(impl_->memo), impl_->epoch);
+  impl_->memo = Impl::Memo();
+}
+
+void SimplifyCache::ClearScope() { impl_->memo.clear(); }
+
+void SimplifyCache::ExitScope() {
+  CHECK(!impl_->saved.empty());
+  // The memo of the enclosing scope is stale if a variable was bound in the scope.
+  if (impl_->saved.back().second == impl_->epoch) {
+    impl_->memo = std::move(impl_->saved.back().first);
+  } else {
+    impl_->memo.clear();
+  }
+  impl_->saved.pop_back();
+}
+
+// Turn the memo off or on in all analyzers, returns the previous setting.
+TVM_REGISTER_GLOBAL("arith.SetSimplifyCacheEnabled").set_body_typed([](bool enabled) {
+  return simplify_cache_enabled.exchange(enabled);
+});
+
+}  // namespace arith
+}  // namespace tvm
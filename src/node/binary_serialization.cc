@@ -0,0 +1,475 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file node/binary_serialization.cc
+ * \brief Compact binary serialization of TVM objects.
+ *
+ *  The layout of the stream is
+ *
+ *  - magic, version string
+ *  - type table: the type keys of the serialized objects
+ *  - tensors: dtype, shape and raw payload of each NDArray, the payload
+ *    starts at an offset aligned to kTensorAlignment from the stream start,
+ *    so a file can be mapped without copying
+ *  - objects in post order: a type index followed by the fields in the
+ *    order of VisitAttrs, integers are LEB128 varints, references to other
+ *    objects and tensors are indices (0 is None)
+ *  - the index of the root
+ *
+ *  Fields are positional, so a stream must be loaded by the same version
+ *  of TVM. Use SaveJSON for long term storage.
+ */
+#include <dmlc/io.h>
+#include <dmlc/memory_io.h>
+#include <tvm/node/container.h>
+#include <tvm/node/reflection.h>
+#include <tvm/node/serialization.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../runtime/object_internal.h"
+
+namespace tvm {
+
+constexpr uint64_t kTVMBinaryMagic = 0xB1A7E5A1F1E0B1A7;
+/*! \brief Alignment of tensor payloads from the start of the stream. */
+constexpr size_t kTensorAlignment = 64;
+
+/*! \brief The kind of the serialized object, written after its type index. */
+enum BinaryObjectKind : uint8_t {
+  kReprBytes = 0,
+  kArray = 1,
+  kMap = 2,
+  kStrMap = 3,
+  kFields = 4,
+};
+
+/*! \brief Writer that tracks the position for alignment. */
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(dmlc::Stream* strm) : strm_(strm) {}
+
+  void WriteBytes(const void* data, size_t size) {
+    strm_->Write(data, size);
+    pos_ += size;
+  }
+  void WriteVarint(uint64_t value) {
+    uint8_t buf[10];
+    size_t n = 0;
+    while (value >= 0x80) {
+      buf[n++] = static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+    }
+    buf[n++] = static_cast<uint8_t>(value);
+    WriteBytes(buf, n);
+  }
+  void WriteSigned(int64_t value) {
+    // zigzag encoding keeps small negative numbers short.
+    WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+  void WriteString(const std::string& value) {
+    WriteVarint(value.size());
+    WriteBytes(value.data(), value.size());
+  }
+  void Align(size_t alignment) {
+    static const char zeros[kTensorAlignment] = {0};
+    CHECK_LE(alignment, kTensorAlignment);
+    size_t pad = (alignment - pos_ % alignment) % alignment;
+    WriteBytes(zeros, pad);
+  }
+
+ private:
+  dmlc::Stream* strm_;
+  size_t pos_{0};
+};
+
+/*! \brief Reader that tracks the position for alignment. */
+class BinaryReader {
+ public:
+  explicit BinaryReader(dmlc::Stream* strm) : strm_(strm) {}
+
+  void ReadBytes(void* data, size_t size) {
+    CHECK_EQ(strm_->Read(data, size), size) << "BinaryReader: unexpected end of stream";
+    pos_ += size;
+  }
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      ReadBytes(&byte, 1);
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    LOG(FATAL) << "BinaryReader: invalid varint";
+    return 0;
+  }
+  int64_t ReadSigned() {
+    uint64_t value = ReadVarint();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+  std::string ReadString() {
+    std::string value(ReadVarint(), '\0');
+    if (!value.empty()) ReadBytes(&value[0], value.size());
+    return value;
+  }
+  void Align(size_t alignment) {
+    char zeros[kTensorAlignment];
+    CHECK_LE(alignment, kTensorAlignment);
+    ReadBytes(zeros, (alignment - pos_ % alignment) % alignment);
+  }
+
+ private:
+  dmlc::Stream* strm_;
+  size_t pos_{0};
+};
+
+// Collect the objects and tensors referenced by the fields of an object.
+class BinaryChildCollector : public AttrVisitor {
+ public:
+  std::vector<Object*>* children;
+  std::vector<DLTensor*>* tensors;
+
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, DataType* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {
+    if (value->defined()) tensors->push_back(const_cast<DLTensor*>((*value).operator->()));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    children->push_back(const_cast<Object*>(value->get()));
+  }
+};
+
+// Index all the objects in post order, so that children come before parents.
+class BinaryNodeIndexer {
+ public:
+  std::unordered_map<Object*, uint64_t> node_index{{nullptr, 0}};
+  std::vector<Object*> node_list{nullptr};
+  std::unordered_map<DLTensor*, uint64_t> tensor_index{{nullptr, 0}};
+  std::vector<DLTensor*> tensor_list{nullptr};
+
+  void MakeIndex(Object* root) {
+    if (root == nullptr) return;
+    // Iterative, so that deep IR does not overflow the stack.
+    std::vector<std::pair<Object*, bool>> stack{{root, false}};
+    std::unordered_map<Object*, bool> in_progress;
+    while (!stack.empty()) {
+      Object* node = stack.back().first;
+      if (node_index.count(node)) {
+        stack.pop_back();
+        continue;
+      }
+      if (stack.back().second) {
+        stack.pop_back();
+        in_progress.erase(node);
+        node_index[node] = node_list.size();
+        node_list.push_back(node);
+        continue;
+      }
+      stack.back().second = true;
+      CHECK(!in_progress.count(node)) << "Cyclic reference detected in " << node->GetTypeKey();
+      in_progress[node] = true;
+      std::vector<Object*> children;
+      Children(node, &children);
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        if (*it != nullptr && !node_index.count(*it)) stack.push_back({*it, false});
+      }
+    }
+  }
+
+ private:
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  void Children(Object* node, std::vector<Object*>* children) {
+    if (node->IsInstance<ArrayNode>()) {
+      for (const auto& elem : *static_cast<ArrayNode*>(node)) {
+        children->push_back(const_cast<Object*>(elem.get()));
+      }
+    } else if (node->IsInstance<MapNode>()) {
+      for (const auto& kv : *static_cast<MapNode*>(node)) {
+        children->push_back(const_cast<Object*>(kv.first.get()));
+        children->push_back(const_cast<Object*>(kv.second.get()));
+      }
+    } else if (!reflection_->GetReprBytes(node, nullptr)) {
+      std::vector<DLTensor*> tensors;
+      BinaryChildCollector collector;
+      collector.children = children;
+      collector.tensors = &tensors;
+      reflection_->VisitAttrs(node, &collector);
+      for (DLTensor* tensor : tensors) {
+        if (tensor_index.count(tensor)) continue;
+        tensor_index[tensor] = tensor_list.size();
+        tensor_list.push_back(tensor);
+      }
+    }
+  }
+};
+
+// Write the fields of an object.
+class BinaryAttrWriter : public AttrVisitor {
+ public:
+  BinaryWriter* writer;
+  const BinaryNodeIndexer* indexer;
+
+  void Visit(const char* key, double* value) final { writer->WriteBytes(value, sizeof(double)); }
+  void Visit(const char* key, int64_t* value) final { writer->WriteSigned(*value); }
+  void Visit(const char* key, uint64_t* value) final { writer->WriteVarint(*value); }
+  void Visit(const char* key, int* value) final { writer->WriteSigned(*value); }
+  void Visit(const char* key, bool* value) final { writer->WriteVarint(*value ? 1 : 0); }
+  void Visit(const char* key, std::string* value) final { writer->WriteString(*value); }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to serialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    writer->WriteVarint(value->code());
+    writer->WriteVarint(value->bits());
+    writer->WriteVarint(value->lanes());
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    DLTensor* tensor = value->defined() ? const_cast<DLTensor*>((*value).operator->()) : nullptr;
+    writer->WriteVarint(indexer->tensor_index.at(tensor));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    writer->WriteVarint(indexer->node_index.at(const_cast<Object*>(value->get())));
+  }
+};
+
+// Read the fields of an object.
+class BinaryAttrReader : public AttrVisitor {
+ public:
+  BinaryReader* reader;
+  const std::vector<ObjectPtr<Object>>* nodes;
+  const std::vector<runtime::NDArray>* tensors;
+
+  void Visit(const char* key, double* value) final { reader->ReadBytes(value, sizeof(double)); }
+  void Visit(const char* key, int64_t* value) final { *value = reader->ReadSigned(); }
+  void Visit(const char* key, uint64_t* value) final { *value = reader->ReadVarint(); }
+  void Visit(const char* key, int* value) final { *value = static_cast<int>(reader->ReadSigned()); }
+  void Visit(const char* key, bool* value) final { *value = reader->ReadVarint() != 0; }
+  void Visit(const char* key, std::string* value) final { *value = reader->ReadString(); }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to deserialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    int code = static_cast<int>(reader->ReadVarint());
+    int bits = static_cast<int>(reader->ReadVarint());
+    int lanes = static_cast<int>(reader->ReadVarint());
+    *value = DataType(code, bits, lanes);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    *value = tensors->at(reader->ReadVarint());
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    *value = ObjectRef(nodes->at(reader->ReadVarint()));
+  }
+};
+
+void SaveBinary(dmlc::Stream* strm, const ObjectRef& node) {
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  BinaryNodeIndexer indexer;
+  indexer.MakeIndex(const_cast<Object*>(node.get()));
+  BinaryWriter writer(strm);
+  uint64_t magic = kTVMBinaryMagic;
+  writer.WriteBytes(&magic, sizeof(magic));
+  writer.WriteString(TVM_VERSION);
+  // type table
+  std::unordered_map<uint32_t, uint64_t> type_index;
+  std::vector<std::string> type_keys;
+  for (size_t i = 1; i < indexer.node_list.size(); ++i) {
+    uint32_t tindex = indexer.node_list[i]->type_index();
+    if (type_index.count(tindex)) continue;
+    type_index[tindex] = type_keys.size();
+    type_keys.push_back(indexer.node_list[i]->GetTypeKey());
+  }
+  writer.WriteVarint(type_keys.size());
+  for (const std::string& key : type_keys) writer.WriteString(key);
+  // tensors
+  writer.WriteVarint(indexer.tensor_list.size() - 1);
+  for (size_t i = 1; i < indexer.tensor_list.size(); ++i) {
+    const DLTensor* tensor = indexer.tensor_list[i];
+    writer.WriteVarint(tensor->dtype.code);
+    writer.WriteVarint(tensor->dtype.bits);
+    writer.WriteVarint(tensor->dtype.lanes);
+    writer.WriteVarint(tensor->ndim);
+    for (int d = 0; d < tensor->ndim; ++d) writer.WriteSigned(tensor->shape[d]);
+    size_t nbytes = runtime::GetDataSize(*tensor);
+    writer.WriteVarint(nbytes);
+    writer.Align(kTensorAlignment);
+    if (tensor->ctx.device_type == kDLCPU && runtime::IsContiguous(*tensor)) {
+      writer.WriteBytes(static_cast<const char*>(tensor->data) + tensor->byte_offset, nbytes);
+    } else {
+      std::vector<char> bytes(nbytes);
+      CHECK_EQ(TVMArrayCopyToBytes(const_cast<DLTensor*>(tensor), bytes.data(), nbytes), 0)
+          << TVMGetLastError();
+      writer.WriteBytes(bytes.data(), nbytes);
+    }
+  }
+  // objects, children before parents.
+  BinaryAttrWriter attr_writer;
+  attr_writer.writer = &writer;
+  attr_writer.indexer = &indexer;
+  writer.WriteVarint(indexer.node_list.size() - 1);
+  std::string repr_bytes;
+  for (size_t i = 1; i < indexer.node_list.size(); ++i) {
+    Object* obj = indexer.node_list[i];
+    writer.WriteVarint(type_index.at(obj->type_index()));
+    if (obj->IsInstance<ArrayNode>()) {
+      auto* n = static_cast<ArrayNode*>(obj);
+      writer.WriteVarint(kArray);
+      writer.WriteVarint(n->size());
+      for (const auto& elem : *n) {
+        writer.WriteVarint(indexer.node_index.at(const_cast<Object*>(elem.get())));
+      }
+    } else if (obj->IsInstance<MapNode>()) {
+      auto* n = static_cast<MapNode*>(obj);
+      writer.WriteVarint(kMap);
+      writer.WriteVarint(n->size());
+      for (const auto& kv : *n) {
+        writer.WriteVarint(indexer.node_index.at(const_cast<Object*>(kv.first.get())));
+        writer.WriteVarint(indexer.node_index.at(const_cast<Object*>(kv.second.get())));
+      }
+    } else if (reflection->GetReprBytes(obj, &repr_bytes)) {
+      writer.WriteVarint(kReprBytes);
+      writer.WriteString(repr_bytes);
+    } else {
+      writer.WriteVarint(kFields);
+      reflection->VisitAttrs(obj, &attr_writer);
+    }
+  }
+  writer.WriteVarint(indexer.node_index.at(const_cast<Object*>(node.get())));
+}
+
+ObjectRef LoadBinary(dmlc::Stream* strm) {
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  BinaryReader reader(strm);
+  uint64_t magic;
+  reader.ReadBytes(&magic, sizeof(magic));
+  CHECK_EQ(magic, kTVMBinaryMagic) << "Invalid TVM binary IR format";
+  std::string version = reader.ReadString();
+  CHECK_EQ(version, TVM_VERSION) << "Binary IR saved by TVM " << version
+                                 << " cannot be loaded by TVM " << TVM_VERSION
+                                 << ", use SaveJSON to exchange IR between versions";
+  std::vector<std::string> type_keys(reader.ReadVarint());
+  for (std::string& key : type_keys) key = reader.ReadString();
+  // tensors
+  std::vector<runtime::NDArray> tensors(1);
+  size_t num_tensors = reader.ReadVarint();
+  for (size_t i = 0; i < num_tensors; ++i) {
+    DLDataType dtype;
+    dtype.code = static_cast<uint8_t>(reader.ReadVarint());
+    dtype.bits = static_cast<uint8_t>(reader.ReadVarint());
+    dtype.lanes = static_cast<uint16_t>(reader.ReadVarint());
+    std::vector<int64_t> shape(reader.ReadVarint());
+    for (int64_t& dim : shape) dim = reader.ReadSigned();
+    size_t nbytes = reader.ReadVarint();
+    reader.Align(kTensorAlignment);
+    runtime::NDArray tensor = runtime::NDArray::Empty(shape, dtype, {kDLCPU, 0});
+    CHECK_EQ(runtime::GetDataSize(*tensor.operator->()), nbytes)
+        << "Tensor size does not match its shape";
+    reader.ReadBytes(tensor->data, nbytes);
+    tensors.emplace_back(std::move(tensor));
+  }
+  // objects, all the children of an object are loaded before it.
+  BinaryAttrReader attr_reader;
+  attr_reader.reader = &reader;
+  attr_reader.tensors = &tensors;
+  std::vector<ObjectPtr<Object>> nodes(1, nullptr);
+  attr_reader.nodes = &nodes;
+  size_t num_nodes = reader.ReadVarint();
+  nodes.reserve(num_nodes + 1);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    const std::string& type_key = type_keys.at(reader.ReadVarint());
+    uint64_t kind = reader.ReadVarint();
+    if (kind == kArray) {
+      std::vector<ObjectRef> elems(reader.ReadVarint());
+      for (ObjectRef& elem : elems) elem = ObjectRef(nodes.at(reader.ReadVarint()));
+      Array<ObjectRef> array(elems);
+      nodes.push_back(runtime::ObjectInternal::MoveObjectPtr(&array));
+    } else if (kind == kMap) {
+      std::unordered_map<ObjectRef, ObjectRef, ObjectHash, ObjectEqual> container;
+      size_t size = reader.ReadVarint();
+      for (size_t j = 0; j < size; ++j) {
+        ObjectRef key(nodes.at(reader.ReadVarint()));
+        container[key] = ObjectRef(nodes.at(reader.ReadVarint()));
+      }
+      Map<ObjectRef, ObjectRef> map(container);
+      nodes.push_back(runtime::ObjectInternal::MoveObjectPtr(&map));
+    } else if (kind == kReprBytes) {
+      nodes.push_back(reflection->CreateInitObject(type_key, reader.ReadString()));
+    } else {
+      CHECK_EQ(kind, kFields) << "Invalid object kind " << kind;
+      ObjectPtr<Object> node = reflection->CreateInitObject(type_key);
+      reflection->VisitAttrs(node.get(), &attr_reader);
+      nodes.push_back(std::move(node));
+    }
+  }
+  return ObjectRef(nodes.at(reader.ReadVarint()));
+}
+
+std::string SaveBinary(const ObjectRef& node) {
+  std::string blob;
+  dmlc::MemoryStringStream strm(&blob);
+  SaveBinary(&strm, node);
+  return blob;
+}
+
+ObjectRef LoadBinary(const std::string& blob) {
+  dmlc::MemoryFixedSizeStream strm(const_cast<char*>(blob.data()), blob.size());
+  return LoadBinary(&strm);
+}
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body([](runtime::TVMArgs args, runtime::TVMRetValue* rv) {
+  std::string blob = SaveBinary(args[0].operator ObjectRef());
+  TVMByteArray arr;
+  arr.data = blob.data();
+  arr.size = blob.size();
+  // The return value copies the bytes.
+  *rv = arr;
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body_typed([](std::string blob) {
+  return LoadBinary(blob);
+});
+
+TVM_REGISTER_GLOBAL("node.SaveBinaryToFile").set_body_typed([](ObjectRef node, std::string path) {
+  std::unique_ptr<dmlc::Stream> strm(dmlc::Stream::Create(path.c_str(), "w"));
+  SaveBinary(strm.get(), node);
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinaryFromFile").set_body_typed([](std::string path) {
+  std::unique_ptr<dmlc::Stream> strm(dmlc::Stream::Create(path.c_str(), "r"));
+  return LoadBinary(strm.get());
+});
+
+}  // namespace tvm
@@ -112,9 +112,24 @@ class WellFormedChecker : private ExprVisitor, PatternVisitor {
   void VisitExpr(const Expr& e) final {
     if (auto v = e.as<VarNode>()) {
       VisitExpr_(v);
-    } else {
-      ExprVisitor::VisitExpr(e);
+      return;
     }
+    // Dataflow nodes do not bind variables, visit nested ones iteratively.
+    // Every occurrence of a variable is checked against the current scope.
+    auto fcheck_visited = [this](const Expr& e) {
+      return e.as<VarNode>() == nullptr && visit_counter_.count(e.get()) != 0;
+    };
+    auto fvisit_leaf = [this](const Expr& e) {
+      if (auto v = e.as<VarNode>()) {
+        VisitExpr_(v);
+      } else if (e.as<CallNode>() || e.as<TupleNode>() || e.as<TupleGetItemNode>()) {
+        // The inputs were expanded by ExpandDataflow.
+        visit_counter_[e.get()]++;
+      } else {
+        ExprVisitor::VisitExpr(e);
+      }
+    };
+    ExpandDataflow(e, fcheck_visited, fvisit_leaf);
   }
 
  public:
@@ -0,0 +1,420 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file relay/backend/aot_codegen.cc
+ * \brief Ahead of time executor codegen.
+ *
+ *  Turns the graph produced by the graph runtime codegen into a C function that
+ *  calls each fused kernel directly. The tensors, the arguments of the kernels
+ *  and the storage of the activations are static, so running the model does not
+ *  look up functions, parse a graph or allocate memory.
+ */
+#include <dmlc/json.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../target/source/codegen_source_base.h"
+
+namespace tvm {
+namespace relay {
+namespace backend {
+
+/*! \brief The subset of the graph JSON the AOT codegen uses. */
+struct AotGraph {
+  struct NodeEntry {
+    uint32_t node_id;
+    uint32_t index;
+    void Load(dmlc::JSONReader* reader) {
+      uint32_t version;
+      reader->BeginArray();
+      CHECK(reader->NextArrayItem()) << "invalid json format";
+      reader->Read(&node_id);
+      CHECK(reader->NextArrayItem()) << "invalid json format";
+      reader->Read(&index);
+      if (reader->NextArrayItem()) {
+        reader->Read(&version);
+        CHECK(!reader->NextArrayItem()) << "invalid json format";
+      }
+    }
+  };
+  struct Node {
+    std::string op_type;
+    std::string name;
+    std::unordered_map<std::string, std::string> attrs;
+    std::vector<NodeEntry> inputs;
+    void Load(dmlc::JSONReader* reader) {
+      std::vector<uint32_t> control_deps;
+      reader->BeginObject();
+      std::string key;
+      while (reader->NextObjectItem(&key)) {
+        if (key == "op") {
+          reader->Read(&op_type);
+        } else if (key == "name") {
+          reader->Read(&name);
+        } else if (key == "inputs") {
+          reader->Read(&inputs);
+        } else if (key == "attr" || key == "attrs") {
+          reader->Read(&attrs);
+        } else if (key == "control_deps") {
+          reader->Read(&control_deps);
+        } else {
+          LOG(FATAL) << "do not support key " << key;
+        }
+      }
+    }
+  };
+
+  std::vector<Node> nodes;
+  std::vector<uint32_t> arg_nodes;
+  std::vector<uint32_t> node_row_ptr;
+  std::vector<NodeEntry> heads;
+  std::vector<int> storage_id;
+  std::vector<int> device_index;
+  std::vector<std::string> dltype;
+  std::vector<std::vector<int64_t>> shape;
+
+  template <typename T>
+  static void ReadAttr(dmlc::JSONReader* reader, const std::string& expected_type, T* value) {
+    std::string type;
+    reader->BeginArray();
+    CHECK(reader->NextArrayItem());
+    reader->Read(&type);
+    CHECK_EQ(type, expected_type);
+    CHECK(reader->NextArrayItem());
+    reader->Read(value);
+    CHECK(!reader->NextArrayItem());
+  }
+
+  void LoadAttrs(dmlc::JSONReader* reader) {
+    reader->BeginObject();
+    std::string key;
+    while (reader->NextObjectItem(&key)) {
+      if (key == "dltype") {
+        ReadAttr(reader, "list_str", &dltype);
+      } else if (key == "storage_id") {
+        ReadAttr(reader, "list_int", &storage_id);
+      } else if (key == "shape") {
+        ReadAttr(reader, "list_shape", &shape);
+      } else if (key == "device_index") {
+        ReadAttr(reader, "list_int", &device_index);
+      } else {
+        std::vector<int> temp;
+        ReadAttr(reader, "list_int", &temp);
+      }
+    }
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    reader->BeginObject();
+    std::string key;
+    while (reader->NextObjectItem(&key)) {
+      if (key == "nodes") {
+        reader->Read(&nodes);
+      } else if (key == "arg_nodes") {
+        reader->Read(&arg_nodes);
+      } else if (key == "node_row_ptr") {
+        reader->Read(&node_row_ptr);
+      } else if (key == "heads") {
+        reader->Read(&heads);
+      } else if (key == "attrs") {
+        LoadAttrs(reader);
+      } else {
+        LOG(FATAL) << "key " << key << " is not supported";
+      }
+    }
+    CHECK_EQ(storage_id.size(), node_row_ptr.back()) << "invalid format";
+    CHECK_EQ(dltype.size(), node_row_ptr.back()) << "invalid format";
+    CHECK_EQ(shape.size(), node_row_ptr.back()) << "invalid format";
+  }
+
+  uint32_t entry_id(const NodeEntry& e) const { return node_row_ptr[e.node_id] + e.index; }
+};
+
+/*! \brief Emit the C source of the AOT executor of a graph. */
+class AotCodegenC {
+ public:
+  AotCodegenC(const std::string& mod_name, int64_t alignment)
+      : mod_name_(mod_name), alignment_(alignment) {
+    CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0)
+        << "alignment must be a power of two";
+  }
+
+  std::string Generate(const std::string& graph_json,
+                       const Map<String, runtime::NDArray>& params) {
+    std::istringstream is(graph_json);
+    dmlc::JSONReader reader(&is);
+    graph_.Load(&reader);
+    CHECK(std::all_of(graph_.device_index.begin(), graph_.device_index.end(),
+                      [this](int dev) { return dev == graph_.device_index[0]; }))
+        << "The AOT executor does not support heterogeneous execution";
+
+    PlanEntries(params);
+    std::ostringstream decl, body;
+    EmitOps(decl, body);
+
+    std::ostringstream os;
+    os << "// AOT executor of " << mod_name_ << ", generated by relay.backend.aot.\n"
+       << "//\n"
+       << "// int32_t " << Prefix() << "run_model(void* const* inputs, void* const* outputs);\n"
+       << "//\n"
+       << "// Runs the model. The data of the inputs and outputs is contiguous, in this order:\n";
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      os << "//   inputs[" << i << "]: " << graph_.nodes[inputs_[i].second].name << ", "
+         << DescribeEntry(inputs_[i].first) << "\n";
+    }
+    for (size_t i = 0; i < outputs_.size(); ++i) {
+      os << "//   outputs[" << i << "]: " << DescribeEntry(outputs_[i]) << "\n";
+    }
+    os << "// It needs " << workspace_size_ << " bytes of static memory for the activations.\n\n"
+       << "#include <stdint.h>\n"
+       << "#include <string.h>\n"
+       << "#include <tvm/runtime/c_runtime_api.h>\n\n"
+       << "#ifdef __cplusplus\n"
+       << "extern \"C\" {\n"
+       << "#endif\n"
+       << decl.str() << "#ifdef __cplusplus\n"
+       << "}\n"
+       << "#endif\n\n";
+    EmitStorage(os);
+    EmitTensors(os, params);
+    os << body.str();
+    EmitRun(os);
+    return os.str();
+  }
+
+ private:
+  std::string Prefix() const { return mod_name_ + "_"; }
+
+  std::string DescribeEntry(uint32_t eid) const {
+    std::ostringstream os;
+    os << graph_.dltype[eid] << "[";
+    for (size_t i = 0; i < graph_.shape[eid].size(); ++i) {
+      os << (i ? ", " : "") << graph_.shape[eid][i];
+    }
+    os << "], " << EntryBytes(eid) << " bytes";
+    return os.str();
+  }
+
+  size_t EntryBytes(uint32_t eid) const {
+    DLDataType dtype = runtime::String2DLDataType(graph_.dltype[eid]);
+    size_t size = (dtype.bits * dtype.lanes + 7) / 8;
+    for (int64_t dim : graph_.shape[eid]) size *= dim;
+    return size;
+  }
+
+  // Assign the params and the offsets of the storages in the workspace.
+  void PlanEntries(const Map<String, runtime::NDArray>& params) {
+    for (uint32_t nid : graph_.arg_nodes) {
+      const std::string& name = graph_.nodes[nid].name;
+      uint32_t eid = graph_.node_row_ptr[nid];
+      if (params.count(name)) {
+        runtime::NDArray param = params[name];
+        CHECK_EQ(runtime::GetDataSize(*param.operator->()), EntryBytes(eid))
+            << "The param " << name << " does not match its shape";
+        param_names_[eid] = name;
+      } else {
+        inputs_.emplace_back(eid, nid);
+      }
+    }
+    for (const auto& head : graph_.heads) {
+      outputs_.push_back(graph_.entry_id(head));
+    }
+    // Storages only used by params take no space.
+    std::unordered_map<int, size_t> storage_size;
+    for (uint32_t eid = 0; eid < graph_.storage_id.size(); ++eid) {
+      if (param_names_.count(eid)) continue;
+      size_t& size = storage_size[graph_.storage_id[eid]];
+      size = std::max(size, EntryBytes(eid));
+    }
+    std::vector<int> sids;
+    for (const auto& kv : storage_size) sids.push_back(kv.first);
+    std::sort(sids.begin(), sids.end());
+    for (int sid : sids) {
+      storage_offset_[sid] = workspace_size_;
+      workspace_size_ += (storage_size[sid] + alignment_ - 1) / alignment_ * alignment_;
+    }
+  }
+
+  void EmitStorage(std::ostream& os) {
+    os << "static uint8_t " << Prefix() << "workspace[" << std::max<size_t>(workspace_size_, 1)
+       << "] __attribute__((aligned(" << alignment_ << ")));\n\n";
+  }
+
+  void EmitTensors(std::ostream& os, const Map<String, runtime::NDArray>& params) {
+    for (const auto& kv : param_names_) {
+      runtime::NDArray param = params[kv.second];
+      size_t nbytes = runtime::GetDataSize(*param.operator->());
+      std::vector<uint8_t> data(nbytes);
+      param.CopyToBytes(data.data(), nbytes);
+      os << "// " << kv.second << "\n"
+         << "static const uint8_t " << Prefix() << "param_" << kv.first << "["
+         << std::max<size_t>(nbytes, 1) << "] __attribute__((aligned(" << alignment_
+         << "))) = {";
+      for (size_t i = 0; i < nbytes; ++i) {
+        os << (i % 16 == 0 ? "\n    " : " ") << "0x" << std::hex << std::setw(2)
+           << std::setfill('0') << static_cast<int>(data[i]) << std::dec << ",";
+      }
+      os << "\n};\n";
+    }
+    uint32_t num_entries = graph_.node_row_ptr.back();
+    for (uint32_t eid = 0; eid < num_entries; ++eid) {
+      os << "static int64_t " << Prefix() << "shape_" << eid << "[] = {";
+      for (size_t i = 0; i < graph_.shape[eid].size(); ++i) {
+        os << (i ? ", " : "") << graph_.shape[eid][i];
+      }
+      // A scalar still needs a non empty array.
+      os << (graph_.shape[eid].empty() ? "0" : "") << "};\n";
+    }
+    os << "static DLTensor " << Prefix() << "tensors[" << num_entries << "] = {\n";
+    for (uint32_t eid = 0; eid < num_entries; ++eid) {
+      DLDataType dtype = runtime::String2DLDataType(graph_.dltype[eid]);
+      os << "    {";
+      if (param_names_.count(eid)) {
+        os << "(void*)" << Prefix() << "param_" << eid;
+      } else {
+        os << "(void*)(" << Prefix() << "workspace + " << storage_offset_.at(graph_.storage_id[eid])
+           << ")";
+      }
+      os << ", {kDLCPU, 0}, " << graph_.shape[eid].size() << ", {" << static_cast<int>(dtype.code)
+         << ", " << static_cast<int>(dtype.bits) << ", " << dtype.lanes << "}, " << Prefix()
+         << "shape_" << eid << ", NULL, 0},\n";
+    }
+    os << "};\n\n";
+  }
+
+  // Declare the kernels and emit the static arguments of each call.
+  void EmitOps(std::ostream& decl, std::ostream& os) {
+    std::unordered_set<std::string> declared;
+    size_t max_args = 0;
+    for (uint32_t nid = 0; nid < graph_.nodes.size(); ++nid) {
+      const auto& node = graph_.nodes[nid];
+      if (node.op_type == "null") continue;
+      CHECK_EQ(node.op_type, "tvm_op") << "Can only take tvm_op as op, but " << node.op_type
+                                       << " is found";
+      const std::string& func_name = node.attrs.at("func_name");
+      if (func_name == "__nop") continue;
+      CHECK_NE(func_name, "__copy") << "The AOT executor does not support __copy";
+      auto flatten_data = node.attrs.find("flatten_data");
+      CHECK(flatten_data == node.attrs.end() || std::stoi(flatten_data->second) == 0)
+          << "The AOT executor does not support flatten_data";
+      std::vector<uint32_t> args;
+      for (const auto& e : node.inputs) args.push_back(graph_.entry_id(e));
+      int num_outputs = std::stoi(node.attrs.at("num_outputs"));
+      for (int i = 0; i < num_outputs; ++i) args.push_back(graph_.node_row_ptr[nid] + i);
+
+      if (declared.insert(func_name).second) {
+        decl << "TVM_DLL int32_t " << func_name
+             << "(void* args, void* arg_type_ids, int32_t num_args, void* out_ret_value,\n"
+             << "    void* out_ret_tcode, void* resource_handle);\n";
+      }
+      size_t index = calls_.size();
+      os << "static TVMValue " << Prefix() << "args_" << index << "[" << args.size() << "];\n";
+      calls_.push_back({func_name, args});
+      max_args = std::max(max_args, args.size());
+    }
+    if (max_args != 0) {
+      os << "static int32_t " << Prefix() << "arg_type_codes[" << max_args << "] = {";
+      for (size_t i = 0; i < max_args; ++i) os << (i ? ", " : "") << "kTVMDLTensorHandle";
+      os << "};\n\n";
+    }
+  }
+
+  void EmitRun(std::ostream& os) {
+    // C and C++ cannot statically initialize the handle of a TVMValue,
+    // so the arguments are filled once on the first run.
+    os << "static void " << Prefix() << "init_args(void) {\n";
+    for (size_t i = 0; i < calls_.size(); ++i) {
+      for (size_t j = 0; j < calls_[i].args.size(); ++j) {
+        os << "  " << Prefix() << "args_" << i << "[" << j << "].v_handle = &" << Prefix()
+           << "tensors[" << calls_[i].args[j] << "];\n";
+      }
+    }
+    os << "}\n\n";
+    os << "#ifdef __cplusplus\n"
+       << "extern \"C\"\n"
+       << "#endif\n"
+       << "TVM_DLL int32_t " << Prefix()
+       << "run_model(void* const* inputs, void* const* outputs) {\n"
+       << "  static int initialized = 0;\n"
+       << "  TVMValue ret_value;\n"
+       << "  int32_t ret_type_code;\n"
+       << "  int32_t status;\n"
+       << "  if (!initialized) {\n"
+       << "    " << Prefix() << "init_args();\n"
+       << "    initialized = 1;\n"
+       << "  }\n";
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      os << "  memcpy(" << Prefix() << "tensors[" << inputs_[i].first << "].data, inputs[" << i
+         << "], " << EntryBytes(inputs_[i].first) << ");\n";
+    }
+    for (size_t i = 0; i < calls_.size(); ++i) {
+      os << "  status = " << calls_[i].func_name << "(" << Prefix() << "args_" << i << ", "
+         << Prefix() << "arg_type_codes, " << calls_[i].args.size()
+         << ", &ret_value, &ret_type_code, NULL);\n"
+         << "  if (status != 0) return status;\n";
+    }
+    for (size_t i = 0; i < outputs_.size(); ++i) {
+      os << "  memcpy(outputs[" << i << "], " << Prefix() << "tensors[" << outputs_[i]
+         << "].data, " << EntryBytes(outputs_[i]) << ");\n";
+    }
+    os << "  return 0;\n"
+       << "}\n";
+  }
+
+  struct Call {
+    std::string func_name;
+    std::vector<uint32_t> args;
+  };
+
+  std::string mod_name_;
+  int64_t alignment_;
+  AotGraph graph_;
+  /*! \brief The entry and node ids of the inputs. */
+  std::vector<std::pair<uint32_t, uint32_t>> inputs_;
+  std::vector<uint32_t> outputs_;
+  /*! \brief The name of the param of each param entry, ordered for a stable output. */
+  std::map<uint32_t, std::string> param_names_;
+  std::unordered_map<int, size_t> storage_offset_;
+  size_t workspace_size_{0};
+  std::vector<Call> calls_;
+};
+
+runtime::Module AotCodegen(const String& graph_json, const Map<String, runtime::NDArray>& params,
+                           const String& mod_name, int64_t alignment) {
+  std::string code = AotCodegenC(mod_name, alignment).Generate(graph_json, params);
+  return codegen::CSourceModuleCreate(code, "c");
+}
+
+TVM_REGISTER_GLOBAL("relay.backend._AotCodegen").set_body_typed(AotCodegen);
+
+}  // namespace backend
+}  // namespace relay
+}  // namespace tvm
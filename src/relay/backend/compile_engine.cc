@@ -614,12 +614,17 @@ class CompileEngineImpl : public CompileEngineNode {
     // No need to cache external functions as we collected them all to create
     // external runtime modules.
     for (const auto& it : cached_ext_funcs) {
+      func_hash_memo_.erase(it->source_func);
       cache_.erase(it);
     }
     return ret;
   }
 
-  void Clear() final { cache_.clear(); }
+  void Clear() final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    func_hash_memo_.clear();
+  }
   // List all items in the cache.
   Array<ObjectRef> ListItems() {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -646,6 +651,7 @@ class CompileEngineImpl : public CompileEngineNode {
   CCacheValue LowerInternal(const CCacheKey& key) {
     std::lock_guard<std::mutex> lock(mutex_);
     CCacheValue value;
+    ReuseFuncHash(key);
     auto it = cache_.find(key);
     if (it != cache_.end()) {
       it->second->use_count += 1;
@@ -655,6 +661,7 @@ class CompileEngineImpl : public CompileEngineNode {
       value = CCacheValue(make_object<CCacheValueNode>());
       value->use_count = 0;
       cache_[key] = value;
+      func_hash_memo_[key->source_func] = key->FuncHash();
     }
     // No need to lower external functions for now. We will invoke the external
     // codegen tool once and lower all functions together.
@@ -707,6 +714,7 @@ class CompileEngineImpl : public CompileEngineNode {
   CCacheValue LowerShapeFuncInternal(const CCacheKey& key) {
     std::lock_guard<std::mutex> lock(mutex_);
     CCacheValue value;
+    ReuseFuncHash(key);
     auto it = shape_func_cache_.find(key);
     if (it != shape_func_cache_.end()) {
       it->second->use_count += 1;
@@ -716,6 +724,7 @@ class CompileEngineImpl : public CompileEngineNode {
       value = CCacheValue(make_object<CCacheValueNode>());
       value->use_count = 0;
       shape_func_cache_[key] = value;
+      func_hash_memo_[key->source_func] = key->FuncHash();
     }
     // Enforce use the target.
     With<Target> target_scope(key->target);
@@ -739,6 +748,16 @@ class CompileEngineImpl : public CompileEngineNode {
     value->cached_func = CachedFunc(cache_node);
     return value;
   }
+  /*!
+   * \brief Reuse the hash of a source function that is already a key of the caches.
+   *  Callers create a new key for the same function on every lookup, and the
+   *  structural hash of a large function is O(n).
+   * \param key The key to look up.
+   */
+  void ReuseFuncHash(const CCacheKey& key) {
+    auto it = func_hash_memo_.find(key->source_func);
+    if (it != func_hash_memo_.end()) key->SetFuncHash(it->second);
+  }
   /*!
    * \brief Get unique name from name.
    * \param name The orginal name.
@@ -770,6 +789,11 @@ class CompileEngineImpl : public CompileEngineNode {
   std::unordered_map<CCacheKey, CCacheValue> cache_;
   /*! \brief internal compiler cache for shape funcs */
   std::unordered_map<CCacheKey, CCacheValue> shape_func_cache_;
+  /*!
+   * \brief The structural hash of the source function of each cache key, by identity.
+   *  It only refers to functions held by the caches and is cleared with them.
+   */
+  std::unordered_map<Function, size_t, ObjectPtrHash, ObjectPtrEqual> func_hash_memo_;
 };
 
 /*! \brief The global compile engine */
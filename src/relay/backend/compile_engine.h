@@ -121,6 +121,13 @@ class CCacheKeyNode : public Object {
   }
   /*! \return The hash value of CCacheKey. */
   inline size_t Hash() const;
+  /*! \return The structural hash of the source function. */
+  inline size_t FuncHash() const;
+  /*!
+   * \brief Use a known structural hash of the source function instead of computing it.
+   * \param func_hash The structural hash of source_func.
+   */
+  void SetFuncHash(size_t func_hash) const { func_hash_ = func_hash; }
   /*!
    * \brief check content equality
    * \param other The other value.
@@ -136,6 +143,10 @@ class CCacheKeyNode : public Object {
    * \brief internal cached hash value.
    */
   mutable size_t hash_{0};
+  /*!
+   * \brief internal cached hash value of the source function.
+   */
+  mutable size_t func_hash_{0};
 };
 
 /*! \brief cache entry used in compile engine */
@@ -249,11 +260,18 @@ class CompileEngine : public ObjectRef {
 bool IsDynamic(const Type& ty);
 
 // implementations
+inline size_t CCacheKeyNode::FuncHash() const {
+  if (func_hash_ != 0) return func_hash_;
+  // do structral hash, avoid 0.
+  func_hash_ = tvm::StructuralHash()(this->source_func);
+  if (func_hash_ == 0) func_hash_ = 1;
+  return func_hash_;
+}
+
 inline size_t CCacheKeyNode::Hash() const {
   if (hash_ != 0) return hash_;
-  // do structral hash, avoid 0.
-  hash_ = tvm::StructuralHash()(this->source_func);
-  hash_ = dmlc::HashCombine(hash_, std::hash<std::string>()(target->str()));
+  // avoid 0.
+  hash_ = dmlc::HashCombine(FuncHash(), std::hash<std::string>()(target->str()));
   if (hash_ == 0) hash_ = 1;
   return hash_;
 }
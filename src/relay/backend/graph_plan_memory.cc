@@ -22,9 +22,12 @@
  * \brief Memory index assignment pass for executing
  *   the program in the graph runtime.
  */
+#include <tvm/ir/transform.h>
+#include <tvm/node/structural_equal.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
 #include <tvm/tir/op.h>
 
 #include "../../support/arena.h"
@@ -34,6 +37,9 @@ namespace relay {
 
 using IntegerArray = Array<Integer>;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.GraphPlanMemory.inplace", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.GraphPlanMemory.reuse_small_blocks", Bool);
+
 struct StorageToken {
   /*! \brief Reference counter */
   int ref_counter{0};
@@ -46,6 +52,8 @@ struct StorageToken {
   int device_type{0};
   /*! \brief The storage id */
   int64_t storage_id{-1};
+  /*! \brief Whether the storage holds intermediate results that can be reused. */
+  bool can_realloc{false};
 };
 
 class StorageAllocaBaseVisitor : public ExprVisitor {
@@ -196,8 +204,38 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     return total;
   }
 
+  /*!
+   * \return total number of bytes allocated for intermediate results,
+   *  excluding parameters and constants.
+   */
+  size_t ActivationAllocBytes() const {
+    size_t total = 0;
+    for (const auto* p : data_) {
+      if (p->can_realloc) total += p->max_bytes;
+    }
+    return total;
+  }
+
+  /*!
+   * \return The peak number of bytes of intermediate results alive at the same
+   *  time. It is a lower bound only for the execution order of this planner
+   *  and its in-place decisions: another topological order of the graph can
+   *  have a lower peak.
+   */
+  size_t PeakLiveBytes() const { return peak_live_bytes_; }
+
+  /*! \return The number of storage entries. */
+  size_t NumStorage() const { return data_.size(); }
+
   // Run storage allocation for a function.
   Map<Expr, Array<IntegerArray> > Plan(const Function& func) {
+    enable_inplace_ = transform::PassContext::Current()
+                          ->GetConfig<Bool>("relay.GraphPlanMemory.inplace", Bool(false))
+                          .value();
+    reuse_small_blocks_ =
+        transform::PassContext::Current()
+            ->GetConfig<Bool>("relay.GraphPlanMemory.reuse_small_blocks", Bool(false))
+            .value();
     prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
     this->Run(func);
 
@@ -239,7 +277,12 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     std::vector<StorageToken*> tokens;
     for (StorageToken* tok : it->second) {
       if (can_realloc) {
-        tokens.push_back(Request(tok));
+        StorageToken* allocated_tok = Request(tok);
+        allocated_tok->can_realloc = true;
+        size_t size = GetMemorySize(tok);
+        live_bytes_[allocated_tok] = size;
+        curr_live_bytes_ += size;
+        tokens.push_back(allocated_tok);
       } else {
         // Allocate a new token,
         StorageToken* allocated_tok = Alloc(tok, GetMemorySize(tok));
@@ -260,8 +303,18 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
         args.push_back(tok);
       }
     }
-    // create token for the call node.
-    CreateToken(op, true);
+    StorageToken* inplace_tok = enable_inplace_ ? FindInplaceToken(op) : nullptr;
+    if (inplace_tok != nullptr) {
+      // The output takes over the storage of an input that dies here. The
+      // extra reference is dropped together with the other arguments below.
+      CHECK(!token_map_.count(op));
+      inplace_tok->ref_counter = prototype_.at(op)[0]->ref_counter + 1;
+      token_map_[op] = {inplace_tok};
+    } else {
+      // create token for the call node.
+      CreateToken(op, true);
+    }
+    peak_live_bytes_ = std::max(peak_live_bytes_, curr_live_bytes_);
     // check if there is orphaned output that can be released immediately.
     for (StorageToken* tok : token_map_.at(op)) {
       CheckForRelease(tok);
@@ -271,6 +324,56 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
       CheckForRelease(tok);
     }
   }
+  /*!
+   * \brief Check whether a primitive function only contains element-wise and
+   *  broadcast operators, so that each output element only depends on the
+   *  element at the same index of any input with the output's type.
+   * \param func The primitive function.
+   */
+  static bool IsElemwiseFunction(const FunctionNode* func) {
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    bool elemwise = true;
+    PostOrderVisit(func->body, [&elemwise](const Expr& expr) {
+      if (const auto* call = expr.as<CallNode>()) {
+        const auto* op = call->op.as<OpNode>();
+        if (op == nullptr || fpattern.get(GetRef<Op>(op), kOpaque) > kBroadcast) {
+          elemwise = false;
+        }
+      } else if (!expr->IsInstance<VarNode>() && !expr->IsInstance<ConstantNode>() &&
+                 !expr->IsInstance<OpNode>()) {
+        elemwise = false;
+      }
+    });
+    return elemwise;
+  }
+  /*!
+   * \brief Find an input token whose storage the call can write its output to.
+   * \param op The call node.
+   * \return The token, or nullptr if the call cannot run in place.
+   */
+  StorageToken* FindInplaceToken(const CallNode* op) {
+    const auto* func = op->op.as<FunctionNode>();
+    if (func == nullptr || !func->HasNonzeroAttr(attr::kPrimitive) ||
+        func->GetAttr<String>(attr::kCompiler).defined()) {
+      return nullptr;
+    }
+    if (!op->checked_type()->IsInstance<TensorTypeNode>() || !IsElemwiseFunction(func)) {
+      return nullptr;
+    }
+    const StorageToken* proto = prototype_.at(op)[0];
+    for (const Expr& arg : op->args) {
+      const auto& tokens = token_map_.at(arg.operator->());
+      if (tokens.size() != 1) continue;
+      StorageToken* tok = tokens[0];
+      // The input must die at this call and live on the same device.
+      if (tok->ref_counter != 1 || !tok->can_realloc || tok->device_type != proto->device_type) {
+        continue;
+      }
+      if (!StructuralEqual()(arg->checked_type(), op->checked_type())) continue;
+      return tok;
+    }
+    return nullptr;
+  }
   /*!
    * \brief ceil(size/word_size) to get number of words.
    * \param size The original size.
@@ -305,11 +408,12 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   StorageToken* Request(StorageToken* prototype) {
     // calculate the size;
     size_t size = GetMemorySize(prototype);
-    // search memory block in [size / match_range_, size * match_range_)
+    // search memory block in [size / match_range_, size * match_range_),
+    // or in [0, size * match_range_) when small blocks may be reused.
     if (match_range_ == 0) {
       return this->Alloc(prototype, size);
     }
-    auto begin = free_.lower_bound(size / match_range_);
+    auto begin = reuse_small_blocks_ ? free_.begin() : free_.lower_bound(size / match_range_);
     auto mid = free_.lower_bound(size);
     auto end = free_.upper_bound(size * match_range_);
     // search for memory blocks larger than requested
@@ -324,7 +428,8 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
       free_.erase(it);
       return tok;
     }
-    // then search for memory blocks smaller than requested space
+    // then search for memory blocks smaller than requested space. Growing the
+    // largest of them never costs more than allocating a new block.
     for (auto it = mid; it != begin;) {
       --it;
       StorageToken* tok = it->second;
@@ -360,6 +465,11 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     CHECK_GE(tok->ref_counter, 0);
     if (tok->ref_counter == 0) {
       free_.insert({tok->max_bytes, tok});
+      auto it = live_bytes_.find(tok);
+      if (it != live_bytes_.end()) {
+        curr_live_bytes_ -= it->second;
+        live_bytes_.erase(it);
+      }
     }
   }
 
@@ -374,13 +484,53 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   std::vector<StorageToken*> data_;
   /*! \brief internal prototype token map */
   std::unordered_map<const ExprNode*, std::vector<StorageToken*> > prototype_;
+  /*! \brief Whether outputs of element-wise calls may reuse a dying input. */
+  bool enable_inplace_{false};
+  /*! \brief Whether free blocks below size / match_range_ may be grown for a request. */
+  bool reuse_small_blocks_{false};
+  /*! \brief Size of the tensor currently held by each live intermediate token. */
+  std::unordered_map<const StorageToken*, size_t> live_bytes_;
+  /*! \brief Total bytes of live intermediate tensors. */
+  size_t curr_live_bytes_{0};
+  /*! \brief Maximum of curr_live_bytes_ over the execution. */
+  size_t peak_live_bytes_{0};
 };
 
 Map<Expr, Array<IntegerArray> > GraphPlanMemory(const Function& func) {
   return StorageAllocator().Plan(func);
 }
 
+/*!
+ * \brief Summarize the memory plan of a function.
+ *
+ *  The planner reuses whole storage entries. The graph runtime can share the
+ *  bytes of entries with disjoint lifetimes when it places them in a storage
+ *  arena, which can bring the arena below activation_bytes.
+ *
+ * \param func The function.
+ * \return The number of storage entries, the bytes planned for intermediate
+ *  results and the peak bytes of simultaneously live intermediate results.
+ *  The peak is a lower bound only for the execution order of the graph
+ *  runtime, which follows the post order of the function, and for the same
+ *  in-place decisions.
+ */
+Map<String, Integer> GraphPlanMemoryStats(const Function& func) {
+  StorageAllocator allocator;
+  allocator.Plan(func);
+  auto as_integer = [](size_t value) {
+    return Integer(IntImm(DataType::Int(64), static_cast<int64_t>(value)));
+  };
+  Map<String, Integer> stats;
+  stats.Set("num_storage", as_integer(allocator.NumStorage()));
+  stats.Set("total_bytes", as_integer(allocator.TotalAllocBytes()));
+  stats.Set("activation_bytes", as_integer(allocator.ActivationAllocBytes()));
+  stats.Set("peak_live_bytes", as_integer(allocator.PeakLiveBytes()));
+  return stats;
+}
+
 TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory").set_body_typed(GraphPlanMemory);
 
+TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemoryStats").set_body_typed(GraphPlanMemoryStats);
+
 }  // namespace relay
 }  // namespace tvm
@@ -29,78 +29,8 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/pattern_functor.h>
 
-#include <stack>
-
 namespace tvm {
 namespace relay {
-/*!
- * \brief A function to iteratively traverse dataflow regions of a graph
- *
- * ExpandDataflow manually manages a stack and performs DFS to determine the processing
- * order of nodes in an input graph.
- *
- * If it finds a dataflow node (Call, Tuple, TupleGetItem), it checks if the arguments to that node
- * need to be processed via fcheck_visited. If so, the function pushes those arguments to the stack
- * and continues iteratively to process the top of the stack. When it finds a node that doesn't
- * match the dataflow types, or a node who's inputs have all been processed, it visits the current
- * leaf via fvisit_leaf.
- *
- * This function should be used internally to other classes to implement mixed-mode traversals. The
- * expectation is that fvisit_leaf will perform recursive analysis within mixed-mode traversal if it
- * hits a non-dataflow node.
- *
- * fcheck_visited and fvisit_leaf are templated to encourage compiler inlining.
- */
-template <typename FCheckVisited, typename FVisitLeaf>
-void ExpandDataflow(Expr expr, FCheckVisited fcheck_visited, FVisitLeaf fvisit_leaf) {
-  std::stack<std::pair<Expr, bool>> stack;
-  auto fpush_to_stack = [&fcheck_visited, &stack](const Expr& expr) {
-    // The second state of the stack indicate whether the child has been
-    // expanded in the pre-order.
-    // NOTE: function will be inlined.
-    if (!fcheck_visited(expr)) {
-      stack.push({expr, false});
-    }
-  };
-  fpush_to_stack(expr);
-  while (stack.size() > 0) {
-    auto node = stack.top().first;
-    if (fcheck_visited(node)) {
-      // if this node was visited through another path
-      // after being added to the stack ignore it.
-      stack.pop();
-    } else if (stack.top().second) {
-      // all the children have already been expanded.
-      // we can just run post order visit on it.
-      fvisit_leaf(node);
-      stack.pop();
-    } else if (const CallNode* op = node.as<CallNode>()) {
-      // mark expanded = true
-      stack.top().second = true;
-      // push the children to the stack in reverse order
-      // to match recursive processing order
-      for (auto it = op->args.rbegin(); it != op->args.rend(); ++it) {
-        fpush_to_stack(*it);
-      }
-      fpush_to_stack(op->op);
-    } else if (const TupleNode* op = node.as<TupleNode>()) {
-      stack.top().second = true;
-      // push the children to the stack in reverse order
-      // to match recursive processing order
-      for (auto it = op->fields.rbegin(); it != op->fields.rend(); ++it) {
-        fpush_to_stack(*it);
-      }
-    } else if (const TupleGetItemNode* op = node.as<TupleGetItemNode>()) {
-      stack.top().second = true;
-      fpush_to_stack(op->tuple);
-    } else {
-      // No need to expand the children directly run visit.
-      fvisit_leaf(node);
-      stack.pop();
-    }
-  }
-}
-
 MixedModeVisitor::MixedModeVisitor(int visit_limit) {
   CHECK(visit_limit > 0) << "Dataflow visit limit must be greater than 0";
   CHECK(visit_limit < 10) << "Dataflow visit limit must be less than 10";
@@ -143,29 +73,23 @@ void MixedModeVisitor::VisitExpr_(const TupleGetItemNode* op) {}
 void MixedModeMutator::VisitLeaf(const Expr& expr) {
   if (!memo_.count(expr)) {
     Expr ret = this->DispatchVisitExpr(expr);
-    memo_[expr] = ret;
+    memo_[expr] = std::move(ret);
   }
 }
 
-bool MixedModeMutator::CheckVisited(const Expr& expr) {
-  if (memo_.count(expr)) {
-    return true;
-  } else {
-    return false;
-  }
-}
+bool MixedModeMutator::CheckVisited(const Expr& expr) { return memo_.count(expr) != 0; }
 
 Expr MixedModeMutator::DispatchVisitExpr(const Expr& expr) { return ExprMutator::VisitExpr(expr); }
 
 Expr MixedModeMutator::VisitExpr(const Expr& expr) {
+  auto it = memo_.find(expr);
+  if (it != memo_.end()) {
+    return it->second;
+  }
   auto fcheck_visited = [this](const Expr& expr) { return this->CheckVisited(expr); };
   auto fvisit_leaf = [this](const Expr& expr) { return this->VisitLeaf(expr); };
-  if (memo_.count(expr)) {
-    return memo_[expr];
-  } else {
-    ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
-    return memo_[expr];
-  }
+  ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+  return memo_.at(expr);
 }
 
 class PostOrderRewriter : public MixedModeMutator {
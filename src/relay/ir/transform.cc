@@ -23,9 +23,12 @@
  */
 #include <dmlc/thread_local.h>
 #include <tvm/node/repr_printer.h>
+#include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/registry.h>
 
+#include <unordered_set>
+
 namespace tvm {
 namespace relay {
 namespace transform {
@@ -131,8 +134,49 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
     }
   }
 
+  // With incremental type inference, an unchanged function keeps the type it was checked
+  // with in this module. That type also depends on the types of the globals it calls,
+  // which can change when the pass rewrites them, so every function that calls a
+  // rewritten function, directly or through other functions, is checked again.
+  bool incremental =
+      pass_ctx->GetConfig<Bool>("relay.InferType.incremental", Bool(false)).value();
+  std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> recheck;
+  std::vector<std::pair<size_t, std::vector<GlobalVar>>> kept;
+  for (size_t i = 0; i < updates.size(); ++i) {
+    const auto& pair = updates[i];
+    if (!incremental || !pair.second.same_as(mod->Lookup(pair.first)) ||
+        !pair.second->checked_type_.defined()) {
+      recheck.insert(pair.first);
+      continue;
+    }
+    std::vector<GlobalVar> callees;
+    PostOrderVisit(pair.second, [&callees](const Expr& expr) {
+      if (auto* gvar = expr.as<GlobalVarNode>()) callees.push_back(GetRef<GlobalVar>(gvar));
+    });
+    kept.push_back({i, std::move(callees)});
+  }
+  for (bool updated = true; updated;) {
+    updated = false;
+    for (const auto& entry : kept) {
+      const GlobalVar& gvar = updates[entry.first].first;
+      if (recheck.count(gvar)) continue;
+      for (const GlobalVar& callee : entry.second) {
+        if (recheck.count(callee)) {
+          recheck.insert(gvar);
+          updated = true;
+          break;
+        }
+      }
+    }
+  }
+
   for (const auto& pair : updates) {
-    updated_mod->Add(pair.first, pair.second, true);
+    if (recheck.count(pair.first)) {
+      updated_mod->Add(pair.first, pair.second, true);
+    } else {
+      pair.first->checked_type_ = pair.second->checked_type_;
+      updated_mod->AddUnchecked(pair.first, pair.second);
+    }
   }
   pass_ctx.Trace(updated_mod, pass_info, false);
   return updated_mod;
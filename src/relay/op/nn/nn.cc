@@ -158,6 +158,19 @@ Useful for
 // relay.nn.dense
 TVM_REGISTER_NODE_TYPE(DenseAttrs);
 
+Array<Array<Layout>> DenseInferCorrectLayout(const Attrs& attrs,
+                                             const Array<Layout>& new_in_layouts,
+                                             const Array<Layout>& old_in_layouts,
+                                             const Array<tvm::relay::Type>& old_in_types) {
+  // Only 2-D dense takes part in the layout rewrite, so that its weight can be
+  // packed by the alter op layout. Other ranks keep their inputs untouched.
+  const auto* data = old_in_types[0].as<TensorTypeNode>();
+  if (data == nullptr || data->shape.size() != 2) {
+    return Array<Array<Layout>>{{Layout::Undef(), Layout::Undef()}, {Layout::Undef()}};
+  }
+  return Array<Array<Layout>>{{Layout("NC"), Layout("NC")}, {Layout("NC")}};
+}
+
 // Positional relay function to create dense operator used by frontend FFI.
 Expr MakeDense(Expr data, Expr weight, IndexExpr units, DataType out_dtype) {
   auto attrs = make_object<DenseAttrs>();
@@ -182,8 +195,79 @@ RELAY_REGISTER_OP("nn.dense")
     .add_argument("data", "nD Tensor", "Input data.")
     .add_argument("weight", "2D Tensor", "Weight matrix.")
     .set_support_level(1)
+    .set_attr<FInferCorrectLayout>("FInferCorrectLayout", DenseInferCorrectLayout)
     .add_type_rel("Dense", DenseRel<DenseAttrs>);
 
+// relay.nn.contrib_dense_pack
+TVM_REGISTER_NODE_TYPE(DensePackAttrs);
+
+bool DensePackRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                  const TypeReporter& reporter) {
+  CHECK_EQ(types.size(), 3);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* weight = types[1].as<TensorTypeNode>();
+  if (data == nullptr || weight == nullptr) return false;
+
+  const DensePackAttrs* param = attrs.as<DensePackAttrs>();
+  CHECK(param != nullptr);
+
+  CHECK_EQ(data->shape.size(), 2) << "DensePackRel: only 2-D data is supported";
+  CHECK_EQ(weight->shape.size(), 4)
+      << "DensePackRel: weight should be packed in " << param->weight_layout
+      << ", got shape " << weight->shape;
+  CHECK(reporter->AssertEQ(data->shape[1], weight->shape[1] * weight->shape[3]))
+      << "DensePackRel: input dimension doesn't match,"
+      << " data shape=" << data->shape << ", weight shape=" << weight->shape;
+
+  Array<IndexExpr> oshape({data->shape[0], weight->shape[0] * weight->shape[2]});
+  DataType out_dtype = param->out_dtype;
+  if (out_dtype.bits() == 0) {
+    out_dtype = data->dtype;
+  }
+  // assign output type
+  reporter->Assign(types[2], TensorType(oshape, out_dtype));
+  return true;
+}
+
+Array<Array<Layout>> DensePackInferCorrectLayout(const Attrs& attrs,
+                                                 const Array<Layout>& new_in_layouts,
+                                                 const Array<Layout>& old_in_layouts,
+                                                 const Array<tvm::relay::Type>& old_in_types) {
+  const DensePackAttrs* param = attrs.as<DensePackAttrs>();
+  CHECK(param != nullptr);
+  return Array<Array<Layout>>{{Layout("NC"), Layout(param->weight_layout)}, {Layout("NC")}};
+}
+
+// Positional relay function to create dense_pack operator used by frontend FFI.
+Expr MakeDensePack(Expr data, Expr weight, std::string weight_layout, DataType out_dtype) {
+  auto attrs = make_object<DensePackAttrs>();
+  attrs->weight_layout = std::move(weight_layout);
+  attrs->out_dtype = out_dtype;
+  static const Op& op = Op::Get("nn.contrib_dense_pack");
+  return Call(op, {data, weight}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.contrib_dense_pack").set_body_typed(MakeDensePack);
+
+RELAY_REGISTER_OP("nn.contrib_dense_pack")
+    .describe(R"code(Applies a linear transformation: :math:`Y = XW^T` with a packed weight.
+
+This operator is produced by the alter op layout of dense, which packs the
+weight once in the graph instead of in every call of the kernel.
+
+- **data**: `(batch, input_dim)`
+- **weight**: `(units // lanes, input_dim // 4, lanes, 4)` in layout `NC{lanes}n4c`
+- **out**: `(batch, units)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<DensePackAttrs>()
+    .set_num_inputs(2)
+    .add_argument("data", "2D Tensor", "Input data.")
+    .add_argument("weight", "4D Tensor", "Packed weight matrix.")
+    .set_support_level(10)
+    .set_attr<FInferCorrectLayout>("FInferCorrectLayout", DensePackInferCorrectLayout)
+    .add_type_rel("DensePack", DensePackRel);
+
 // relay.leaky_relu
 TVM_REGISTER_NODE_TYPE(LeakyReluAttrs);
 
@@ -19,7 +19,7 @@
 
 /*!
  * \file sparse.cc
- * \brief Property def of nn.sparse_dense operator.
+ * \brief Property def of the nn.sparse_dense and nn.sparse_conv2d operators.
  */
 
 #include <tvm/relay/attrs/nn.h>
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "../../transforms/infer_layout_util.h"
+#include "../op_common.h"
 
 namespace tvm {
 namespace relay {
@@ -92,6 +93,78 @@ RELAY_REGISTER_OP("nn.sparse_dense")
     .set_support_level(1)
     .add_type_rel("SparseDense", SparseDenseRel);
 
+// relay.nn.sparse_conv2d
+TVM_REGISTER_NODE_TYPE(SparseConv2DAttrs);
+
+bool SparseConv2DRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                     const TypeReporter& reporter) {
+  CHECK_EQ(types.size(), 5);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* weight_data = types[1].as<TensorTypeNode>();
+  const auto* weight_indptr = types[3].as<TensorTypeNode>();
+  if (data == nullptr || weight_data == nullptr || weight_indptr == nullptr) return false;
+  const auto* param = attrs.as<SparseConv2DAttrs>();
+  CHECK(param != nullptr);
+  CHECK_EQ(param->layout, "NHWC") << "nn.sparse_conv2d only supports NHWC, not "
+                                  << param->layout;
+  CHECK_EQ(data->shape.size(), 4) << "nn.sparse_conv2d expects 4-D data";
+  CHECK_EQ(param->kernel_size.size(), 2);
+  CHECK_EQ(param->strides.size(), 2);
+
+  IndexExpr pad_h, pad_w;
+  GetPaddingHeightWidth(param->padding, &pad_h, &pad_w);
+  IndexExpr out_height =
+      indexdiv(data->shape[1] + pad_h - param->kernel_size[0], param->strides[0]) + 1;
+  IndexExpr out_width =
+      indexdiv(data->shape[2] + pad_w - param->kernel_size[1], param->strides[1]) + 1;
+  IndexExpr out_channel;
+  if (weight_data->shape.size() == 1) {
+    // CSR case.
+    out_channel = weight_indptr->shape[0] - 1;
+  } else if (weight_data->shape.size() == 3) {
+    // BSR case.
+    out_channel = (weight_indptr->shape[0] - 1) * weight_data->shape[1];
+  } else {
+    LOG(FATAL) << "Unknown weight ndim for nn.sparse_conv2d, should be 1 (CSR) or 3 (BSR)";
+  }
+  Array<IndexExpr> oshape({data->shape[0], out_height, out_width, out_channel});
+  reporter->Assign(types[4], TensorType(oshape, data->dtype));
+  return true;
+}
+
+Expr MakeSparseConv2D(Expr data, Expr weight_data, Expr weight_indices, Expr weight_indptr,
+                      Array<IndexExpr> kernel_size, Array<IndexExpr> strides,
+                      Array<IndexExpr> padding, String layout) {
+  auto attrs = make_object<SparseConv2DAttrs>();
+  attrs->kernel_size = std::move(kernel_size);
+  attrs->strides = std::move(strides);
+  attrs->padding = std::move(padding);
+  attrs->layout = std::move(layout);
+  static const Op& op = Op::Get("nn.sparse_conv2d");
+  return Call(op, {data, weight_data, weight_indices, weight_indptr}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.sparse_conv2d").set_body_typed(MakeSparseConv2D);
+
+RELAY_REGISTER_OP("nn.sparse_conv2d")
+    .describe(R"code(Applies a 2-D convolution with a sparse weight.
+
+The weight is the CSR or BSR matrix of the HWIO kernel reshaped to
+(kernel_h * kernel_w * in_channel, out_channel) and transposed.
+
+- **data**: `(batch, in_height, in_width, in_channel)`
+- **out**: `(batch, out_height, out_width, out_channel)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<SparseConv2DAttrs>()
+    .set_num_inputs(4)
+    .add_argument("data", "4D Tensor", "Input data.")
+    .add_argument("weight_data", "1D or 3D Tensor", "Weight data matrix.")
+    .add_argument("weight_indices", "1D Tensor", "Weight indices matrix.")
+    .add_argument("weight_indptr", "1D Tensor", "Weight indptr matrix.")
+    .set_support_level(1)
+    .add_type_rel("SparseConv2D", SparseConv2DRel);
+
 // relay.nn.sparse_transpose
 TVM_REGISTER_NODE_TYPE(SparseTransposeAttrs);
 
@@ -35,13 +35,17 @@ namespace relay {
 namespace qnn {
 
 TVM_REGISTER_NODE_TYPE(RequantizeAttrs);
+TVM_REGISTER_NODE_TYPE(FixedPointRequantizeAttrs);
 
-Array<Array<Layout>> RequantizeInferCorrectLayout(const Attrs& attrs,
-                                                  const Array<Layout>& new_in_layouts,
-                                                  const Array<Layout>& old_in_layouts,
-                                                  const Array<tvm::relay::Type>& old_in_types) {
-  RequantizeAttrs* param = const_cast<RequantizeAttrs*>(attrs.as<RequantizeAttrs>());
-
+/*
+ * \brief Infer the layouts of an op whose first input is the data and whose other inputs are
+ *        scalars or vectors along the channel axis, and move the axis to the new layout.
+ * \param axis_attr The channel axis attr of the op, updated for the new layout.
+ * \param num_inputs The number of inputs of the op.
+ */
+static Array<Array<Layout>> ChannelAxisInferCorrectLayout(
+    int* axis_attr, size_t num_inputs, const Array<Layout>& new_in_layouts,
+    const Array<Layout>& old_in_layouts, const Array<tvm::relay::Type>& old_in_types) {
   Array<Array<IndexExpr>> old_in_shapes;
   for (auto old_in_t : old_in_types) {
     CHECK(old_in_t.as<TensorTypeNode>());
@@ -52,11 +56,11 @@ Array<Array<Layout>> RequantizeInferCorrectLayout(const Attrs& attrs,
   if (new_in_layouts.defined()) {
     // Adapt to new layout. The axis has to change.
     // Record original reduce axis. Convert to the modified layout axis.
-    CHECK_EQ(new_in_layouts.size(), 5);
-    CHECK_EQ(old_in_layouts.size(), 5);
+    CHECK_EQ(new_in_layouts.size(), num_inputs);
+    CHECK_EQ(old_in_layouts.size(), num_inputs);
 
     // 1) Get the axis.
-    int axis = param->axis;
+    int axis = *axis_attr;
     axis = (axis == -1) ? old_in_shapes[0].size() - 1 : axis;
 
     // 2) Collect the original axis
@@ -85,30 +89,41 @@ Array<Array<Layout>> RequantizeInferCorrectLayout(const Attrs& attrs,
     // Fill the layouts of remaining input tensors - scales and zero points. The layouts of these
     // tensors can be treated as channel layout.
     Layout channel_layout = Layout("C");
-    input_layouts = {new_layout, channel_layout, channel_layout, channel_layout, channel_layout};
+    input_layouts = Array<Layout>(num_inputs, channel_layout);
+    input_layouts.Set(0, new_layout);
     output_layouts = {new_layout};
-    param->axis = new_axis;
+    *axis_attr = new_axis;
   } else if (old_in_layouts.defined()) {
     // If the new layout is undefined, set the old layout as the inferred layout.
-    CHECK_EQ(old_in_layouts.size(), 5);
+    CHECK_EQ(old_in_layouts.size(), num_inputs);
 
     Layout old_layout = old_in_layouts[0];
 
     // Fill the layouts of remaining input tensors - scales and zero points. The layouts of these
     // tensors can be treated as channel layout.
     Layout channel_layout = Layout("C");
-    input_layouts = {old_layout, channel_layout, channel_layout, channel_layout, channel_layout};
+    input_layouts = Array<Layout>(num_inputs, channel_layout);
+    input_layouts.Set(0, old_layout);
     output_layouts = {old_layout};
   } else {
     // Set the layouts to undef.
     Layout undef = Layout::Undef();
-    input_layouts = Array<Layout>(5, undef);
+    input_layouts = Array<Layout>(num_inputs, undef);
     output_layouts = {undef};
   }
 
   return Array<Array<Layout>>{input_layouts, output_layouts};
 }
 
+Array<Array<Layout>> RequantizeInferCorrectLayout(const Attrs& attrs,
+                                                  const Array<Layout>& new_in_layouts,
+                                                  const Array<Layout>& old_in_layouts,
+                                                  const Array<tvm::relay::Type>& old_in_types) {
+  RequantizeAttrs* param = const_cast<RequantizeAttrs*>(attrs.as<RequantizeAttrs>());
+  return ChannelAxisInferCorrectLayout(&param->axis, 5, new_in_layouts, old_in_layouts,
+                                       old_in_types);
+}
+
 // Lowering of qnn.requantize op
 
 /*
@@ -325,6 +340,142 @@ Q_output = zp_output +  (scale_input)/(scale_output) * (Q_input - zp_input)
 
 TVM_REGISTER_GLOBAL("relay.qnn.op._make.requantize").set_body_typed(MakeRequantize);
 
+// qnn.fixed_point_requantize, the fused epilogue of conv2d and dense.
+
+Array<Array<Layout>> FixedPointRequantizeInferCorrectLayout(
+    const Attrs& attrs, const Array<Layout>& new_in_layouts, const Array<Layout>& old_in_layouts,
+    const Array<tvm::relay::Type>& old_in_types) {
+  auto* param = const_cast<FixedPointRequantizeAttrs*>(attrs.as<FixedPointRequantizeAttrs>());
+  return ChannelAxisInferCorrectLayout(&param->axis, 4, new_in_layouts, old_in_layouts,
+                                       old_in_types);
+}
+
+bool FixedPointRequantizeRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                             const TypeReporter& reporter) {
+  CHECK_EQ(types.size(), 5);
+  const auto* data = types[0].as<TensorTypeNode>();
+  if (data == nullptr) return false;
+  CHECK(data->dtype == DataType::Int(32))
+      << "Input type should be int32 but was " << data->dtype;
+
+  const auto* param = attrs.as<FixedPointRequantizeAttrs>();
+  int axis = param->axis;
+  axis = (axis == -1) ? data->shape.size() - 1 : axis;
+  CHECK_LT(axis, static_cast<int>(data->shape.size())) << "axis " << param->axis
+                                                        << " is out of range";
+  CHECK_GE(axis, 0) << "axis " << param->axis << " is out of range";
+
+  // The bias, the multipliers and the shifts are scalars or vectors along the axis.
+  for (int i = 1; i < 4; ++i) {
+    AssignType(types[i], DataType::Int(32), data->shape[axis], reporter);
+  }
+  CHECK(param->compute_dtype == DataType::Int(32) || param->compute_dtype == DataType::Int(64))
+      << "Compute type should be one of [int32, int64] but was " << param->compute_dtype;
+  CHECK(param->out_dtype == DataType::Int(8) || param->out_dtype == DataType::UInt(8) ||
+        param->out_dtype == DataType::Int(32))
+      << "Output type should be one of [int8, uint8, int32] but was " << param->out_dtype;
+  reporter->Assign(types[4], TensorType(data->shape, param->out_dtype));
+  return true;
+}
+
+Expr MakeFixedPointRequantize(Expr data, Expr bias, Expr multiplier, Expr shift, int axis,
+                              int fractional_bits, int output_zero_point, int out_min,
+                              int out_max, DataType compute_dtype, DataType out_dtype) {
+  auto attrs = make_object<FixedPointRequantizeAttrs>();
+  attrs->axis = axis;
+  attrs->fractional_bits = fractional_bits;
+  attrs->output_zero_point = output_zero_point;
+  attrs->out_min = out_min;
+  attrs->out_max = out_max;
+  attrs->compute_dtype = std::move(compute_dtype);
+  attrs->out_dtype = std::move(out_dtype);
+  static const Op& op = Op::Get("qnn.fixed_point_requantize");
+  return Call(op, {data, bias, multiplier, shift}, Attrs(attrs), {});
+}
+
+/*
+ * \brief Lower qnn.fixed_point_requantize to core Relay ops, with the arithmetic of
+ *        topi.nn.fixed_point_requantize so the result stays bit exact.
+ *
+ *  It is registered as FTVMQnnCanonicalizeFused rather than FTVMQnnCanonicalize, so the
+ *  qnn Legalize of the build keeps the fused op and lowers it with its TOPI compute. Only
+ *  qnn.transform.CanonicalizeOps applies it, for external codegens that take core ops.
+ *
+ * \param attrs The FixedPointRequantize attrs.
+ * \param new_args The new mutated args to the call node.
+ * \param types The types of input and output.
+ * \return The sequence of Relay ops for the fused epilogue.
+ */
+Expr FixedPointRequantizeQnnCanonicalize(const Attrs& attrs, const Array<Expr>& new_args,
+                                         const Array<tvm::relay::Type>& types) {
+  CHECK_EQ(new_args.size(), 4);
+  CHECK_EQ(types.size(), 5);
+  const auto* param = attrs.as<FixedPointRequantizeAttrs>();
+  CHECK(param != nullptr);
+  const auto* in_tensor_type = types[0].as<TensorTypeNode>();
+  CHECK(in_tensor_type != nullptr) << "Type information missing."
+                                   << " Please run infer_type pass.";
+  int ndim = static_cast<int>(in_tensor_type->shape.size());
+  int axis = param->axis == -1 ? ndim - 1 : param->axis;
+
+  // The bias, the multipliers and the shifts are scalars or vectors along the axis.
+  auto expand_to_axis = [&](int i) {
+    const auto* tensor_type = types[i].as<TensorTypeNode>();
+    CHECK(tensor_type != nullptr);
+    if (tensor_type->shape.size() == 0) return new_args[i];
+    return ExpandBiasToMatchAxis(new_args[i], ndim, {axis});
+  };
+  auto bias = expand_to_axis(1);
+  auto multiplier = expand_to_axis(2);
+  auto shift = expand_to_axis(3);
+
+  auto tensor = Add(new_args[0], bias);
+  auto fractional_bits = MakeConstantScalar(DataType::Int(32), param->fractional_bits);
+  if (param->compute_dtype == DataType::Int(32)) {
+    // The fusion checked that the products and the rounding term fit in int32.
+    auto total_shift = Subtract(fractional_bits, shift);
+    auto one = MakeConstantScalar(DataType::Int(32), 1);
+    auto rounding = LeftShift(one, Subtract(total_shift, one));
+    tensor = RightShift(Add(Multiply(tensor, multiplier), rounding), total_shift);
+  } else {
+    // The steps of the q_multiply_shift intrinsic.
+    auto hp_dtype = DataType::Int(64);
+    auto zero = MakeConstantScalar(DataType::Int(32), 0);
+    auto one = MakeConstantScalar(hp_dtype, 1);
+    auto left_shift = Cast(Maximum(shift, zero), hp_dtype);
+    auto total_right_shift = Cast(Add(Maximum(Negative(shift), zero), fractional_bits), hp_dtype);
+    auto rounding = LeftShift(one, Subtract(total_right_shift, one));
+    tensor = Multiply(LeftShift(Cast(tensor, hp_dtype), left_shift), Cast(multiplier, hp_dtype));
+    tensor = Cast(RightShift(Add(tensor, rounding), total_right_shift), DataType::Int(32));
+  }
+  tensor = Add(tensor, MakeConstantScalar(DataType::Int(32), param->output_zero_point));
+  tensor = Clip(tensor, param->out_min, param->out_max);
+  return Cast(tensor, param->out_dtype);
+}
+
+RELAY_REGISTER_OP("qnn.fixed_point_requantize")
+    .describe(R"code(Fixed point requantize epilogue of a quantized conv2d or dense.
+It is created by qnn.transform.FuseRequantize from a bias add, a requantize, a clip and
+a cast, and is computed as a single elementwise stage:
+
+Q_output = cast(clip(zp_output + round((data + bias) * multiplier * 2^(shift - fractional_bits))))
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<FixedPointRequantizeAttrs>()
+    .set_num_inputs(4)
+    .add_argument("data", "Tensor", "The int32 accumulator.")
+    .add_argument("bias", "Tensor", "The int32 bias, with the input zero point folded in.")
+    .add_argument("multiplier", "Tensor", "The fixed point multipliers.")
+    .add_argument("shift", "Tensor", "The shifts, positive to shift left.")
+    .set_support_level(11)
+    .add_type_rel("FixedPointRequantize", FixedPointRequantizeRel)
+    .set_attr<TOpPattern>("TOpPattern", kBroadcast)
+    .set_attr<FTVMLegalize>("FTVMQnnCanonicalizeFused", FixedPointRequantizeQnnCanonicalize)
+    .set_attr<FInferCorrectLayout>("FInferCorrectLayout", FixedPointRequantizeInferCorrectLayout);
+
+TVM_REGISTER_GLOBAL("relay.qnn.op._make.fixed_point_requantize")
+    .set_body_typed(MakeFixedPointRequantize);
+
 }  // namespace qnn
 }  // namespace relay
 }  // namespace tvm
@@ -0,0 +1,360 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file relay/qnn/pass/fuse_requantize.cc
+ * \brief Fuse the bias add, requantize, clip and cast that follow a quantized conv2d or dense
+ *        into a single qnn.fixed_point_requantize.
+ *
+ * Canonicalizing qnn.requantize emits a chain of casts, multiplies, shifts and clips in int64,
+ * and the bias add and the activation clip are separate ops around it. The fused op computes
+ * all of them in one elementwise stage of int32 inputs, with the input zero point folded into
+ * the bias. When the range of the accumulator, bounded from the dtypes, the zero points and the
+ * reduction size of the producer, keeps the products of the multipliers in int32, the op is
+ * computed without int64 intermediates. The result is the same as the canonicalized ops.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/qnn/attrs.h>
+#include <tvm/relay/qnn/transform.h>
+#include <tvm/tir/data_layout.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../transforms/pattern_util.h"
+#include "../util.h"
+
+namespace tvm {
+namespace relay {
+namespace qnn {
+
+Expr MakeFixedPointRequantize(Expr data, Expr bias, Expr multiplier, Expr shift, int axis,
+                              int fractional_bits, int output_zero_point, int out_min,
+                              int out_max, DataType compute_dtype, DataType out_dtype);
+
+/*! \brief Read the values of an int32 constant, false if expr is not one. */
+static bool GetInt32Values(const Expr& expr, std::vector<int64_t>* values) {
+  const auto* n = expr.as<ConstantNode>();
+  if (n == nullptr || n->data->dtype.code != kDLInt || n->data->dtype.bits != 32) {
+    return false;
+  }
+  int64_t num_elems = 1;
+  for (int64_t dim : n->data.Shape()) {
+    num_elems *= dim;
+  }
+  const int32_t* data = static_cast<const int32_t*>(n->data->data);
+  values->assign(data, data + num_elems);
+  return true;
+}
+
+/*! \brief The largest magnitude of a quantized operand minus its zero point, -1 if unknown. */
+static int64_t MaxAbsQuantized(const Expr& operand, const Expr& zero_point) {
+  const auto* type = operand->checked_type().as<TensorTypeNode>();
+  std::vector<int64_t> zero_points;
+  if (type == nullptr || type->dtype.bits() > 16 || !GetInt32Values(zero_point, &zero_points)) {
+    return -1;
+  }
+  int64_t qmin = GetQmin(type->dtype), qmax = GetQmax(type->dtype);
+  int64_t max_abs = 0;
+  for (int64_t zp : zero_points) {
+    max_abs = std::max(max_abs, std::max(std::abs(qmin - zp), std::abs(qmax - zp)));
+  }
+  return max_abs;
+}
+
+/*! \brief Number of bits of the magnitude of value. */
+static int BitLength(int64_t value) {
+  int bits = 0;
+  for (uint64_t v = std::abs(value); v != 0; v >>= 1) ++bits;
+  return bits;
+}
+
+class RequantizeFuser : public MixedModeMutator {
+ public:
+  explicit RequantizeFuser(const Expr& expr)
+      : requantize_op_(Op::Get("qnn.requantize")),
+        fixed_point_requantize_op_(Op::Get("qnn.fixed_point_requantize")),
+        conv2d_op_(Op::Get("qnn.conv2d")),
+        dense_op_(Op::Get("qnn.dense")),
+        bias_add_op_(Op::Get("nn.bias_add")),
+        add_op_(Op::Get("add")),
+        clip_op_(Op::Get("clip")),
+        cast_op_(Op::Get("cast")) {
+    CountUses(expr);
+  }
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    const auto* call = post.as<CallNode>();
+    if (call == nullptr) return post;
+    if (call->op == requantize_op_) return FuseRequantize(pre, call, post);
+    if (call->op == clip_op_) return FuseClip(pre, call, post);
+    if (call->op == cast_op_) return FuseCast(pre, call, post);
+    return post;
+  }
+
+ private:
+  void CountUses(const Expr& expr) {
+    PostOrderVisit(expr, [this](const Expr& e) {
+      if (const auto* call = e.as<CallNode>()) {
+        for (const auto& arg : call->args) ++uses_[arg];
+      } else if (const auto* tuple = e.as<TupleNode>()) {
+        for (const auto& field : tuple->fields) ++uses_[field];
+      } else if (const auto* get = e.as<TupleGetItemNode>()) {
+        ++uses_[get->tuple];
+      }
+    });
+  }
+
+  /*!
+   * \brief Get the bias added to a conv2d or dense, along the channel axis.
+   * \return The bias values, one or one per channel, empty if expr does not add a constant.
+   */
+  std::vector<int64_t> GetBias(const CallNode* call, int axis, int ndim, Expr* acc) {
+    std::vector<int64_t> values;
+    if (call->op == bias_add_op_) {
+      const auto* attrs = call->attrs.as<BiasAddAttrs>();
+      int bias_axis = attrs->axis < 0 ? attrs->axis + ndim : attrs->axis;
+      if (bias_axis == axis && GetInt32Values(call->args[1], &values)) {
+        *acc = call->args[0];
+      } else {
+        values.clear();
+      }
+      return values;
+    }
+    if (call->op != add_op_) return values;
+    for (int i = 0; i < 2; ++i) {
+      const auto* constant = call->args[1 - i].as<ConstantNode>();
+      if (constant == nullptr || !GetInt32Values(call->args[1 - i], &values)) continue;
+      // The constant broadcasts from the right, all its dims but the channel one are 1.
+      auto shape = constant->data.Shape();
+      int offset = ndim - static_cast<int>(shape.size());
+      bool is_channel_vector = offset >= 0;
+      for (size_t j = 0; j < shape.size() && is_channel_vector; ++j) {
+        is_channel_vector = shape[j] == 1 || static_cast<int>(j) + offset == axis;
+      }
+      if (is_channel_vector) {
+        *acc = call->args[i];
+        return values;
+      }
+    }
+    values.clear();
+    return values;
+  }
+
+  /*! \brief Bound the magnitude of the int32 output of a qnn.conv2d or qnn.dense, -1 if unknown. */
+  int64_t BoundAccumulator(const CallNode* producer) {
+    const auto* weight_type = producer->args[1]->checked_type().as<TensorTypeNode>();
+    if (weight_type == nullptr) return -1;
+    std::vector<int64_t> shape;
+    for (const auto& dim : weight_type->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      if (imm == nullptr) return -1;
+      shape.push_back(imm->value);
+    }
+    // The number of products summed into each output.
+    int64_t reduction = 1;
+    for (int64_t dim : shape) reduction *= dim;
+    if (producer->op == conv2d_op_) {
+      const auto* attrs = producer->attrs.as<Conv2DAttrs>();
+      int out_axis = tir::Layout(attrs->kernel_layout).IndexOf(tir::LayoutAxis::Get('O'));
+      if (out_axis < 0 || out_axis >= static_cast<int>(shape.size())) return -1;
+      reduction /= shape[out_axis];
+    } else {
+      reduction = shape.back();
+    }
+    int64_t data_max = MaxAbsQuantized(producer->args[0], producer->args[2]);
+    int64_t weight_max = MaxAbsQuantized(producer->args[1], producer->args[3]);
+    if (data_max < 0 || weight_max < 0) return -1;
+    return reduction * data_max * weight_max;
+  }
+
+  Expr FuseRequantize(const CallNode* pre, const CallNode* call, const Expr& post) {
+    const auto* attrs = call->attrs.as<RequantizeAttrs>();
+    // TONEAREST rounds the midpoints away from zero, unlike tir.q_multiply_shift.
+    if (attrs->rounding != "UPWARD") return post;
+    const auto* type = pre->args[0]->checked_type().as<TensorTypeNode>();
+    if (type == nullptr || type->dtype != DataType::Int(32)) return post;
+    int ndim = static_cast<int>(type->shape.size());
+    int axis = attrs->axis < 0 ? attrs->axis + ndim : attrs->axis;
+    const auto* channels = type->shape[axis].as<IntImmNode>();
+    if (channels == nullptr) return post;
+
+    // Match the producer on the typed graph, the rewritten graph has the same structure.
+    Expr pre_acc = pre->args[0], post_acc = call->args[0];
+    std::vector<int64_t> bias = {0};
+    if (const auto* pre_add = pre_acc.as<CallNode>()) {
+      Expr pre_inner;
+      std::vector<int64_t> values = GetBias(pre_add, axis, ndim, &pre_inner);
+      if (!values.empty()) {
+        const auto* post_add = post_acc.as<CallNode>();
+        post_acc = post_add->args[pre_inner.same_as(pre_add->args[0]) ? 0 : 1];
+        pre_acc = pre_inner;
+        bias = values;
+      }
+    }
+    const auto* producer = pre_acc.as<CallNode>();
+    if (producer == nullptr || (producer->op != conv2d_op_ && producer->op != dense_op_)) {
+      return post;
+    }
+
+    // Per tensor or per channel scales, the zero points are scalars.
+    std::vector<int64_t> input_zero_point, output_zero_point;
+    if (!GetInt32Values(call->args[2], &input_zero_point) || input_zero_point.size() != 1 ||
+        !GetInt32Values(call->args[4], &output_zero_point) || output_zero_point.size() != 1 ||
+        !call->args[1].as<ConstantNode>() || !IsConstScalar(call->args[3])) {
+      return post;
+    }
+    std::vector<float> input_scales = GetFloatVectorFromConstant(call->args[1]);
+    float output_scale = GetScalarFromConstant<float>(call->args[3]);
+    size_t num = std::max(input_scales.size(), bias.size());
+    if ((input_scales.size() != 1 && input_scales.size() != num) ||
+        (bias.size() != 1 && bias.size() != num)) {
+      return post;
+    }
+    if (num != 1 && static_cast<int64_t>(num) != channels->value) return post;
+
+    std::vector<int64_t> multipliers(num), shifts(num), biases(num);
+    int64_t max_bias = 0;
+    for (size_t i = 0; i < num; ++i) {
+      double multiplier = static_cast<double>(input_scales[input_scales.size() == 1 ? 0 : i]) /
+                          static_cast<double>(output_scale);
+      std::tie(multipliers[i], shifts[i]) = GetFixedPointMultiplierShift(multiplier);
+      biases[i] = bias[bias.size() == 1 ? 0 : i] - input_zero_point[0];
+      if (biases[i] < std::numeric_limits<int32_t>::min() ||
+          biases[i] > std::numeric_limits<int32_t>::max()) {
+        return post;
+      }
+      max_bias = std::max(max_bias, std::abs(biases[i]));
+    }
+
+    // Multiply in int32 if |acc * multiplier| and the rounding term stay below 2^31. The trailing
+    // zero bits of the multipliers are dropped to leave more room for the accumulator.
+    int fractional_bits = 31;
+    DataType compute_dtype = DataType::Int(64);
+    int64_t acc_bound = BoundAccumulator(producer);
+    if (acc_bound >= 0) {
+      int trailing_zeros = 31;
+      for (int64_t m : multipliers) {
+        for (int bits = 0; bits < trailing_zeros; ++bits) {
+          if (m & (int64_t(1) << bits)) trailing_zeros = bits;
+        }
+      }
+      int data_bits = BitLength(acc_bound + max_bias) + 1;
+      bool fits = true;
+      for (size_t i = 0; i < num && fits; ++i) {
+        int64_t total_shift = 31 - trailing_zeros - shifts[i];
+        fits = data_bits + BitLength(multipliers[i] >> trailing_zeros) <= 31 &&
+               total_shift >= 1 && total_shift <= 31;
+      }
+      if (fits) {
+        for (auto& m : multipliers) m >>= trailing_zeros;
+        fractional_bits -= trailing_zeros;
+        compute_dtype = DataType::Int(32);
+      }
+    }
+
+    auto make_values = [num](const std::vector<int64_t>& values) -> Expr {
+      if (num == 1) return MakeConstantScalar(DataType::Int(32), static_cast<int32_t>(values[0]));
+      std::vector<int32_t> data(values.begin(), values.end());
+      return MakeConstantTensor(DataType::Int(32), {static_cast<int64_t>(num)}, data);
+    };
+    DataType out_dtype = attrs->out_dtype;
+    return MakeFixedPointRequantize(post_acc, make_values(biases), make_values(multipliers),
+                                    make_values(shifts), axis, fractional_bits,
+                                    static_cast<int>(output_zero_point[0]), GetQmin(out_dtype),
+                                    GetQmax(out_dtype), compute_dtype, out_dtype);
+  }
+
+  /*! \brief Get the fused op of the argument when nothing else uses it. */
+  const CallNode* GetFused(const CallNode* pre, const CallNode* call) {
+    const auto* arg = call->args[0].as<CallNode>();
+    if (arg == nullptr || arg->op != fixed_point_requantize_op_ || uses_[pre->args[0]] != 1) {
+      return nullptr;
+    }
+    return arg;
+  }
+
+  Expr FuseClip(const CallNode* pre, const CallNode* call, const Expr& post) {
+    const CallNode* fused = GetFused(pre, call);
+    if (fused == nullptr) return post;
+    const auto* clip = call->attrs.as<ClipAttrs>();
+    // Clip compares with the bounds converted to the integer type, keep to integral bounds.
+    if (clip->a_min != std::floor(clip->a_min) || clip->a_max != std::floor(clip->a_max)) {
+      return post;
+    }
+    auto attrs = make_object<FixedPointRequantizeAttrs>(
+        *fused->attrs.as<FixedPointRequantizeAttrs>());
+    attrs->out_min = static_cast<int>(std::max<double>(attrs->out_min, clip->a_min));
+    attrs->out_max = static_cast<int>(std::min<double>(attrs->out_max, clip->a_max));
+    if (attrs->out_min > attrs->out_max) return post;
+    return Call(fused->op, fused->args, Attrs(attrs), fused->type_args);
+  }
+
+  Expr FuseCast(const CallNode* pre, const CallNode* call, const Expr& post) {
+    const CallNode* fused = GetFused(pre, call);
+    if (fused == nullptr) return post;
+    DataType dtype = call->attrs.as<CastAttrs>()->dtype;
+    if (dtype != DataType::Int(8) && dtype != DataType::UInt(8) && dtype != DataType::Int(32)) {
+      return post;
+    }
+    auto attrs = make_object<FixedPointRequantizeAttrs>(
+        *fused->attrs.as<FixedPointRequantizeAttrs>());
+    // The cast is exact when the clipped output fits in its type.
+    if (attrs->out_min < GetQmin(dtype) || attrs->out_max > GetQmax(dtype)) return post;
+    attrs->out_dtype = dtype;
+    return Call(fused->op, fused->args, Attrs(attrs), fused->type_args);
+  }
+
+  const Op& requantize_op_;
+  const Op& fixed_point_requantize_op_;
+  const Op& conv2d_op_;
+  const Op& dense_op_;
+  const Op& bias_add_op_;
+  const Op& add_op_;
+  const Op& clip_op_;
+  const Op& cast_op_;
+  /*! \brief The number of uses of each expr in the original graph. */
+  std::unordered_map<Expr, int, ObjectPtrHash, ObjectPtrEqual> uses_;
+};
+
+Expr FuseRequantize(const Expr& expr) { return RequantizeFuser(expr).Mutate(expr); }
+
+namespace transform {
+
+Pass FuseRequantize() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, relay::transform::PassContext)> pass_func =
+      [=](Function f, IRModule m, relay::transform::PassContext pc) {
+        return Downcast<Function>(qnn::FuseRequantize(f));
+      };
+  return relay::transform::CreateFunctionPass(pass_func, 0, "FuseRequantize", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay.qnn._transform.FuseRequantize").set_body_typed(FuseRequantize);
+
+}  // namespace transform
+
+}  // namespace qnn
+}  // namespace relay
+}  // namespace tvm
@@ -30,6 +30,8 @@
 #include <tvm/relay/transform.h>
 #include <tvm/tir/op.h>
 
+#include <algorithm>
+
 #include "../../support/arena.h"
 #include "pass_util.h"
 #include "pattern_util.h"
@@ -401,6 +403,55 @@ class DominatorTree {
     if (lhs > rhs) return lhs;
     return rhs;
   }
+  /*!
+   * \brief Ancestor tables for binary lifting.
+   *
+   *  ancestors_[k][i] is the 2^k-th ancestor of the node with graph index i,
+   *  and path_patterns_[k][i] combines the patterns of the 2^k nodes on the
+   *  way to it. The tree grows from the outputs towards the inputs, so the
+   *  rows of a node are filled when it is created.
+   */
+  std::vector<std::vector<Node*>> ancestors_;
+  std::vector<std::vector<OpPatternKind>> path_patterns_;
+  /*!
+   * \brief Fill the ancestor tables of a new node.
+   * \param tnode The node, its parent must already be in the tree.
+   */
+  void AddAncestors(Node* tnode) {
+    size_t index = tnode->gnode->index;
+    ancestors_[0][index] = tnode->parent;
+    path_patterns_[0][index] = tnode->pattern;
+    for (size_t k = 1; k < ancestors_.size(); ++k) {
+      Node* mid = ancestors_[k - 1][index];
+      if (mid == nullptr) {
+        ancestors_[k][index] = nullptr;
+        path_patterns_[k][index] = path_patterns_[k - 1][index];
+      } else {
+        size_t mid_index = mid->gnode->index;
+        ancestors_[k][index] = ancestors_[k - 1][mid_index];
+        path_patterns_[k][index] =
+            CombinePattern(path_patterns_[k - 1][index], path_patterns_[k - 1][mid_index]);
+      }
+    }
+  }
+  /*!
+   * \brief Move a node up the tree.
+   * \param node The node.
+   * \param steps The number of steps, at most the depth of the node minus one.
+   * \param edge_pattern
+   *        The combined edge pattern, updated with the nodes that are left.
+   * \return The ancestor.
+   */
+  Node* Lift(Node* node, int steps, OpPatternKind* edge_pattern) const {
+    for (size_t k = 0; steps != 0; ++k, steps >>= 1) {
+      if (steps & 1) {
+        size_t index = node->gnode->index;
+        edge_pattern[0] = CombinePattern(edge_pattern[0], path_patterns_[k][index]);
+        node = ancestors_[k][index];
+      }
+    }
+    return node;
+  }
   /*!
    * \brief Find the least common ancestor of the two nodes.
    * \param lhs The left node.
@@ -408,25 +459,33 @@ class DominatorTree {
    * \param edge_pattern
    *        The combined edge pattern across all the parents.
    * \return The least common ancestor of the two.
+   * \note Binary lifting visits O(log(depth)) nodes, instead of walking
+   *       up node by node, which is quadratic on deep graphs with wide fan-out.
    */
-  static Node* LeastCommonAncestor(Node* lhs, Node* rhs, OpPatternKind* edge_pattern) {
-    while (lhs != rhs) {
-      if (lhs == nullptr) return nullptr;
-      if (rhs == nullptr) return nullptr;
-      if (lhs->depth < rhs->depth) {
-        edge_pattern[0] = CombinePattern(edge_pattern[0], rhs->pattern);
-        rhs = rhs->parent;
-      } else if (rhs->depth < lhs->depth) {
-        edge_pattern[0] = CombinePattern(edge_pattern[0], lhs->pattern);
-        lhs = lhs->parent;
-      } else {
-        edge_pattern[0] = CombinePattern(edge_pattern[0], lhs->pattern);
-        edge_pattern[0] = CombinePattern(edge_pattern[0], rhs->pattern);
-        lhs = lhs->parent;
-        rhs = rhs->parent;
+  Node* LeastCommonAncestor(Node* lhs, Node* rhs, OpPatternKind* edge_pattern) const {
+    if (lhs == rhs) return lhs;
+    if (lhs == nullptr || rhs == nullptr) return nullptr;
+    if (lhs->depth < rhs->depth) {
+      rhs = Lift(rhs, rhs->depth - lhs->depth, edge_pattern);
+    } else if (rhs->depth < lhs->depth) {
+      lhs = Lift(lhs, lhs->depth - rhs->depth, edge_pattern);
+    }
+    if (lhs == rhs) return lhs;
+    for (size_t k = ancestors_.size(); k != 0; --k) {
+      size_t lindex = lhs->gnode->index, rindex = rhs->gnode->index;
+      Node* lparent = ancestors_[k - 1][lindex];
+      Node* rparent = ancestors_[k - 1][rindex];
+      if (lparent != rparent) {
+        edge_pattern[0] = CombinePattern(edge_pattern[0], path_patterns_[k - 1][lindex]);
+        edge_pattern[0] = CombinePattern(edge_pattern[0], path_patterns_[k - 1][rindex]);
+        lhs = lparent;
+        rhs = rparent;
       }
     }
-    return lhs;
+    // lhs and rhs are now children of the ancestor, which is nullptr in different trees.
+    edge_pattern[0] = CombinePattern(edge_pattern[0], lhs->pattern);
+    edge_pattern[0] = CombinePattern(edge_pattern[0], rhs->pattern);
+    return lhs->parent;
   }
   /*!
    * \brief Find the least common ancestor of a list of nodes.
@@ -478,13 +537,20 @@ class DominatorTree {
       tnode->parent = parent;
       tnode->pattern = pattern;
     }
+    AddAncestors(tnode);
     return tnode;
   }
 };
 
 DominatorTree DominatorTree::PostDom(support::Arena* arena, const IndexedForwardGraph& graph) {
   DominatorTree tree;
-  tree.nodes.resize(graph.post_dfs_order.size(), nullptr);
+  size_t num_nodes = graph.post_dfs_order.size();
+  tree.nodes.resize(num_nodes, nullptr);
+  // The depth is at most the number of nodes.
+  size_t num_levels = 1;
+  while ((static_cast<size_t>(1) << num_levels) < num_nodes) ++num_levels;
+  tree.ancestors_.assign(num_levels, std::vector<Node*>(num_nodes, nullptr));
+  tree.path_patterns_.assign(num_levels, std::vector<OpPatternKind>(num_nodes, kOpaque));
   // reverse topo order
   for (size_t i = graph.post_dfs_order.size(); i != 0; --i) {
     size_t index = i - 1;
@@ -555,21 +621,37 @@ class GraphPartitioner {
   size_t max_fuse_depth_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
-  /*! \brief internal field used for deduplication */
-  std::unordered_set<IndexedForwardGraph::Node*> visited_;
-  // Internal implelementation of CheckPath
-  template <typename F>
-  bool CheckPath_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink, F fcond) {
-    if (visited_.count(src)) return true;
-    visited_.insert(src);
-    Group* gnode = groups_[src->index];
-    CHECK(gnode != nullptr);
-    gnode = gnode->FindRoot();
-    if (!fcond(gnode->pattern, src == sink)) return false;
-    if (src == sink) return true;
-    for (auto link = src->outputs.head; link != nullptr; link = link->next) {
-      if (!CheckPath_(link->value.node, sink, fcond)) return false;
+  /*!
+   * \brief internal field used for deduplication, a node is visited
+   *  in the current traversal when its mark equals visit_epoch_.
+   */
+  std::vector<uint32_t> visit_mark_;
+  uint32_t visit_epoch_{0};
+  /*! \brief The stack of the current traversal. */
+  std::vector<IndexedForwardGraph::Node*> stack_;
+  // Start a new traversal from the outputs of src.
+  void StartTraversal(IndexedForwardGraph::Node* src, bool include_src = false) {
+    if (++visit_epoch_ == 0) {
+      std::fill(visit_mark_.begin(), visit_mark_.end(), 0);
+      visit_epoch_ = 1;
     }
+    stack_.clear();
+    if (include_src) {
+      stack_.push_back(src);
+      return;
+    }
+    PushOutputs(src);
+  }
+  // Push the outputs of node to the traversal stack.
+  void PushOutputs(IndexedForwardGraph::Node* node) {
+    for (auto link = node->outputs.head; link != nullptr; link = link->next) {
+      stack_.push_back(link->value.node);
+    }
+  }
+  // Mark node as visited, return false if it already is.
+  bool Visit(IndexedForwardGraph::Node* node) {
+    if (visit_mark_[node->index] == visit_epoch_) return false;
+    visit_mark_[node->index] = visit_epoch_;
     return true;
   }
   /*!
@@ -587,10 +669,18 @@ class GraphPartitioner {
   template <typename F>
   bool CheckPath(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink, F fcond) {
     CHECK(!src->extern_ref);
-    visited_.clear();
     CHECK(src != sink);
-    for (auto link = src->outputs.head; link != nullptr; link = link->next) {
-      if (!CheckPath_(link->value.node, sink, fcond)) return false;
+    // Iterative, so that long chains do not overflow the stack.
+    StartTraversal(src);
+    while (!stack_.empty()) {
+      IndexedForwardGraph::Node* node = stack_.back();
+      stack_.pop_back();
+      if (!Visit(node)) continue;
+      Group* gnode = groups_[node->index];
+      CHECK(gnode != nullptr);
+      gnode = gnode->FindRoot();
+      if (!fcond(gnode->pattern, node == sink)) return false;
+      if (node != sink) PushOutputs(node);
     }
     return true;
   }
@@ -621,19 +711,6 @@ class GraphPartitioner {
       parent->pattern = CombinePattern(child->pattern, parent->pattern);
     }
   }
-  // Internal implelementation of CommitFuse
-  void CommitFuse_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink, Group* target) {
-    if (src == sink) return;
-    if (visited_.count(src)) return;
-    visited_.insert(src);
-    Group* gnode = groups_[src->index];
-    CHECK(gnode != nullptr);
-    // merge the current group to the parent if possible.
-    MergeFromTo(gnode, target);
-    for (auto link = src->outputs.head; link != nullptr; link = link->next) {
-      CommitFuse_(link->value.node, sink, target);
-    }
-  }
   /*!
    * \brief Commit fusion operation.
    * \param src The source node.
@@ -642,19 +719,31 @@ class GraphPartitioner {
    */
   void CommitFuse(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink) {
     Group* target = groups_[sink->index];
-    visited_.clear();
     CHECK(src != sink);
-    CommitFuse_(src, sink, target);
+    StartTraversal(src, true);
+    while (!stack_.empty()) {
+      IndexedForwardGraph::Node* node = stack_.back();
+      stack_.pop_back();
+      if (node == sink || !Visit(node)) continue;
+      Group* gnode = groups_[node->index];
+      CHECK(gnode != nullptr);
+      // merge the current group to the parent if possible.
+      MergeFromTo(gnode, target);
+      PushOutputs(node);
+    }
   }
 
   size_t CountNodesUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink) {
-    if (src == sink || visited_.count(src)) return 0;
-    visited_.insert(src);
-    Group* gnode = groups_[src->index];
-    CHECK(gnode != nullptr);
-    auto sum = gnode->num_nodes;
-    for (auto link = src->outputs.head; link != nullptr; link = link->next) {
-      sum += CountNodesUptoSink_(link->value.node, sink);
+    size_t sum = 0;
+    StartTraversal(src, true);
+    while (!stack_.empty()) {
+      IndexedForwardGraph::Node* node = stack_.back();
+      stack_.pop_back();
+      if (node == sink || !Visit(node)) continue;
+      Group* gnode = groups_[node->index];
+      CHECK(gnode != nullptr);
+      sum += gnode->num_nodes;
+      PushOutputs(node);
     }
     return sum;
   }
@@ -668,7 +757,6 @@ class GraphPartitioner {
   size_t CountFusedNodesWithNewChild(IndexedForwardGraph::Node* child,
                                      IndexedForwardGraph::Node* dom_parent) {
     Group* target = groups_[dom_parent->index];
-    visited_.clear();
     CHECK(child != dom_parent);
     return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
   }
@@ -676,6 +764,7 @@ class GraphPartitioner {
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph) {
     groups_.resize(graph.post_dfs_order.size());
+    visit_mark_.assign(groups_.size(), 0);
     for (size_t nid = 0; nid < groups_.size(); ++nid) {
       const auto* graph_node = graph.post_dfs_order[nid];
       auto* group_node = arena_->make<Group>();
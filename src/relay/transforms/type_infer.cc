@@ -39,11 +39,14 @@
  */
 #include <tvm/ir/error.h>
 #include <tvm/ir/type_functor.h>
+#include <tvm/node/structural_equal.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <unordered_set>
+
 #include "../analysis/type_solver.h"
 #include "pass_util.h"
 
@@ -84,6 +87,123 @@ struct ResolvedTypeInfo {
   // Only allocated when the expression is a call.
 
   Array<Type> type_args = Array<Type>(ObjectPtr<Object>(nullptr));
+  // Whether checked_type is reused from a previous inference,
+  // in which case the children of the expression are not visited.
+  bool reused{false};
+};
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType.incremental", Bool);
+
+/*!
+ * \brief Whether the checked type of expr from a previous inference can be reused.
+ *
+ *  Expressions are immutable, so an expression that still carries a checked type
+ *  has the same children as when it was typed. Its type stays valid as long as it
+ *  is closed, a tensor or a tuple of tensors without type variables or unknowns,
+ *  and the subexpression does not depend on its context, see ContextDependenceCollector.
+ */
+bool CanReuseCheckedType(const Expr& expr) {
+  // Variables and globals are typed by their binding site.
+  if (expr.as<VarNode>() || expr.as<GlobalVarNode>() || expr.as<OpNode>() ||
+      expr.as<ConstructorNode>()) {
+    return false;
+  }
+  if (!expr->checked_type_.defined()) return false;
+  std::function<bool(const Type&)> is_closed = [&is_closed](const Type& t) {
+    if (t.as<TensorTypeNode>()) return true;
+    if (auto* tuple = t.as<TupleTypeNode>()) {
+      for (const Type& field : tuple->fields) {
+        if (!is_closed(field)) return false;
+      }
+      return true;
+    }
+    return false;
+  };
+  return is_closed(expr->checked_type_);
+}
+
+/*!
+ * \brief Collect the subexpressions whose type can change while the expression itself
+ *  stays the same. Those refer to a global function, whose signature may have changed,
+ *  call anything but an operator, or use a variable without a type annotation, which
+ *  is typed by its binding site.
+ */
+class ContextDependenceCollector : private MixedModeVisitor {
+ public:
+  static std::unordered_set<const Object*> Collect(const Expr& expr) {
+    ContextDependenceCollector collector;
+    collector.VisitExpr(expr);
+    return std::move(collector.dependent_);
+  }
+
+ private:
+  using MixedModeVisitor::VisitExpr_;
+
+  bool Dependent(const Expr& expr) const { return dependent_.count(expr.get()) != 0; }
+
+  void Mark(const Object* node, bool dependent) {
+    if (dependent) dependent_.insert(node);
+  }
+
+  void VisitExpr_(const VarNode* op) final { Mark(op, !op->type_annotation.defined()); }
+
+  void VisitExpr_(const GlobalVarNode* op) final { Mark(op, true); }
+
+  void VisitExpr_(const ConstructorNode* op) final { Mark(op, true); }
+
+  // The children of dataflow nodes are visited before the node itself.
+  void VisitExpr_(const CallNode* op) final {
+    bool dependent = op->op.as<OpNode>() == nullptr;
+    for (const Expr& arg : op->args) dependent = dependent || Dependent(arg);
+    Mark(op, dependent);
+  }
+
+  void VisitExpr_(const TupleNode* op) final {
+    bool dependent = false;
+    for (const Expr& field : op->fields) dependent = dependent || Dependent(field);
+    Mark(op, dependent);
+  }
+
+  void VisitExpr_(const TupleGetItemNode* op) final { Mark(op, Dependent(op->tuple)); }
+
+  void VisitExpr_(const FunctionNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->body));
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->var) || Dependent(op->value) || Dependent(op->body));
+  }
+
+  void VisitExpr_(const IfNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->cond) || Dependent(op->true_branch) || Dependent(op->false_branch));
+  }
+
+  void VisitExpr_(const MatchNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    bool dependent = Dependent(op->data);
+    for (const Clause& clause : op->clauses) dependent = dependent || Dependent(clause->rhs);
+    Mark(op, dependent);
+  }
+
+  void VisitExpr_(const RefCreateNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->value));
+  }
+
+  void VisitExpr_(const RefReadNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->ref));
+  }
+
+  void VisitExpr_(const RefWriteNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    Mark(op, Dependent(op->ref) || Dependent(op->value));
+  }
+
+  std::unordered_set<const Object*> dependent_;
 };
 
 //
@@ -98,9 +218,10 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
  public:
   // constructors
 
-  explicit TypeInferencer(IRModule mod, GlobalVar current_func)
+  explicit TypeInferencer(IRModule mod, GlobalVar current_func, bool incremental = false)
       : mod_(mod),
         current_func_(current_func),
+        incremental_(incremental),
         err_reporter(),
         solver_(current_func, mod, &this->err_reporter) {
     CHECK(mod.defined()) << "internal error: Module must be set in the type inferencer";
@@ -118,6 +239,12 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
   // The current function being type checked.
   GlobalVar current_func_;
 
+  // Whether to reuse the checked types of unchanged subexpressions.
+  bool incremental_;
+
+  // Subexpressions whose checked type cannot be reused, see ContextDependenceCollector.
+  std::unordered_set<const Object*> context_dependent_;
+
   // The error reporter.
   ErrorReporter err_reporter;
 
@@ -150,12 +277,41 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
     if (it != type_map_.end() && it->second.checked_type.defined()) {
       return it->second.checked_type;
     }
+    if (TryReuseType(expr)) {
+      return type_map_[expr].checked_type;
+    }
+    // Populate nested dataflow nodes iteratively in post-DFS order,
+    // so that long chains of calls do not overflow the stack.
+    auto fcheck_visited = [this, &expr](const Expr& e) {
+      // Operators of primitive calls are typed from their call.
+      if (e.as<OpNode>() && !e.same_as(expr)) return true;
+      auto it = type_map_.find(e);
+      if (it != type_map_.end() && it->second.checked_type.defined()) return true;
+      return TryReuseType(e);
+    };
+    auto fvisit_leaf = [this](const Expr& e) { this->PopulateType(e); };
+    ExpandDataflow(expr, fcheck_visited, fvisit_leaf);
+    return type_map_[expr].checked_type;
+  }
+
+  // Record the checked type of expr from a previous inference, if it can be reused.
+  bool TryReuseType(const Expr& expr) {
+    if (!incremental_ || context_dependent_.count(expr.get()) || !CanReuseCheckedType(expr)) {
+      return false;
+    }
+    ResolvedTypeInfo& rti = type_map_[expr];
+    rti.checked_type = expr->checked_type_;
+    rti.reused = true;
+    return true;
+  }
+
+  // Visit expr and record its type.
+  void PopulateType(const Expr& expr) {
     Type ret = this->VisitExpr(expr);
     CHECK(ret.defined());
     KindCheck(ret, mod_);
     ResolvedTypeInfo& rti = type_map_[expr];
     rti.checked_type = ret;
-    return ret;
   }
 
   void ReportFatalError(const ObjectRef& expr, const Error& err) {
@@ -554,11 +710,11 @@ class TypeInferencer : private ExprFunctor<Type(const Expr&)>,
   }
 };
 
-class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
+class TypeInferencer::Resolver : public MixedModeMutator, PatternMutator {
  public:
   Resolver(const std::unordered_map<Expr, ResolvedTypeInfo, ObjectPtrHash, ObjectPtrEqual>& tmap,
-           TypeSolver* solver)
-      : tmap_(tmap), solver_(solver) {}
+           TypeSolver* solver, bool incremental = false)
+      : tmap_(tmap), solver_(solver), incremental_(incremental) {}
 
   Expr VisitExpr_(const VarNode* op) final { return VisitVar(GetRef<Var>(op)); }
 
@@ -568,13 +724,15 @@ class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
 
   Expr VisitExpr_(const OpNode* op) final { return ExprMutator::VisitExpr_(op); }
 
-  Expr VisitExpr_(const TupleNode* op) final { return AttachCheckedType(op); }
+  Expr Rewrite_(const TupleNode* op, const Expr& post) final { return AttachCheckedType(op, post); }
 
-  Expr VisitExpr_(const TupleGetItemNode* op) final { return AttachCheckedType(op); }
+  Expr Rewrite_(const TupleGetItemNode* op, const Expr& post) final {
+    return AttachCheckedType(op, post);
+  }
 
   Expr VisitExpr_(const FunctionNode* op) final { return AttachCheckedType(op); }
 
-  Expr VisitExpr_(const CallNode* op) final { return AttachCheckedType(op); }
+  Expr Rewrite_(const CallNode* op, const Expr& post) final { return AttachCheckedType(op, post); }
 
   Expr VisitExpr_(const LetNode* op) final { return AttachCheckedType(op); }
 
@@ -592,16 +750,47 @@ class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
 
   Pattern VisitPattern(const Pattern& p) final { return PatternMutator::VisitPattern(p); }
 
+  // Reused expressions are kept as they are, without visiting their children.
+  bool CheckVisited(const Expr& expr) final {
+    if (memo_.count(expr)) return true;
+    auto it = tmap_.find(expr);
+    if (it != tmap_.end() && it->second.reused) {
+      memo_[expr] = expr;
+      return true;
+    }
+    return false;
+  }
+
   Var VisitVar(const Var& v) final {
     if (vmap_.count(v) == 0) {
-      vmap_[v] = GetRef<Var>(AttachCheckedType(v.as<VarNode>()).as<VarNode>());
+      if (incremental_ && KeepVar(v)) {
+        vmap_[v] = v;
+      } else {
+        vmap_[v] = GetRef<Var>(AttachCheckedType(v.as<VarNode>()).as<VarNode>());
+      }
     }
     return vmap_.at(v);
   }
 
+  // Reused expressions refer to the original variables, so a variable
+  // whose type is its annotation must keep its identity.
+  bool KeepVar(const Var& v) {
+    if (!v->type_annotation.defined()) return false;
+    auto it = tmap_.find(v);
+    CHECK(it != tmap_.end());
+    Type checked_type = solver_->Resolve(it->second.checked_type);
+    if (!StructuralEqual()(checked_type, v->type_annotation)) return false;
+    if (!v->checked_type_.defined()) {
+      // The type is determined by the annotation, so setting it in place is safe.
+      v->checked_type_ = checked_type;
+    }
+    return true;
+  }
+
   // attach checked type to the mutated node.
+  // post is the node with mutated children, if it is already computed.
   template <typename T>
-  Expr AttachCheckedType(const T* op) {
+  Expr AttachCheckedType(const T* op, const Expr& post = Expr()) {
     auto it = tmap_.find(GetRef<Expr>(op));
     CHECK(it != tmap_.end());
     Type checked_type = solver_->Resolve(it->second.checked_type);
@@ -611,7 +800,7 @@ class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
     CHECK(checked_type.as<IncompleteTypeNode>() == nullptr)
         << "Cannot resolve type of " << GetRef<Expr>(op) << " at " << op->span;
 
-    Expr new_e = ExprMutator::VisitExpr_(op);
+    Expr new_e = post.defined() ? post : ExprMutator::VisitExpr_(op);
     // new_call and new_var's code is only going to be valid for VarNode/CallNode.
     // Compiler optimization will likely fold these away for other nodes.
     CallNode* new_call = (std::is_base_of<CallNode, T>::value
@@ -681,12 +870,17 @@ class TypeInferencer::Resolver : public ExprMutator, PatternMutator {
   std::unordered_map<Var, Var, ObjectPtrHash, ObjectPtrEqual> vmap_;
   const std::unordered_map<Expr, ResolvedTypeInfo, ObjectPtrHash, ObjectPtrEqual>& tmap_;
   TypeSolver* solver_;
+  // whether reused expressions may refer to the variables.
+  bool incremental_;
   // whether attach the checked type as type_annotation
   // if original type anntation is missing.
   bool update_missing_type_annotation_{true};
 };
 
 Expr TypeInferencer::Infer(Expr expr) {
+  if (incremental_) {
+    context_dependent_ = ContextDependenceCollector::Collect(expr);
+  }
   // Step 1: Populate the constraints.
   GetType(expr);
 
@@ -694,7 +888,7 @@ Expr TypeInferencer::Infer(Expr expr) {
   Solve();
 
   // Step 3: Attach resolved types to checked_type field.
-  auto resolved_expr = Resolver(type_map_, &solver_).VisitExpr(expr);
+  auto resolved_expr = Resolver(type_map_, &solver_, incremental_).VisitExpr(expr);
   CHECK(WellFormed(resolved_expr));
   return resolved_expr;
 }
@@ -717,9 +911,16 @@ struct AllCheckTypePopulated : ExprVisitor {
 
 void EnsureCheckedType(const Expr& e) { AllCheckTypePopulated().VisitExpr(e); }
 
+// Whether the current pass context enables incremental type inference.
+bool IncrementalInferType() {
+  return transform::PassContext::Current()
+      ->GetConfig<Bool>("relay.InferType.incremental", Bool(false))
+      .value();
+}
+
 Expr InferType(const Expr& expr, const IRModule& mod) {
   auto main = mod->GetGlobalVar("main");
-  auto inferencer = TypeInferencer(mod, main);
+  auto inferencer = TypeInferencer(mod, main, IncrementalInferType());
   auto e = inferencer.Infer(expr);
   CHECK(WellFormed(e));
   auto free_tvars = FreeTypeVars(e, mod);
@@ -733,7 +934,7 @@ Function InferType(const Function& func, const IRModule& mod, const GlobalVar& v
   Function func_copy = Function(make_object<FunctionNode>(*func.operator->()));
   func_copy->checked_type_ = func_copy->func_type_annotation();
   mod->AddUnchecked(var, func_copy);
-  Expr func_ret = TypeInferencer(mod, var).Infer(func_copy);
+  Expr func_ret = TypeInferencer(mod, var, IncrementalInferType()).Infer(func_copy);
   mod->Remove(var);
   CHECK(WellFormed(func_ret));
   auto free_tvars = FreeTypeVars(func_ret, mod);
@@ -0,0 +1,468 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file batching_runtime.cc
+ * \brief Dynamic request batching on top of the graph runtime and the VM.
+ *
+ *  Requests are submitted from any number of threads. A single worker
+ *  thread coalesces pending requests along axis 0 until either the maximum
+ *  batch size is reached or the oldest request has waited for the timeout,
+ *  runs the underlying executor once and scatters the outputs back.
+ *
+ *  A blocking submit does not release the Python GIL with the Cython FFI, so
+ *  Python threads calling submit run one at a time and are not coalesced.
+ *  Python callers queue several requests at once with submit_many instead.
+ *
+ *  Two backends are supported through their PackedFunc interface:
+ *   - A set of graph runtime modules compiled for fixed batch sizes
+ *     ("buckets"). The smallest bucket that fits is used and the batch is
+ *     zero padded up to the bucket size.
+ *   - A relay VM whose function has an Any batch dimension.
+ */
+#include <dmlc/logging.h>
+#include <tvm/runtime/container.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Runtime module that batches concurrent requests to an executor.
+ */
+class BatchingRuntime : public ModuleNode {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param max_batch_size The maximum number of rows run in one batch.
+   * \param timeout_us How long the oldest pending request may wait, in microseconds.
+   */
+  BatchingRuntime(int64_t max_batch_size, int64_t timeout_us)
+      : max_batch_size_(max_batch_size), timeout_(timeout_us) {
+    CHECK_GT(max_batch_size_, 0) << "max_batch_size must be positive";
+    CHECK_GE(timeout_us, 0) << "timeout must be non-negative";
+  }
+
+  ~BatchingRuntime() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    queue_cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+  }
+
+  const char* type_key() const final { return "BatchingRuntime"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "submit") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::vector<NDArray> inputs;
+        for (int i = 0; i < args.num_args; ++i) {
+          inputs.push_back(args[i].operator NDArray());
+        }
+        *rv = this->Submit(inputs);
+      });
+    } else if (name == "submit_many") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        CHECK_GE(args.num_args, 1) << "Expect the number of inputs per request";
+        int num_inputs = args[0];
+        CHECK_GT(num_inputs, 0) << "A request must have at least one input";
+        CHECK_EQ((args.num_args - 1) % num_inputs, 0)
+            << "Expect " << num_inputs << " inputs for every request";
+        std::vector<std::vector<NDArray>> requests;
+        for (int i = 1; i < args.num_args; i += num_inputs) {
+          std::vector<NDArray> inputs;
+          for (int j = 0; j < num_inputs; ++j) {
+            inputs.push_back(args[i + j].operator NDArray());
+          }
+          requests.push_back(inputs);
+        }
+        *rv = this->SubmitMany(requests);
+      });
+    } else if (name == "get_num_batches") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *rv = num_batches_;
+      });
+    } else {
+      return PackedFunc();
+    }
+  }
+
+  /*!
+   * \brief Add a graph runtime compiled for a fixed batch size.
+   * \param batch_size The batch size (axis 0 extent) of all inputs and outputs.
+   * \param mod The graph runtime module.
+   */
+  void AddGraphBucket(int64_t batch_size, Module mod) {
+    CHECK(vm_invoke_ == nullptr) << "Cannot mix graph runtime buckets with a VM";
+    CHECK_GT(batch_size, 0);
+    GraphBucket bucket;
+    bucket.batch_size = batch_size;
+    bucket.set_input = mod.GetFunction("set_input");
+    bucket.run = mod.GetFunction("run");
+    bucket.get_output = mod.GetFunction("get_output");
+    PackedFunc get_num_outputs = mod.GetFunction("get_num_outputs");
+    CHECK(bucket.set_input != nullptr && bucket.run != nullptr && bucket.get_output != nullptr &&
+          get_num_outputs != nullptr)
+        << "Bucket module does not expose the graph runtime interface";
+    bucket.num_outputs = get_num_outputs();
+    bucket.mod = mod;
+    buckets_.push_back(bucket);
+    std::sort(buckets_.begin(), buckets_.end(),
+              [](const GraphBucket& a, const GraphBucket& b) { return a.batch_size < b.batch_size; });
+  }
+
+  /*!
+   * \brief Use a VM whose function accepts any batch size.
+   * \param mod The VirtualMachine module, already initialized.
+   * \param func_name The function to invoke.
+   */
+  void SetVM(Module mod, const std::string& func_name) {
+    CHECK(buckets_.empty()) << "Cannot mix graph runtime buckets with a VM";
+    vm_ = mod;
+    vm_func_name_ = func_name;
+    vm_set_input_ = mod.GetFunction("set_input");
+    vm_invoke_ = mod.GetFunction("invoke");
+    CHECK(vm_set_input_ != nullptr && vm_invoke_ != nullptr)
+        << "Module does not expose the VM interface";
+  }
+
+  /*! \brief Start the worker thread. Must be called once after configuration. */
+  void Start() {
+    CHECK(!buckets_.empty() || vm_invoke_ != nullptr) << "No executor configured";
+    if (!buckets_.empty()) {
+      CHECK_LE(max_batch_size_, buckets_.back().batch_size)
+          << "max_batch_size " << max_batch_size_ << " exceeds the largest bucket "
+          << buckets_.back().batch_size;
+    }
+    worker_ = std::thread([this]() { this->WorkerLoop(); });
+  }
+
+  /*!
+   * \brief Submit one request and block until its outputs are ready.
+   * \param inputs The inputs, all on CPU and sharing the same extent on axis 0.
+   * \return The outputs of this request.
+   */
+  Array<NDArray> Submit(const std::vector<NDArray>& inputs) {
+    std::shared_ptr<Request> req = MakeRequest(inputs);
+    this->EnqueueAndWait({req});
+    return Array<NDArray>(req->outputs.begin(), req->outputs.end());
+  }
+
+  /*!
+   * \brief Submit several requests at once and block until all outputs are ready.
+   *  The requests are queued together, so they are coalesced even when the
+   *  caller cannot submit from several threads.
+   * \param requests The inputs of each request.
+   * \return The outputs of each request.
+   */
+  Array<ObjectRef> SubmitMany(const std::vector<std::vector<NDArray>>& requests) {
+    std::vector<std::shared_ptr<Request>> reqs;
+    for (const auto& inputs : requests) {
+      reqs.push_back(MakeRequest(inputs));
+    }
+    this->EnqueueAndWait(reqs);
+    std::vector<ObjectRef> ret;
+    for (const auto& req : reqs) {
+      ret.push_back(Array<NDArray>(req->outputs.begin(), req->outputs.end()));
+    }
+    return Array<ObjectRef>(ret.begin(), ret.end());
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    std::vector<NDArray> inputs;
+    std::vector<NDArray> outputs;
+    int64_t batch{0};
+    Clock::time_point arrival;
+    std::string error;
+    bool done{false};
+  };
+
+  std::shared_ptr<Request> MakeRequest(const std::vector<NDArray>& inputs) {
+    CHECK(!inputs.empty()) << "A request must have at least one input";
+    auto req = std::make_shared<Request>();
+    for (const NDArray& arr : inputs) {
+      CHECK_EQ(arr->ctx.device_type, kDLCPU) << "Batched inputs must reside on the CPU";
+      CHECK_GE(arr->ndim, 1) << "Batched inputs must have a batch axis";
+      CHECK(arr.IsContiguous()) << "Batched inputs must be contiguous";
+      CHECK_EQ(arr->shape[0], inputs[0]->shape[0])
+          << "All inputs of one request must have the same batch size";
+    }
+    req->inputs = inputs;
+    req->batch = inputs[0]->shape[0];
+    return req;
+  }
+
+  /*! \brief Queue the requests together and wait until all of them are done. */
+  void EnqueueAndWait(const std::vector<std::shared_ptr<Request>>& reqs) {
+    if (reqs.empty()) return;
+    Clock::time_point arrival = Clock::now();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      CHECK(!stop_) << "BatchingRuntime is shutting down";
+      for (const auto& req : reqs) {
+        req->arrival = arrival;
+        queue_.push_back(req);
+        pending_rows_ += req->batch;
+      }
+    }
+    queue_cv_.notify_one();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_cv_.wait(lock, [&reqs]() {
+        return std::all_of(reqs.begin(), reqs.end(),
+                           [](const std::shared_ptr<Request>& req) { return req->done; });
+      });
+    }
+    for (const auto& req : reqs) {
+      if (!req->error.empty()) {
+        LOG(FATAL) << req->error;
+      }
+    }
+  }
+
+  struct GraphBucket {
+    int64_t batch_size;
+    int num_outputs;
+    Module mod;
+    PackedFunc set_input;
+    PackedFunc run;
+    PackedFunc get_output;
+  };
+
+  void WorkerLoop() {
+    while (true) {
+      std::vector<std::shared_ptr<Request>> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) return;
+        Clock::time_point deadline = queue_.front()->arrival + timeout_;
+        queue_cv_.wait_until(lock, deadline,
+                             [this]() { return stop_ || pending_rows_ >= max_batch_size_; });
+        int64_t rows = 0;
+        while (!queue_.empty() &&
+               (batch.empty() || rows + queue_.front()->batch <= max_batch_size_)) {
+          rows += queue_.front()->batch;
+          batch.push_back(queue_.front());
+          queue_.pop_front();
+        }
+        pending_rows_ -= rows;
+        ++num_batches_;
+      }
+      try {
+        this->RunBatch(batch);
+      } catch (const std::exception& e) {
+        for (auto& req : batch) {
+          req->outputs.clear();
+          req->error = e.what();
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& req : batch) req->done = true;
+      }
+      done_cv_.notify_all();
+    }
+  }
+
+  /*!
+   * \brief Concatenate the index-th input of all requests along axis 0.
+   * \param batch The requests.
+   * \param index The input index.
+   * \param padded_rows The extent of axis 0 of the result, padded with zeros.
+   */
+  NDArray Gather(const std::vector<std::shared_ptr<Request>>& batch, size_t index,
+                 int64_t padded_rows) {
+    const NDArray& first = batch[0]->inputs[index];
+    std::vector<int64_t> shape = first.Shape();
+    shape[0] = padded_rows;
+    NDArray ret = NDArray::Empty(shape, first->dtype, first->ctx);
+    size_t row_bytes = GetDataSize(*first.operator->()) / std::max<int64_t>(first->shape[0], 1);
+    char* dst = static_cast<char*>(ret->data);
+    size_t offset = 0;
+    for (const auto& req : batch) {
+      CHECK_EQ(req->inputs.size(), batch[0]->inputs.size())
+          << "Batched requests must have the same number of inputs";
+      const DLTensor* t = req->inputs[index].operator->();
+      CHECK_EQ(t->ndim, first->ndim) << "Input " << index << " has mismatched rank";
+      CHECK(t->dtype.code == first->dtype.code && t->dtype.bits == first->dtype.bits &&
+            t->dtype.lanes == first->dtype.lanes)
+          << "Input " << index << " has mismatched dtype";
+      for (int i = 1; i < t->ndim; ++i) {
+        CHECK_EQ(t->shape[i], first->shape[i]) << "Input " << index << " has mismatched shape";
+      }
+      size_t nbytes = row_bytes * t->shape[0];
+      std::memcpy(dst + offset, static_cast<const char*>(t->data) + t->byte_offset, nbytes);
+      offset += nbytes;
+    }
+    std::memset(dst + offset, 0, row_bytes * padded_rows - offset);
+    return ret;
+  }
+
+  /*!
+   * \brief Split one batched output along axis 0 into the requests.
+   * \param batch The requests.
+   * \param out The batched output.
+   */
+  void Scatter(const std::vector<std::shared_ptr<Request>>& batch, NDArray out) {
+    TVMContext cpu_ctx{kDLCPU, 0};
+    if (out->ctx.device_type != kDLCPU) {
+      out = out.CopyTo(cpu_ctx);
+    }
+    CHECK_GE(out->ndim, 1) << "Batched outputs must have a batch axis";
+    std::vector<int64_t> shape = out.Shape();
+    size_t row_bytes = GetDataSize(*out.operator->()) / std::max<int64_t>(shape[0], 1);
+    const char* src = static_cast<const char*>(out->data) + out->byte_offset;
+    for (const auto& req : batch) {
+      shape[0] = req->batch;
+      NDArray part = NDArray::Empty(shape, out->dtype, cpu_ctx);
+      size_t nbytes = row_bytes * req->batch;
+      std::memcpy(part->data, src, nbytes);
+      src += nbytes;
+      req->outputs.push_back(part);
+    }
+  }
+
+  void RunBatch(const std::vector<std::shared_ptr<Request>>& batch) {
+    int64_t rows = 0;
+    for (const auto& req : batch) rows += req->batch;
+    size_t num_inputs = batch[0]->inputs.size();
+
+    if (vm_invoke_ != nullptr) {
+      std::vector<NDArray> batched;
+      for (size_t i = 0; i < num_inputs; ++i) {
+        batched.push_back(Gather(batch, i, rows));
+      }
+      std::vector<TVMValue> values(num_inputs + 1);
+      std::vector<int> codes(num_inputs + 1);
+      TVMArgsSetter setter(values.data(), codes.data());
+      setter(0, vm_func_name_);
+      for (size_t i = 0; i < num_inputs; ++i) {
+        setter(i + 1, batched[i]);
+      }
+      TVMRetValue rv;
+      vm_set_input_.CallPacked(TVMArgs(values.data(), codes.data(), values.size()), &rv);
+      ObjectRef ret = vm_invoke_(vm_func_name_);
+      if (const auto* adt = ret.as<ADTObj>()) {
+        for (size_t i = 0; i < adt->size; ++i) {
+          NDArray out = Downcast<NDArray>((*adt)[i]);
+          Scatter(batch, out);
+        }
+      } else {
+        Scatter(batch, Downcast<NDArray>(ret));
+      }
+      return;
+    }
+
+    auto it = std::find_if(buckets_.begin(), buckets_.end(),
+                           [rows](const GraphBucket& b) { return b.batch_size >= rows; });
+    CHECK(it != buckets_.end()) << "No graph runtime bucket can hold a batch of " << rows;
+    const GraphBucket& bucket = *it;
+    for (size_t i = 0; i < num_inputs; ++i) {
+      NDArray input = Gather(batch, i, bucket.batch_size);
+      bucket.set_input(static_cast<int>(i), input);
+    }
+    bucket.run();
+    for (int i = 0; i < bucket.num_outputs; ++i) {
+      NDArray out = bucket.get_output(i);
+      Scatter(batch, out);
+    }
+  }
+
+  /*! \brief The maximum number of rows in one batch. */
+  int64_t max_batch_size_;
+  /*! \brief How long the oldest request may wait for others. */
+  std::chrono::microseconds timeout_;
+  /*! \brief Graph runtime buckets sorted by batch size. */
+  std::vector<GraphBucket> buckets_;
+  /*! \brief The VM module when batching over a dynamic batch dimension. */
+  Module vm_;
+  /*! \brief The VM function to invoke. */
+  std::string vm_func_name_;
+  /*! \brief The VM set_input function. */
+  PackedFunc vm_set_input_;
+  /*! \brief The VM invoke function. */
+  PackedFunc vm_invoke_;
+  /*! \brief Protects the queue, the counters and the request states. */
+  std::mutex mutex_;
+  /*! \brief Signaled when requests are queued or on shutdown. */
+  std::condition_variable queue_cv_;
+  /*! \brief Signaled when a batch finished. */
+  std::condition_variable done_cv_;
+  /*! \brief Pending requests in arrival order. */
+  std::deque<std::shared_ptr<Request>> queue_;
+  /*! \brief Total rows of the pending requests. */
+  int64_t pending_rows_{0};
+  /*! \brief Number of batches run so far. */
+  int64_t num_batches_{0};
+  /*! \brief Whether the runtime is shutting down. */
+  bool stop_{false};
+  /*! \brief The worker thread. */
+  std::thread worker_;
+};
+
+TVM_REGISTER_GLOBAL("tvm.batching_runtime.create_graph")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      CHECK_GE(args.num_args, 4) << "Expect max_batch_size, timeout_us and at least one "
+                                    "(batch_size, module) bucket";
+      CHECK_EQ(args.num_args % 2, 0) << "Buckets must be given as (batch_size, module) pairs";
+      int64_t max_batch_size = args[0];
+      int64_t timeout_us = args[1];
+      auto exec = make_object<BatchingRuntime>(max_batch_size, timeout_us);
+      for (int i = 2; i < args.num_args; i += 2) {
+        int64_t batch_size = args[i];
+        Module mod = args[i + 1];
+        exec->AddGraphBucket(batch_size, mod);
+      }
+      exec->Start();
+      *rv = Module(exec);
+    });
+
+TVM_REGISTER_GLOBAL("tvm.batching_runtime.create_vm")
+    .set_body_typed([](int64_t max_batch_size, int64_t timeout_us, Module vm,
+                       std::string func_name) {
+      auto exec = make_object<BatchingRuntime>(max_batch_size, timeout_us);
+      exec->SetVM(vm, func_name);
+      exec->Start();
+      return Module(exec);
+    });
+
+}  // namespace runtime
+}  // namespace tvm
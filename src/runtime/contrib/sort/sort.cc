@@ -22,9 +22,13 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <cstring>
+#include <exception>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -32,14 +36,270 @@ namespace contrib {
 
 using namespace runtime;
 
+/*! \brief Rows shorter than this are sorted with std::stable_sort instead of a radix sort. */
+constexpr int64_t kRadixSortMinSize = 256;
+/*! \brief topk selects with a heap when k times this is at most the row size. */
+constexpr int64_t kTopKSelectRatio = 16;
+/*! \brief The number of elements below which all rows are sorted in the calling thread. */
+constexpr int64_t kParallelMinElems = 1 << 15;
+
+// NaN is ordered above every number, so it is last in ascending and first in descending order,
+// whatever its sign. The radix keys follow the same order.
+template <typename DType>
+inline bool IsNaN(DType value) {
+  return value != value;
+}
+
 template <typename DType>
 bool CompareAscend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
-  return lhs.second < rhs.second;
+  return !IsNaN(lhs.second) && (IsNaN(rhs.second) || lhs.second < rhs.second);
 }
 
 template <typename DType>
 bool CompareDescend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
-  return lhs.second > rhs.second;
+  return !IsNaN(rhs.second) && (IsNaN(lhs.second) || lhs.second > rhs.second);
+}
+
+// The orders of a stable sort, for the selections that are not stable.
+template <typename DType>
+bool CompareAscendStable(const std::pair<int64_t, DType>& lhs,
+                         const std::pair<int64_t, DType>& rhs) {
+  return CompareAscend(lhs, rhs) || (!CompareAscend(rhs, lhs) && lhs.first < rhs.first);
+}
+
+template <typename DType>
+bool CompareDescendStable(const std::pair<int64_t, DType>& lhs,
+                          const std::pair<int64_t, DType>& rhs) {
+  return CompareDescend(lhs, rhs) || (!CompareDescend(rhs, lhs) && lhs.first < rhs.first);
+}
+
+/*!
+ * \brief Map a key to an unsigned integer with the same order, so it can be radix sorted.
+ *  Types without a specialization are sorted by comparison.
+ */
+template <typename DType>
+struct RadixKey {
+  static constexpr bool kEnabled = false;
+  using Type = uint32_t;
+  static Type Get(DType value) { return 0; }
+};
+
+template <>
+struct RadixKey<float> {
+  static constexpr bool kEnabled = true;
+  using Type = uint32_t;
+  static Type Get(float value) {
+    // -0.0 and 0.0 compare equal, keep them in their input order.
+    if (value == 0) value = 0;
+    if (IsNaN(value)) return ~0u;
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+};
+
+template <>
+struct RadixKey<double> {
+  static constexpr bool kEnabled = true;
+  using Type = uint64_t;
+  static Type Get(double value) {
+    if (value == 0) value = 0;
+    if (IsNaN(value)) return ~0ull;
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+  }
+};
+
+template <>
+struct RadixKey<int32_t> {
+  static constexpr bool kEnabled = true;
+  using Type = uint32_t;
+  static Type Get(int32_t value) { return static_cast<uint32_t>(value) ^ 0x80000000u; }
+};
+
+template <>
+struct RadixKey<int64_t> {
+  static constexpr bool kEnabled = true;
+  using Type = uint64_t;
+  static Type Get(int64_t value) {
+    return static_cast<uint64_t>(value) ^ 0x8000000000000000ull;
+  }
+};
+
+/*!
+ * \brief Sorts the rows of a tensor into (index, value) pairs, in the order of std::stable_sort.
+ *  The buffers are kept across rows, so a sorter allocates only when a row is longer than the
+ *  previous ones.
+ */
+template <typename DType>
+class RowSorter {
+ public:
+  using Entry = std::pair<int64_t, DType>;
+
+  /*!
+   * \brief Sort the first n elements of a row.
+   * \param row The first element of the row.
+   * \param stride The distance between the elements of the row.
+   * \param n The number of elements to sort.
+   * \param is_ascend Whether to sort in ascending order.
+   */
+  void Sort(const DType* row, int64_t stride, int64_t n, bool is_ascend) {
+    if (RadixKey<DType>::kEnabled && n >= kRadixSortMinSize) {
+      RadixSort(row, stride, n, is_ascend);
+      return;
+    }
+    Load(row, stride, n);
+    if (is_ascend) {
+      std::stable_sort(entries_.begin(), entries_.end(), CompareAscend<DType>);
+    } else {
+      std::stable_sort(entries_.begin(), entries_.end(), CompareDescend<DType>);
+    }
+  }
+
+  /*!
+   * \brief Put the first k elements of the sorted row in the first k entries, in order.
+   *  Small k select with a heap in O(n log k) instead of sorting the row.
+   */
+  void SelectTopK(const DType* row, int64_t stride, int64_t n, int64_t k, bool is_ascend) {
+    if (k * kTopKSelectRatio > n) {
+      Sort(row, stride, n, is_ascend);
+      return;
+    }
+    Load(row, stride, n);
+    if (is_ascend) {
+      std::partial_sort(entries_.begin(), entries_.begin() + k, entries_.end(),
+                        CompareAscendStable<DType>);
+    } else {
+      std::partial_sort(entries_.begin(), entries_.begin() + k, entries_.end(),
+                        CompareDescendStable<DType>);
+    }
+  }
+
+  /*! \return The sorted entries. */
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  using KeyType = typename RadixKey<DType>::Type;
+  static constexpr int kNumDigits = sizeof(KeyType);
+
+  void Load(const DType* row, int64_t stride, int64_t n) {
+    entries_.resize(n);
+    for (int64_t i = 0; i < n; ++i) {
+      entries_[i] = Entry(i, row[i * stride]);
+    }
+  }
+
+  // LSD radix sort on bytes, it is stable so the equal keys keep the input order.
+  void RadixSort(const DType* row, int64_t stride, int64_t n, bool is_ascend) {
+    keys_.resize(n);
+    keys_tmp_.resize(n);
+    // The histograms of all the digits are counted in one pass over the keys.
+    int64_t counts[kNumDigits][256];
+    std::memset(counts, 0, sizeof(counts));
+    KeyType flip = is_ascend ? 0 : ~KeyType(0);
+    for (int64_t i = 0; i < n; ++i) {
+      KeyType key = RadixKey<DType>::Get(row[i * stride]) ^ flip;
+      keys_[i] = std::make_pair(key, i);
+      for (int d = 0; d < kNumDigits; ++d) {
+        ++counts[d][(key >> (d * 8)) & 0xff];
+      }
+    }
+    for (int d = 0; d < kNumDigits; ++d) {
+      int64_t* count = counts[d];
+      // All keys share this digit, the pass would not move anything.
+      if (count[(keys_[0].first >> (d * 8)) & 0xff] == n) continue;
+      int64_t offset = 0;
+      for (int b = 0; b < 256; ++b) {
+        int64_t c = count[b];
+        count[b] = offset;
+        offset += c;
+      }
+      for (int64_t i = 0; i < n; ++i) {
+        keys_tmp_[count[(keys_[i].first >> (d * 8)) & 0xff]++] = keys_[i];
+      }
+      keys_.swap(keys_tmp_);
+    }
+    entries_.resize(n);
+    for (int64_t i = 0; i < n; ++i) {
+      int64_t index = keys_[i].second;
+      entries_[i] = Entry(index, row[index * stride]);
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<std::pair<KeyType, int64_t>> keys_;
+  std::vector<std::pair<KeyType, int64_t>> keys_tmp_;
+};
+
+/*!
+ * \brief Call f(sorter, row) for each of num_rows rows of row_size elements. Large inputs are
+ *  split over the runtime thread pool, with one RowSorter per task.
+ */
+template <typename DType, typename F>
+void ParallelForRows(int64_t num_rows, int64_t row_size, const F& f) {
+  if (num_rows <= 1 || num_rows * row_size < kParallelMinElems) {
+    RowSorter<DType> sorter;
+    for (int64_t r = 0; r < num_rows; ++r) {
+      f(&sorter, r);
+    }
+    return;
+  }
+  struct Closure {
+    const F* f;
+    int64_t num_rows;
+  };
+  Closure closure{&f, num_rows};
+  auto task = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+    const Closure* closure = static_cast<const Closure*>(cdata);
+    int64_t chunk = (closure->num_rows + penv->num_task - 1) / penv->num_task;
+    int64_t end = std::min(closure->num_rows, (task_id + 1) * chunk);
+    // Exceptions must not leave a worker thread, report them to the launching thread.
+    try {
+      RowSorter<DType> sorter;
+      for (int64_t r = task_id * chunk; r < end; ++r) {
+        (*closure->f)(&sorter, r);
+      }
+    } catch (const std::exception& e) {
+      TVMAPISetLastError(e.what());
+      return -1;
+    }
+    return 0;
+  };
+  CHECK_EQ(TVMBackendParallelLaunch(task, &closure, 0), 0) << TVMGetLastError();
+}
+
+template <typename DType>
+void argsort_nms(DLTensor* input, DLTensor* sort_num, DLTensor* output, int32_t axis,
+                 bool is_ascend) {
+  auto data_ptr = static_cast<DType*>(input->data);
+  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
+  auto out_ptr = static_cast<int32_t*>(output->data);
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
+  for (int i = 0; i < input->ndim; ++i) {
+    if (i < axis) {
+      axis_mul_before *= input->shape[i];
+    } else if (i > axis) {
+      axis_mul_after *= input->shape[i];
+    }
+  }
+  int64_t axis_size = input->shape[axis];
+
+  auto sort_row = [&](RowSorter<DType>* sorter, int64_t row) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t current_sort_num =
+        std::max<int64_t>(0, std::min<int64_t>(sort_num_ptr[row], axis_size));
+    int64_t base_idx = i * axis_size * axis_mul_after + j;
+    sorter->Sort(data_ptr + base_idx, axis_mul_after, current_sort_num, is_ascend);
+    const auto& entries = sorter->entries();
+    for (int64_t k = 0; k < axis_size; ++k) {
+      out_ptr[base_idx + k * axis_mul_after] =
+          static_cast<int32_t>(k < current_sort_num ? entries[k].first : k);
+    }
+  };
+  ParallelForRows<DType>(axis_mul_before * axis_mul_after, axis_size, sort_row);
 }
 
 // Argsort implemented C library sort for nms.
@@ -57,12 +317,6 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   bool is_ascend = args[4];
 
   auto dtype = input->dtype;
-  auto data_ptr = static_cast<float*>(input->data);
-  auto sort_num_ptr = static_cast<int32_t*>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
-  int64_t axis_mul_before = 1;
-  int64_t axis_mul_after = 1;
-
   if (axis < 0) {
     axis = input->ndim + axis;
   }
@@ -78,60 +332,22 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
                                  "input ndim "
                               << input->ndim;
 
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
-
-  for (int64_t i = 0; i < axis_mul_before; ++i) {
-    for (int64_t j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < current_sort_num; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, *(data_ptr + full_idx)));
-      }
-      if (is_ascend) {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<float>);
 #if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      } else {
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        if (dtype.bits == 16) {
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<__fp16>);
-        } else {
-#endif
-          std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<float>);
-#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
-        }
-#endif
-      }
-      for (int32_t k = 0; k < input->shape[axis]; ++k) {
-        *(static_cast<int32_t*>(output->data) + base_idx + k * axis_mul_after) =
-            k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
-      }
-    }
+  if (dtype.bits == 16) {
+    argsort_nms<__fp16>(input, sort_num, output, axis, is_ascend);
+    return;
   }
+#endif
+  argsort_nms<float>(input, sort_num, output, axis, is_ascend);
 });
 
 template <typename DataType, typename OutType>
 void argsort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -139,25 +355,19 @@ void argsort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
       axis_mul_after *= input->shape[i];
     }
   }
+  int64_t axis_size = input->shape[axis];
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
-      }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>(sorter[k].first);
-      }
+  auto sort_row = [&](RowSorter<DataType>* sorter, int64_t row) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t base_idx = i * axis_size * axis_mul_after + j;
+    sorter->Sort(data_ptr + base_idx, axis_mul_after, axis_size, is_ascend);
+    const auto& entries = sorter->entries();
+    for (int64_t k = 0; k < axis_size; ++k) {
+      out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>(entries[k].first);
     }
-  }
+  };
+  ParallelForRows<DataType>(axis_mul_before * axis_mul_after, axis_size, sort_row);
 }
 
 // Argsort implemented C library sort.
@@ -251,10 +461,9 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
+  int64_t axis_mul_before = 1;
+  int64_t axis_mul_after = 1;
   for (int i = 0; i < input->ndim; ++i) {
     if (i < axis) {
       axis_mul_before *= input->shape[i];
@@ -262,36 +471,29 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       axis_mul_after *= input->shape[i];
     }
   }
+  int64_t axis_size = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_size;
   }
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-      for (int64_t kk = 0; kk < input->shape[axis]; ++kk) {
-        int64_t full_idx = src_base_idx + kk * axis_mul_after;
-        sorter.emplace_back(std::make_pair(kk, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+  auto select_row = [&](RowSorter<DataType>* sorter, int64_t row) {
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t src_base_idx = i * axis_size * axis_mul_after + j;
+    int64_t dst_base_idx = i * k * axis_mul_after + j;
+    sorter->SelectTopK(data_ptr + src_base_idx, axis_mul_after, axis_size, k, is_ascend);
+    const auto& entries = sorter->entries();
+    for (int64_t kk = 0; kk < k; ++kk) {
+      if (indices_ptr != nullptr) {
+        indices_ptr[dst_base_idx + kk * axis_mul_after] =
+            static_cast<IndicesType>(entries[kk].first);
       }
-      int64_t cnt = k > 0 ? k : input->shape[axis];
-      for (int64_t kk = 0; kk < cnt; ++kk) {
-        if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(sorter[kk].first);
-        }
-        if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
-        }
+      if (values_ptr != nullptr) {
+        values_ptr[dst_base_idx + kk * axis_mul_after] = entries[kk].second;
       }
     }
-  }
+  };
+  ParallelForRows<DataType>(axis_mul_before * axis_mul_after, axis_size, select_row);
 }
 
 // Argsort implemented C library sort.
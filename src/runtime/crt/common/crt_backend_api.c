@@ -27,16 +27,60 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/crt/memory.h>
 
+static TVMStaticWorkspace* static_workspace = NULL;
+
+void TVMStaticWorkspace_Init(TVMStaticWorkspace* workspace, uint8_t* data, size_t size,
+                             size_t alignment) {
+  workspace->data = data;
+  workspace->size = size;
+  workspace->alignment = alignment;
+  workspace->used = 0;
+  workspace->peak = 0;
+}
+
+TVMStaticWorkspace* TVMSetStaticWorkspace(TVMStaticWorkspace* workspace) {
+  TVMStaticWorkspace* previous = static_workspace;
+  static_workspace = workspace;
+  return previous;
+}
+
+static void* StaticWorkspaceAlloc(TVMStaticWorkspace* workspace, uint64_t nbytes) {
+  uint64_t size = (nbytes + workspace->alignment - 1) & ~((uint64_t)workspace->alignment - 1);
+  if (size > workspace->size - workspace->used) {
+    TVMAPISetLastError("static workspace is too small");
+    return NULL;
+  }
+  void* ptr = workspace->data + workspace->used;
+  workspace->used += size;
+  if (workspace->used > workspace->peak) {
+    workspace->peak = workspace->used;
+  }
+  return ptr;
+}
+
 void* TVMBackendAllocWorkspace(int device_type, int device_id, uint64_t nbytes, int dtype_code_hint,
                                int dtype_bits_hint) {
   void* ptr = 0;
   assert(nbytes > 0);
+  if (static_workspace != NULL) {
+    return StaticWorkspaceAlloc(static_workspace, nbytes);
+  }
   unsigned int dtype_bytes = dtype_bits_hint / 8;
   ptr = vmalloc(nbytes * dtype_bytes);
   return ptr;
 }
 
 int TVMBackendFreeWorkspace(int device_type, int device_id, void* ptr) {
+  if (static_workspace != NULL) {
+    // Workspaces are freed in reverse order, so ptr is the top of the stack.
+    uint8_t* top = (uint8_t*)ptr;  // NOLINT(*)
+    if (top < static_workspace->data || top >= static_workspace->data + static_workspace->used) {
+      TVMAPISetLastError("workspace was not allocated from the static workspace");
+      return -1;
+    }
+    static_workspace->used = top - static_workspace->data;
+    return 0;
+  }
   vfree(ptr);
   return 0;
 }
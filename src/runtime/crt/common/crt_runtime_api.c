@@ -243,8 +243,14 @@ static int FindFunctionOrSetAPIError(tvm_module_index_t module_index,
 }
 
 int TVMFuncGetGlobal(const char* name, TVMFunctionHandle* out) {
-  return FindFunctionOrSetAPIError(kGlobalFuncModuleIndex, &global_func_registry.registry, name,
-                                   out);
+  tvm_function_index_t function_index;
+  if (TVMMutableFuncRegistry_Lookup(&global_func_registry, name, &function_index) != 0) {
+    TVMAPIErrorf("failed to get global function: name=%s", name);
+    return -1;
+  }
+
+  *out = EncodeFunctionHandle(kGlobalFuncModuleIndex, function_index);
+  return 0;
 }
 
 int TVMModGetFunction(TVMModuleHandle mod, const char* func_name, int query_imports,
@@ -93,6 +93,21 @@ tvm_crt_error_t TVMFuncRegistry_GetByIndex(const TVMFuncRegistry* reg,
   return kTvmErrorNoError;
 }
 
+/*!
+ * \brief FNV-1a hash of a function name.
+ * \param name The function name.
+ * \return The hash.
+ */
+static uint32_t HashName(const char* name) {
+  uint32_t hash = 2166136261u;
+  while (*name != 0) {
+    hash = (hash ^ (uint8_t)*name) * 16777619u;
+    name++;
+  }
+
+  return hash;
+}
+
 tvm_crt_error_t TVMMutableFuncRegistry_Create(TVMMutableFuncRegistry* reg, uint8_t* buffer,
                                               size_t buffer_size_bytes) {
   if (buffer_size_bytes < kTvmAverageFuncEntrySizeBytes) {
@@ -108,45 +123,100 @@ tvm_crt_error_t TVMMutableFuncRegistry_Create(TVMMutableFuncRegistry* reg, uint8
   //  - assume average function name is around ~10 bytes
   //  - 1 byte for \0
   //  - size of 1 function pointer
+  //  - offset of the name and the hash buckets
   reg->max_functions = buffer_size_bytes / kTvmAverageFuncEntrySizeBytes;
+  if (reg->max_functions > TVM_MUTABLE_FUNC_REGISTRY_MAX_FUNCTIONS) {
+    reg->max_functions = TVM_MUTABLE_FUNC_REGISTRY_MAX_FUNCTIONS;
+  }
+
+  // From the end of buffer: function pointers, name offsets, then hash buckets.
   reg->registry.funcs =
       (TVMBackendPackedCFunc*)(buffer + buffer_size_bytes - reg->max_functions * sizeof(void*));
+  reg->name_offsets =
+      (uint16_t*)(((uint8_t*)reg->registry.funcs) - reg->max_functions * sizeof(uint16_t));
+  reg->num_buckets = reg->max_functions * TVM_MUTABLE_FUNC_REGISTRY_BUCKETS_PER_FUNCTION;
+  reg->buckets = ((uint8_t*)reg->name_offsets) - reg->num_buckets;
+  memset(reg->buckets, 0, reg->num_buckets);
 
   return kTvmErrorNoError;
 }
 
+tvm_crt_error_t TVMMutableFuncRegistry_Lookup(const TVMMutableFuncRegistry* reg, const char* name,
+                                              tvm_function_index_t* function_index) {
+  size_t bucket;
+  size_t num_probes;
+  uint8_t entry;
+
+  bucket = HashName(name) % reg->num_buckets;
+  // NOTE: at most half of the buckets are used, so an empty bucket ends each probe sequence.
+  for (num_probes = 0; num_probes < reg->num_buckets; num_probes++) {
+    entry = reg->buckets[bucket];
+    if (entry == 0) {
+      break;
+    }
+
+    if (!strcmp(reg->registry.names + reg->name_offsets[entry - 1], name)) {
+      *function_index = entry - 1;
+      return kTvmErrorNoError;
+    }
+
+    bucket++;
+    if (bucket == reg->num_buckets) {
+      bucket = 0;
+    }
+  }
+
+  return kTvmErrorFunctionNameNotFound;
+}
+
 tvm_crt_error_t TVMMutableFuncRegistry_Set(TVMMutableFuncRegistry* reg, const char* name,
                                            TVMBackendPackedCFunc func, int override) {
-  size_t idx;
+  tvm_function_index_t idx;
   char* reg_name_ptr;
+  size_t bucket;
 
-  idx = 0;
-  // NOTE: safe to discard const qualifier here, since reg->registry.names was set from
-  // TVMMutableFuncRegistry_Create above.
-  // NOTE: reg_name_ptr starts at index 1 to skip num_funcs.
-  for (reg_name_ptr = (char*)reg->registry.names + 1; *reg_name_ptr != 0; reg_name_ptr++) {
-    if (!strcmp_cursor((const char**)&reg_name_ptr, name)) {
-      if (override == 0) {
-        return kTvmErrorFunctionAlreadyDefined;
-      }
-      ((TVMBackendPackedCFunc*)reg->registry.funcs)[idx] = func;
-      return kTvmErrorNoError;
+  if (TVMMutableFuncRegistry_Lookup(reg, name, &idx) == kTvmErrorNoError) {
+    if (override == 0) {
+      return kTvmErrorFunctionAlreadyDefined;
     }
+    ((TVMBackendPackedCFunc*)reg->registry.funcs)[idx] = func;
+    return kTvmErrorNoError;
+  }
 
-    idx++;
+  // NOTE: safe to discard const qualifier here, since reg->registry.names was set from
+  // TVMMutableFuncRegistry_Create above.
+  idx = (uint8_t)reg->registry.names[0];
+  if (idx == 0) {
+    // NOTE: reg_name_ptr starts at index 1 to skip num_funcs.
+    reg_name_ptr = (char*)reg->registry.names + 1;
+  } else {
+    reg_name_ptr = (char*)reg->registry.names + reg->name_offsets[idx - 1];
+    reg_name_ptr += strlen(reg_name_ptr) + 1;
   }
 
+  // The name is followed by its \0 and the end of names list marker.
   size_t name_len = strlen(name);
-  ssize_t names_bytes_remaining = ((const char*)reg->registry.funcs) - reg_name_ptr;
-  if (idx >= reg->max_functions || name_len + 1 > names_bytes_remaining) {
+  ssize_t names_bytes_remaining = ((const char*)reg->buckets) - reg_name_ptr;
+  if (idx >= reg->max_functions || name_len + 2 > names_bytes_remaining ||
+      reg_name_ptr - reg->registry.names > UINT16_MAX) {
     return kTvmErrorFunctionRegistryFull;
   }
 
   memcpy(reg_name_ptr, name, name_len + 1);
+  reg->name_offsets[idx] = (uint16_t)(reg_name_ptr - reg->registry.names);
   reg_name_ptr += name_len + 1;
   *reg_name_ptr = 0;
   ((TVMBackendPackedCFunc*)reg->registry.funcs)[idx] = func;
   ((char*)reg->registry.names)[0]++;  // increment num_funcs.
 
+  bucket = HashName(name) % reg->num_buckets;
+  while (reg->buckets[bucket] != 0) {
+    bucket++;
+    if (bucket == reg->num_buckets) {
+      bucket = 0;
+    }
+  }
+  reg->buckets[bucket] = (uint8_t)(idx + 1);
+
   return kTvmErrorNoError;
 }
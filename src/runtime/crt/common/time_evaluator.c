@@ -0,0 +1,246 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file src/runtime/crt/common/time_evaluator.c
+ * \brief Time functions on the device with the platform timer.
+ */
+
+#include <limits.h>
+#include <tvm/runtime/crt/memory.h>
+#include <tvm/runtime/crt/platform.h>
+#include <tvm/runtime/crt/time_evaluator.h>
+
+/*! \brief The most timing rounds of one repeat, it bounds the growth of `number` when the
+ *  timer does not reach `min_repeat_ms`. */
+#define TVM_CRT_TIME_EVALUATOR_MAX_ROUNDS 20
+
+// The RPC server registers the time evaluator on every platform. These defaults let platforms
+// without a timer link, timing then fails with an error.
+int __attribute__((weak)) TVMPlatformTimerStart(void) { return -1; }
+
+int __attribute__((weak)) TVMPlatformTimerStop(double* res_us) { return -1; }
+
+int TVMTimeEvaluator_Run(TVMFunctionHandle func, TVMValue* args, int* type_codes, int num_args,
+                         int number, int repeat, int min_repeat_ms, TVMFunctionHandle f_preproc,
+                         double* results) {
+  TVMValue ret_value;
+  int ret_type_code;
+  double duration_us;
+  double min_repeat_us;
+  double grown_number;
+  double needed_number;
+  int round;
+  int err;
+  int i;
+  int j;
+
+  min_repeat_us = min_repeat_ms * 1000.0;
+  for (i = 0; i < repeat; i++) {
+    if (f_preproc != NULL) {
+      err = TVMFuncCall(f_preproc, args, type_codes, num_args, &ret_value, &ret_type_code);
+      if (err != 0) {
+        return err;
+      }
+    }
+
+    duration_us = 0;
+    round = 0;
+    do {
+      if (round > 0) {
+        if (round == TVM_CRT_TIME_EVALUATOR_MAX_ROUNDS) {
+          TVMAPISetLastError("time evaluator: the timer did not reach min_repeat_ms");
+          return -1;
+        }
+        if (duration_us > 0) {
+          // Grow like the host time evaluator.
+          grown_number = number * 1.618;
+          needed_number = min_repeat_us / (duration_us / number) + 1;
+          if (needed_number > grown_number) {
+            grown_number = needed_number;
+          }
+        } else {
+          // The calls take less than one tick of the timer.
+          grown_number = number * 2.0;
+        }
+        if (grown_number > INT_MAX) {
+          TVMAPISetLastError("time evaluator: too many calls to reach min_repeat_ms");
+          return -1;
+        }
+        number = (int)grown_number;
+      }
+      round++;
+
+      if (TVMPlatformTimerStart() != 0) {
+        TVMAPISetLastError("time evaluator: failed to start the timer");
+        return -1;
+      }
+      for (j = 0; j < number; j++) {
+        err = TVMFuncCall(func, args, type_codes, num_args, &ret_value, &ret_type_code);
+        if (err != 0) {
+          TVMPlatformTimerStop(&duration_us);
+          return err;
+        }
+      }
+      if (TVMPlatformTimerStop(&duration_us) != 0) {
+        TVMAPISetLastError("time evaluator: failed to stop the timer");
+        return -1;
+      }
+    } while (duration_us < min_repeat_us);
+
+    results[i] = duration_us / number / 1e6;
+  }
+
+  return 0;
+}
+
+/*!
+ * \brief Look up the function to time from the leading (mod, name) arguments.
+ * \param args The arguments.
+ * \param type_codes The type codes of the arguments.
+ * \param func Receives the function.
+ * \return 0 on success.
+ */
+static int GetTimedFunction(TVMValue* args, int* type_codes, TVMFunctionHandle* func) {
+  if (type_codes[1] != kTVMStr) {
+    TVMAPISetLastError("time evaluator: expected a function name");
+    return -1;
+  }
+
+  if (type_codes[0] == kTVMNullptr) {
+    return TVMFuncGetGlobal(args[1].v_str, func);
+  } else if (type_codes[0] == kTVMModuleHandle) {
+    return TVMModGetFunction(args[0].v_handle, args[1].v_str, 1, func);
+  }
+
+  TVMAPISetLastError("time evaluator: expected a module or null");
+  return -1;
+}
+
+static int CallRepeated(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                        int* ret_type_code, void* resource_handle) {
+  TVMFunctionHandle func;
+  double result;
+  int err;
+
+  if (num_args < 3 || type_codes[2] != kDLInt || args[2].v_int64 <= 0) {
+    TVMAPISetLastError("CallRepeated: expected (module, name, number > 0, args...)");
+    return -1;
+  }
+
+  err = GetTimedFunction(args, type_codes, &func);
+  if (err != 0) {
+    return err;
+  }
+
+  err = TVMTimeEvaluator_Run(func, args + 3, type_codes + 3, num_args - 3, (int)args[2].v_int64, 1,
+                             0, NULL, &result);
+  if (err != 0) {
+    return err;
+  }
+
+  ret_value->v_float64 = result;
+  *ret_type_code = kDLFloat;
+  return 0;
+}
+
+/*! \brief The result of the last TimeEvaluate, it is returned by reference. */
+static TVMByteArray g_time_evaluate_result;
+static size_t g_time_evaluate_capacity;
+
+static int TimeEvaluate(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                        int* ret_type_code, void* resource_handle) {
+  TVMFunctionHandle func;
+  TVMFunctionHandle f_preproc;
+  TVMValue warmup_ret_value;
+  int warmup_ret_type_code;
+  int64_t repeat;
+  size_t result_size;
+  int err;
+
+  if (num_args < 6 || type_codes[2] != kDLInt || type_codes[3] != kDLInt ||
+      type_codes[4] != kDLInt || type_codes[5] != kTVMStr || args[2].v_int64 <= 0 ||
+      args[3].v_int64 <= 0) {
+    TVMAPISetLastError(
+        "TimeEvaluate: expected (module, name, number > 0, repeat > 0, min_repeat_ms, "
+        "f_preproc_name, args...)");
+    return -1;
+  }
+
+  err = GetTimedFunction(args, type_codes, &func);
+  if (err != 0) {
+    return err;
+  }
+
+  f_preproc = NULL;
+  if (args[5].v_str[0] != 0) {
+    err = TVMFuncGetGlobal(args[5].v_str, &f_preproc);
+    if (err != 0) {
+      return err;
+    }
+  }
+
+  repeat = args[3].v_int64;
+  result_size = repeat * sizeof(double);
+  if (result_size > g_time_evaluate_capacity) {
+    if (g_time_evaluate_result.data != NULL) {
+      vfree((void*)g_time_evaluate_result.data);
+    }
+    g_time_evaluate_result.data = (const char*)vmalloc(result_size);
+    if (g_time_evaluate_result.data == NULL) {
+      g_time_evaluate_capacity = 0;
+      TVMAPISetLastError("TimeEvaluate: out of memory");
+      return -1;
+    }
+    g_time_evaluate_capacity = result_size;
+  }
+
+  // Skip the first call, like the host time evaluator.
+  err = TVMFuncCall(func, args + 6, type_codes + 6, num_args - 6, &warmup_ret_value,
+                    &warmup_ret_type_code);
+  if (err != 0) {
+    return err;
+  }
+
+  err = TVMTimeEvaluator_Run(func, args + 6, type_codes + 6, num_args - 6, (int)args[2].v_int64,
+                             (int)repeat, (int)args[4].v_int64, f_preproc,
+                             (double*)g_time_evaluate_result.data);
+  if (err != 0) {
+    return err;
+  }
+
+  g_time_evaluate_result.size = result_size;
+  ret_value->v_handle = &g_time_evaluate_result;
+  *ret_type_code = kTVMBytes;
+  return 0;
+}
+
+tvm_crt_error_t TVMTimeEvaluator_RegisterGlobals(void) {
+  int err;
+
+  err = TVMFuncRegisterGlobal("tvm.rpc.server.CallRepeated", (TVMFunctionHandle)&CallRepeated, 0);
+  if (err != 0) {
+    return (tvm_crt_error_t)err;
+  }
+
+  return (tvm_crt_error_t)TVMFuncRegisterGlobal("tvm.rpc.server.TimeEvaluate",
+                                                (TVMFunctionHandle)&TimeEvaluate, 0);
+}
@@ -0,0 +1,275 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file binary_graph_runtime.c
+ * \brief Run a precomputed binary graph in place, without parsing or allocating.
+ */
+#include <string.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/binary_graph_runtime.h>
+
+#define ALIGN_UP(value, alignment) (((value) + ((alignment)-1)) & ~((uintptr_t)(alignment)-1))
+
+static const uint8_t* GraphBytes(const TVMBinaryGraphHeader* graph) {
+  return (const uint8_t*)graph;  // NOLINT(*)
+}
+
+static const void* GraphSection(const TVMBinaryGraphHeader* graph, uint32_t offset) {
+  return GraphBytes(graph) + offset;
+}
+
+static const char* GraphString(const TVMBinaryGraphHeader* graph, uint32_t offset) {
+  return (const char*)(GraphBytes(graph) + graph->strings_offset + offset);  // NOLINT(*)
+}
+
+// Whether a table of count items of item_size bytes at offset fits in the graph.
+static int SectionFits(const TVMBinaryGraphHeader* graph, uint32_t offset, uint64_t count,
+                       size_t item_size) {
+  return offset <= graph->total_size && count <= (graph->total_size - offset) / item_size;
+}
+
+static tvm_crt_error_t ValidateGraph(const TVMBinaryGraphHeader* graph, size_t graph_size) {
+  uint32_t idx;
+  if (graph_size < sizeof(TVMBinaryGraphHeader) || graph->magic != TVM_BINARY_GRAPH_MAGIC ||
+      graph->version != TVM_BINARY_GRAPH_VERSION || graph->total_size > graph_size ||
+      graph->alignment < 8 || (graph->alignment & (graph->alignment - 1)) != 0) {
+    return kTvmErrorGraphRuntimeInvalidGraph;
+  }
+  if (((uintptr_t)graph) % graph->alignment != 0) {
+    return kTvmErrorGraphRuntimeMisaligned;
+  }
+  if (!SectionFits(graph, graph->tensors_offset, graph->num_tensors,
+                   sizeof(TVMBinaryGraphTensor)) ||
+      !SectionFits(graph, graph->storages_offset, graph->num_storages,
+                   sizeof(TVMBinaryGraphStorage)) ||
+      !SectionFits(graph, graph->inputs_offset, graph->num_inputs, sizeof(TVMBinaryGraphInput)) ||
+      !SectionFits(graph, graph->outputs_offset, graph->num_outputs, sizeof(uint32_t)) ||
+      !SectionFits(graph, graph->ops_offset, graph->num_ops, sizeof(TVMBinaryGraphOp)) ||
+      !SectionFits(graph, graph->op_args_offset, graph->num_op_args, sizeof(uint32_t)) ||
+      !SectionFits(graph, graph->params_offset, graph->num_params, sizeof(TVMBinaryGraphParam)) ||
+      graph->strings_offset > graph->total_size || graph->shapes_offset > graph->total_size) {
+    return kTvmErrorGraphRuntimeInvalidGraph;
+  }
+  // The shapes are used in place as int64_t, the graph itself is aligned to at least 8 bytes.
+  if (graph->shapes_offset % sizeof(int64_t) != 0) {
+    return kTvmErrorGraphRuntimeMisaligned;
+  }
+  // The string table is the last section, so every name is terminated.
+  if (graph->strings_offset < graph->total_size && GraphBytes(graph)[graph->total_size - 1] != 0) {
+    return kTvmErrorGraphRuntimeInvalidGraph;
+  }
+  const TVMBinaryGraphTensor* tensors = GraphSection(graph, graph->tensors_offset);
+  for (idx = 0; idx < graph->num_tensors; ++idx) {
+    if ((tensors[idx].storage_id >= graph->num_storages &&
+         tensors[idx].storage_id != TVM_BINARY_GRAPH_PARAM_STORAGE) ||
+        !SectionFits(graph, graph->shapes_offset,
+                     (uint64_t)tensors[idx].shape_index + tensors[idx].ndim, sizeof(int64_t))) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const TVMBinaryGraphStorage* storages = GraphSection(graph, graph->storages_offset);
+  for (idx = 0; idx < graph->num_storages; ++idx) {
+    if (storages[idx].offset > graph->workspace_size ||
+        storages[idx].size > graph->workspace_size - storages[idx].offset) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const TVMBinaryGraphOp* ops = GraphSection(graph, graph->ops_offset);
+  for (idx = 0; idx < graph->num_ops; ++idx) {
+    if (ops[idx].arg_begin > graph->num_op_args ||
+        ops[idx].num_args > graph->num_op_args - ops[idx].arg_begin ||
+        ops[idx].func_name_offset >= graph->total_size - graph->strings_offset) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const uint32_t* op_args = GraphSection(graph, graph->op_args_offset);
+  for (idx = 0; idx < graph->num_op_args; ++idx) {
+    if (op_args[idx] >= graph->num_tensors) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const TVMBinaryGraphParam* params = GraphSection(graph, graph->params_offset);
+  for (idx = 0; idx < graph->num_params; ++idx) {
+    if (params[idx].tensor_id >= graph->num_tensors ||
+        !SectionFits(graph, params[idx].data_offset, params[idx].nbytes, 1)) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const TVMBinaryGraphInput* inputs = GraphSection(graph, graph->inputs_offset);
+  for (idx = 0; idx < graph->num_inputs; ++idx) {
+    if (inputs[idx].tensor_id >= graph->num_tensors ||
+        inputs[idx].name_offset >= graph->total_size - graph->strings_offset) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  const uint32_t* outputs = GraphSection(graph, graph->outputs_offset);
+  for (idx = 0; idx < graph->num_outputs; ++idx) {
+    if (outputs[idx] >= graph->num_tensors) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  return kTvmErrorNoError;
+}
+
+size_t TVMBinaryGraphRuntime_MemorySize(const void* graph_ptr, size_t graph_size) {
+  const TVMBinaryGraphHeader* graph = (const TVMBinaryGraphHeader*)graph_ptr;  // NOLINT(*)
+  if (graph_size < sizeof(TVMBinaryGraphHeader) || graph->magic != TVM_BINARY_GRAPH_MAGIC ||
+      graph->version != TVM_BINARY_GRAPH_VERSION || graph->alignment == 0 ||
+      (graph->alignment & (graph->alignment - 1)) != 0) {
+    return 0;
+  }
+  // Padding to align the workspace, the kernel workspace, then the tables, each aligned to 8 bytes.
+  return (graph->alignment - 1) + ALIGN_UP(graph->workspace_size, graph->alignment) +
+         ALIGN_UP(graph->kernel_workspace_size, 8) +
+         ALIGN_UP(sizeof(DLTensor) * graph->num_tensors, 8) +
+         ALIGN_UP(sizeof(TVMFunctionHandle) * graph->num_ops, 8) +
+         ALIGN_UP(sizeof(TVMValue) * graph->num_op_args, 8) +
+         ALIGN_UP(sizeof(int) * graph->num_op_args, 8);
+}
+
+tvm_crt_error_t TVMBinaryGraphRuntime_Init(TVMBinaryGraphRuntime* runtime, const void* graph_ptr,
+                                           size_t graph_size, TVMModuleHandle module,
+                                           DLContext ctx, uint8_t* memory, size_t memory_size) {
+  const TVMBinaryGraphHeader* graph = (const TVMBinaryGraphHeader*)graph_ptr;  // NOLINT(*)
+  uint32_t idx;
+  tvm_crt_error_t err = ValidateGraph(graph, graph_size);
+  if (err != kTvmErrorNoError) {
+    return err;
+  }
+  if (memory_size < TVMBinaryGraphRuntime_MemorySize(graph, graph_size)) {
+    return kTvmErrorGraphRuntimeMemoryTooSmall;
+  }
+  // Carve the caller memory.
+  uintptr_t cursor = ALIGN_UP((uintptr_t)memory, graph->alignment);
+  runtime->graph = graph;
+  runtime->workspace = (uint8_t*)cursor;  // NOLINT(*)
+  cursor += ALIGN_UP(graph->workspace_size, graph->alignment);
+  TVMStaticWorkspace_Init(&runtime->kernel_workspace, (uint8_t*)cursor,  // NOLINT(*)
+                          graph->kernel_workspace_size, graph->alignment);
+  cursor += ALIGN_UP(graph->kernel_workspace_size, 8);
+  runtime->tensors = (DLTensor*)cursor;  // NOLINT(*)
+  cursor += ALIGN_UP(sizeof(DLTensor) * graph->num_tensors, 8);
+  runtime->op_funcs = (TVMFunctionHandle*)cursor;  // NOLINT(*)
+  cursor += ALIGN_UP(sizeof(TVMFunctionHandle) * graph->num_ops, 8);
+  runtime->arg_values = (TVMValue*)cursor;  // NOLINT(*)
+  cursor += ALIGN_UP(sizeof(TVMValue) * graph->num_op_args, 8);
+  runtime->arg_type_codes = (int*)cursor;  // NOLINT(*)
+
+  // Tensors point to their storage in the workspace, shapes point into the graph.
+  const TVMBinaryGraphTensor* tensors = GraphSection(graph, graph->tensors_offset);
+  const TVMBinaryGraphStorage* storages = GraphSection(graph, graph->storages_offset);
+  const int64_t* shapes = GraphSection(graph, graph->shapes_offset);
+  for (idx = 0; idx < graph->num_tensors; ++idx) {
+    const TVMBinaryGraphTensor* entry = tensors + idx;
+    DLTensor* tensor = runtime->tensors + idx;
+    tensor->data = entry->storage_id == TVM_BINARY_GRAPH_PARAM_STORAGE
+                       ? NULL
+                       : runtime->workspace + storages[entry->storage_id].offset;
+    tensor->ctx = ctx;
+    tensor->ndim = (int)entry->ndim;  // NOLINT(*)
+    tensor->dtype.code = entry->dtype_code;
+    tensor->dtype.bits = entry->dtype_bits;
+    tensor->dtype.lanes = entry->dtype_lanes;
+    tensor->shape = (int64_t*)(shapes + entry->shape_index);  // NOLINT(*)
+    tensor->strides = NULL;
+    tensor->byte_offset = 0;
+  }
+  // Params are used in place.
+  const TVMBinaryGraphParam* params = GraphSection(graph, graph->params_offset);
+  for (idx = 0; idx < graph->num_params; ++idx) {
+    runtime->tensors[params[idx].tensor_id].data = (void*)(GraphBytes(graph) +  // NOLINT(*)
+                                                           params[idx].data_offset);
+  }
+  for (idx = 0; idx < graph->num_tensors; ++idx) {
+    if (runtime->tensors[idx].data == NULL) {
+      return kTvmErrorGraphRuntimeInvalidGraph;
+    }
+  }
+  // Arguments of the ops.
+  const uint32_t* op_args = GraphSection(graph, graph->op_args_offset);
+  for (idx = 0; idx < graph->num_op_args; ++idx) {
+    runtime->arg_values[idx].v_handle = runtime->tensors + op_args[idx];
+    runtime->arg_type_codes[idx] = kTVMNDArrayHandle;
+  }
+  const TVMBinaryGraphOp* ops = GraphSection(graph, graph->ops_offset);
+  for (idx = 0; idx < graph->num_ops; ++idx) {
+    const char* name = GraphString(graph, ops[idx].func_name_offset);
+    int status = module != NULL ? TVMModGetFunction(module, name, 0, runtime->op_funcs + idx)
+                                : TVMFuncGetGlobal(name, runtime->op_funcs + idx);
+    if (status != 0) {
+      return kTvmErrorFunctionNameNotFound;
+    }
+  }
+  return kTvmErrorNoError;
+}
+
+int TVMBinaryGraphRuntime_GetInputIndex(const TVMBinaryGraphRuntime* runtime, const char* name) {
+  const TVMBinaryGraphHeader* graph = runtime->graph;
+  const TVMBinaryGraphInput* inputs = GraphSection(graph, graph->inputs_offset);
+  uint32_t idx;
+  for (idx = 0; idx < graph->num_inputs; ++idx) {
+    if (!strcmp(GraphString(graph, inputs[idx].name_offset), name)) {
+      return (int)idx;  // NOLINT(*)
+    }
+  }
+  return -1;
+}
+
+DLTensor* TVMBinaryGraphRuntime_GetInput(TVMBinaryGraphRuntime* runtime, uint32_t index) {
+  const TVMBinaryGraphHeader* graph = runtime->graph;
+  if (index >= graph->num_inputs) {
+    return NULL;
+  }
+  const TVMBinaryGraphInput* inputs = GraphSection(graph, graph->inputs_offset);
+  return runtime->tensors + inputs[index].tensor_id;
+}
+
+DLTensor* TVMBinaryGraphRuntime_GetOutput(TVMBinaryGraphRuntime* runtime, uint32_t index) {
+  const TVMBinaryGraphHeader* graph = runtime->graph;
+  if (index >= graph->num_outputs) {
+    return NULL;
+  }
+  const uint32_t* outputs = GraphSection(graph, graph->outputs_offset);
+  return runtime->tensors + outputs[index];
+}
+
+int TVMBinaryGraphRuntime_Run(TVMBinaryGraphRuntime* runtime) {
+  const TVMBinaryGraphHeader* graph = runtime->graph;
+  const TVMBinaryGraphOp* ops = GraphSection(graph, graph->ops_offset);
+  uint32_t idx;
+  int status = 0;
+  TVMStaticWorkspace* previous = NULL;
+  if (graph->kernel_workspace_size > 0) {
+    previous = TVMSetStaticWorkspace(&runtime->kernel_workspace);
+  }
+  for (idx = 0; idx < graph->num_ops && status == 0; ++idx) {
+    TVMValue ret_value;
+    int ret_type_code;
+    status = TVMFuncCall(runtime->op_funcs[idx], runtime->arg_values + ops[idx].arg_begin,
+                         runtime->arg_type_codes + ops[idx].arg_begin, ops[idx].num_args,
+                         &ret_value, &ret_type_code);
+  }
+  if (graph->kernel_workspace_size > 0) {
+    TVMSetStaticWorkspace(previous);
+  }
+  return status;
+}
@@ -22,7 +22,6 @@
  * \brief Framing for RPC.
  */
 
-#include <checksum.h>
 #include <string.h>
 #include <tvm/runtime/crt/logging.h>
 #include <tvm/runtime/crt/rpc_common/framing.h>
@@ -45,10 +44,57 @@ namespace tvm {
 namespace runtime {
 namespace micro_rpc {
 
+namespace {
+
+// CRC-CCITT (polynomial 0x1021) tables for slicing by 4, built at compile time so they live in
+// flash. kCrcTables.t[k][i] is the CRC of the byte i followed by k zero bytes, starting from 0.
+struct CrcTables {
+  uint16_t t[4][256];
+};
+
+template <size_t... I>
+struct IndexSequence {};
+template <size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+template <size_t... I>
+struct MakeIndexSequence<0, I...> : IndexSequence<I...> {};
+
+constexpr uint16_t CrcShift(uint16_t crc, int bits) {
+  return bits == 0 ? crc
+                   : CrcShift(static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021
+                                                                   : crc << 1),
+                              bits - 1);
+}
+
+constexpr uint16_t CrcByte(size_t value) { return CrcShift(static_cast<uint16_t>(value << 8), 8); }
+
+constexpr uint16_t CrcZeros(uint16_t crc, int num_zeros) {
+  return num_zeros == 0
+             ? crc
+             : CrcZeros(static_cast<uint16_t>((crc << 8) ^ CrcByte(crc >> 8)), num_zeros - 1);
+}
+
+template <size_t... I>
+constexpr CrcTables MakeCrcTables(IndexSequence<I...>) {
+  return CrcTables{{{CrcByte(I)...},
+                    {CrcZeros(CrcByte(I), 1)...},
+                    {CrcZeros(CrcByte(I), 2)...},
+                    {CrcZeros(CrcByte(I), 3)...}}};
+}
+
+constexpr CrcTables kCrcTables = MakeCrcTables(MakeIndexSequence<256>{});
+
+}  // namespace
+
 uint16_t crc16_compute(const uint8_t* data, size_t data_size_bytes, uint16_t* previous_crc) {
   uint16_t crc = (previous_crc != nullptr ? *previous_crc : 0xffff);
-  for (size_t i = 0; i < data_size_bytes; ++i) {
-    crc = update_crc_ccitt(crc, data[i]);
+  const uint16_t(*t)[256] = kCrcTables.t;
+  for (; data_size_bytes >= 4; data_size_bytes -= 4, data += 4) {
+    crc = t[3][(crc >> 8) ^ data[0]] ^ t[2][(crc & 0xff) ^ data[1]] ^ t[1][data[2]] ^
+          t[0][data[3]];
+  }
+  for (; data_size_bytes > 0; --data_size_bytes, ++data) {
+    crc = static_cast<uint16_t>(crc << 8) ^ t[0][(crc >> 8) ^ *data];
   }
 
   return crc;
@@ -131,42 +177,58 @@ tvm_crt_error_t Unframer::ConsumeInput(uint8_t* buffer, size_t buffer_size_bytes
                                        size_t* bytes_filled, bool update_crc) {
   CHECK(*bytes_filled < buffer_size_bytes);
   tvm_crt_error_t to_return = kTvmErrorNoError;
-  size_t i;
-  for (i = 0; i < input_size_bytes_; ++i) {
-    uint8_t c = input_[i];
-    if (saw_escape_start_) {
-      saw_escape_start_ = false;
-      if (c == to_integral(Escape::kPacketStart)) {
-        // When the start packet sequence is seen, abort unframing the current packet. Since the
-        // escape byte has already been parsed, update the CRC include only the escape byte. This
-        // readies the unframer to consume the kPacketStart byte on the next Write() call.
-        uint8_t escape_start = to_integral(Escape::kEscapeStart);
-        crc_ = crc16_compute(&escape_start, 1, nullptr);
-        to_return = kTvmErrorFramingShortPacket;
-        saw_escape_start_ = true;
-
+  size_t i = 0;
+  while (i < input_size_bytes_) {
+    if (!saw_escape_start_) {
+      // Copy the bytes up to the next escape code at once.
+      size_t run = input_size_bytes_ - i;
+      if (run > buffer_size_bytes - *bytes_filled) {
+        run = buffer_size_bytes - *bytes_filled;
+      }
+      const void* escape = memchr(input_ + i, to_integral(Escape::kEscapeStart), run);
+      if (escape != nullptr) {
+        run = static_cast<const uint8_t*>(escape) - (input_ + i);
+      }
+      memcpy(buffer + *bytes_filled, input_ + i, run);
+      *bytes_filled += run;
+      i += run;
+      if (*bytes_filled == buffer_size_bytes) {
         break;
-      } else if (c == to_integral(Escape::kEscapeNop)) {
-        continue;
-      } else if (c == to_integral(Escape::kEscapeStart)) {
-        // do nothing (allow character to be printed)
-      } else {
-        // Invalid escape sequence.
-        to_return = kTvmErrorFramingInvalidEscape;
+      }
+      if (escape != nullptr) {
+        saw_escape_start_ = true;
         i++;
-        break;
       }
-    } else if (c == to_integral(Escape::kEscapeStart)) {
+      continue;
+    }
+
+    uint8_t c = input_[i];
+    saw_escape_start_ = false;
+    if (c == to_integral(Escape::kPacketStart)) {
+      // When the start packet sequence is seen, abort unframing the current packet. Since the
+      // escape byte has already been parsed, update the CRC include only the escape byte. This
+      // readies the unframer to consume the kPacketStart byte on the next Write() call.
+      uint8_t escape_start = to_integral(Escape::kEscapeStart);
+      crc_ = crc16_compute(&escape_start, 1, nullptr);
+      to_return = kTvmErrorFramingShortPacket;
       saw_escape_start_ = true;
+
+      break;
+    } else if (c == to_integral(Escape::kEscapeNop)) {
+      i++;
       continue;
-    } else {
-      saw_escape_start_ = false;
+    } else if (c != to_integral(Escape::kEscapeStart)) {
+      // Invalid escape sequence.
+      to_return = kTvmErrorFramingInvalidEscape;
+      i++;
+      break;
     }
 
+    // An escaped kEscapeStart is a data byte.
     buffer[*bytes_filled] = c;
     (*bytes_filled)++;
+    i++;
     if (*bytes_filled == buffer_size_bytes) {
-      i++;
       break;
     }
   }
@@ -207,6 +269,30 @@ tvm_crt_error_t Unframer::FindPacketLength() {
 tvm_crt_error_t Unframer::FindPacketCrc() {
   //  CHECK(num_buffer_bytes_valid_ == 0);
   while (num_payload_bytes_remaining_ > 0) {
+    if (num_buffer_bytes_valid_ == 0 && !saw_escape_start_) {
+      // Bytes up to the next escape code are passed downstream in place, without a copy.
+      size_t run = num_payload_bytes_remaining_;
+      if (run > input_size_bytes_) {
+        run = input_size_bytes_;
+      }
+      const void* escape = memchr(input_, to_integral(Escape::kEscapeStart), run);
+      if (escape != nullptr) {
+        run = static_cast<const uint8_t*>(escape) - input_;
+      }
+      if (run > 0) {
+        size_t bytes_consumed;
+        tvm_crt_error_t to_return = stream_->WriteAll(input_, run, &bytes_consumed);
+        crc_ = crc16_compute(input_, bytes_consumed, &crc_);
+        input_ += bytes_consumed;
+        input_size_bytes_ -= bytes_consumed;
+        num_payload_bytes_remaining_ -= bytes_consumed;
+        if (to_return != kTvmErrorNoError) {
+          return to_return;
+        }
+        continue;
+      }
+    }
+
     size_t num_bytes_to_buffer = num_payload_bytes_remaining_;
     if (num_bytes_to_buffer > sizeof(buffer_)) {
       num_bytes_to_buffer = sizeof(buffer_);
@@ -336,46 +422,77 @@ tvm_crt_error_t Framer::StartPacket(size_t payload_size_bytes) {
   return to_return;
 }
 
+tvm_crt_error_t Framer::WriteRaw(const uint8_t* data, size_t data_size_bytes, bool update_crc) {
+  size_t bytes_consumed;
+  tvm_crt_error_t to_return = stream_->WriteAll(data, data_size_bytes, &bytes_consumed);
+  if (to_return != kTvmErrorNoError) {
+    return to_return;
+  }
+
+  if (update_crc) {
+    crc_ = crc16_compute(data, data_size_bytes, &crc_);
+  }
+
+  return kTvmErrorNoError;
+}
+
 tvm_crt_error_t Framer::WriteAndCrc(const uint8_t* data, size_t data_size_bytes, bool escape,
                                     bool update_crc) {
+  uint8_t buffer[kMaxStackBufferSizeBytes];
+  size_t buffer_ptr = 0;
+  tvm_crt_error_t to_return;
   while (data_size_bytes > 0) {
-    uint8_t buffer[kMaxStackBufferSizeBytes];
-    size_t buffer_ptr = 0;
-    size_t i;
-    for (i = 0; i < data_size_bytes && buffer_ptr != kMaxStackBufferSizeBytes; ++i) {
-      uint8_t c = data[i];
-      if (!escape || c != to_integral(Escape::kEscapeStart)) {
-        buffer[buffer_ptr] = c;
-        buffer_ptr++;
-        continue;
-      }
-
-      if (buffer_ptr == kMaxStackBufferSizeBytes - 1) {
-        break;
+    size_t run = data_size_bytes;
+    if (escape) {
+      const void* found = memchr(data, to_integral(Escape::kEscapeStart), run);
+      if (found != nullptr) {
+        run = static_cast<const uint8_t*>(found) - data;
       }
-
-      buffer[buffer_ptr] = to_integral(Escape::kEscapeStart);
-      buffer_ptr++;
-
-      buffer[buffer_ptr] = to_integral(Escape::kEscapeStart);
-      buffer_ptr++;
     }
 
-    size_t bytes_consumed;
-    tvm_crt_error_t to_return = stream_->WriteAll(buffer, buffer_ptr, &bytes_consumed);
-    if (to_return != kTvmErrorNoError) {
-      return to_return;
+    if (run >= kMaxStackBufferSizeBytes) {
+      // Long runs without escape codes are written in place.
+      to_return = WriteRaw(buffer, buffer_ptr, update_crc);
+      if (to_return != kTvmErrorNoError) {
+        return to_return;
+      }
+      buffer_ptr = 0;
+      to_return = WriteRaw(data, run, update_crc);
+      if (to_return != kTvmErrorNoError) {
+        return to_return;
+      }
+    } else {
+      // Short runs are gathered with the escaped bytes in the stack buffer.
+      if (run > kMaxStackBufferSizeBytes - buffer_ptr) {
+        to_return = WriteRaw(buffer, buffer_ptr, update_crc);
+        if (to_return != kTvmErrorNoError) {
+          return to_return;
+        }
+        buffer_ptr = 0;
+      }
+      memcpy(buffer + buffer_ptr, data, run);
+      buffer_ptr += run;
     }
-
-    if (update_crc) {
-      crc_ = crc16_compute(buffer, buffer_ptr, &crc_);
+    data += run;
+    data_size_bytes -= run;
+
+    if (data_size_bytes > 0) {
+      // data[0] is an escape code, which is doubled on the wire.
+      if (kMaxStackBufferSizeBytes - buffer_ptr < 2) {
+        to_return = WriteRaw(buffer, buffer_ptr, update_crc);
+        if (to_return != kTvmErrorNoError) {
+          return to_return;
+        }
+        buffer_ptr = 0;
+      }
+      buffer[buffer_ptr++] = to_integral(Escape::kEscapeStart);
+      buffer[buffer_ptr++] = to_integral(Escape::kEscapeStart);
+      data++;
+      data_size_bytes--;
     }
-
-    data_size_bytes -= i;
-    data += i;
   }
 
-  return kTvmErrorNoError;
+  return WriteRaw(buffer, buffer_ptr, update_crc);
 }
 
 tvm_crt_error_t Framer::WritePayloadChunk(const uint8_t* payload_chunk,
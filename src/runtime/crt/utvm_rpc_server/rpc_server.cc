@@ -42,6 +42,7 @@
 #include <tvm/runtime/crt/rpc_common/frame_buffer.h>
 #include <tvm/runtime/crt/rpc_common/framing.h>
 #include <tvm/runtime/crt/rpc_common/session.h>
+#include <tvm/runtime/crt/time_evaluator.h>
 #include <tvm/runtime/crt/utvm_rpc_server.h>
 
 #include "../../minrpc/minrpc_server.h"
@@ -203,6 +204,11 @@ utvm_rpc_server_t UTvmRpcServerInit(uint8_t* memory, size_t memory_size_bytes,
     TVMPlatformAbort(err);
   }
 
+  err = TVMTimeEvaluator_RegisterGlobals();
+  if (err != kTvmErrorNoError) {
+    TVMPlatformAbort(err);
+  }
+
   auto receive_buffer =
       new (vmalloc(TVM_CRT_MAX_PACKET_SIZE_BYTES)) uint8_t[TVM_CRT_MAX_PACKET_SIZE_BYTES];
   auto rpc_server = new (vmalloc(sizeof(tvm::runtime::micro_rpc::MicroRPCServer)))
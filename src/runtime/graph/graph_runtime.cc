@@ -29,6 +29,10 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #include <algorithm>
 #include <functional>
 #include <memory>
@@ -46,17 +50,130 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
   if (align < kAllocAlignment) return kAllocAlignment;
   return align;
 }
+
+/*! \brief The alignment of an arena backed by huge pages. */
+constexpr size_t kHugePageSize = 2 << 20;
+
+/*!
+ * \brief Manager context of a storage arena and of the slots carved out of it.
+ *  The arena owns its memory, while a slot holds a reference to its arena.
+ */
+struct ArenaChunk {
+  DLManagedTensor tensor;
+  int64_t shape;
+  NDArray arena;
+
+  static void Deleter(DLManagedTensor* self) {
+    ArenaChunk* chunk = static_cast<ArenaChunk*>(self->manager_ctx);
+    if (!chunk->arena.defined()) {
+      TVMContext ctx = self->dl_tensor.ctx;
+      DeviceAPI::Get(ctx)->FreeDataSpace(ctx, self->dl_tensor.data);
+    }
+    delete chunk;
+  }
+  /*!
+   * \brief Wrap nbytes at data as a float32 NDArray.
+   * \param data The data pointer.
+   * \param ctx The context of the data.
+   * \param nbytes The number of bytes.
+   * \param arena The arena data points into, undefined if the chunk owns data.
+   */
+  static NDArray Make(void* data, TVMContext ctx, size_t nbytes, NDArray arena) {
+    ArenaChunk* chunk = new ArenaChunk();
+    chunk->shape = static_cast<int64_t>((nbytes + 3) / 4);
+    chunk->arena = arena;
+    chunk->tensor.manager_ctx = chunk;
+    chunk->tensor.deleter = Deleter;
+    DLTensor& t = chunk->tensor.dl_tensor;
+    t.data = data;
+    t.ctx = ctx;
+    t.ndim = 1;
+    t.dtype = DLDataType{kDLFloat, 32, 1};
+    t.shape = &chunk->shape;
+    t.strides = nullptr;
+    t.byte_offset = 0;
+    return NDArray::FromDLPack(&chunk->tensor);
+  }
+};
+
+/*! \brief Whether device pointers can be offset on the host to address a sub-buffer. */
+inline bool SupportsStorageArena(int device_type) {
+  return device_type == kDLCPU || device_type == kDLGPU || device_type == kDLCPUPinned ||
+         device_type == kDLROCM;
+}
 }  // namespace details
 
 /*!
  * \brief Run all the operations one by one.
  */
 void GraphRuntime::Run() {
+  if (use_streams_) {
+    this->RunWithStreams();
+    return;
+  }
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
   }
 }
+
+GraphRuntime::~GraphRuntime() { this->FreeStreams(); }
+
+/*!
+ * \brief Enable or disable stream scheduled execution.
+ * \param enable Whether to use stream scheduled execution.
+ */
+void GraphRuntime::SetStreamSchedule(bool enable) {
+  if (enable == use_streams_) return;
+  if (enable) {
+    this->SetupStreamSchedule();
+  } else {
+    this->FreeStreams();
+  }
+  use_streams_ = enable;
+}
+
+/*!
+ * \brief Place all storage pool entries in one contiguous arena per device.
+ * \param arena The user supplied arena, or undefined.
+ * \param use_huge_pages Whether to back the CPU arena with huge pages.
+ */
+void GraphRuntime::SetStorageArena(NDArray arena, bool use_huge_pages) {
+  use_storage_arena_ = true;
+  use_huge_pages_ = use_huge_pages;
+  user_arena_ = arena;
+  std::vector<NDArray> old_pool;
+  old_pool.swap(storage_pool_);
+  this->AllocateStoragePool();
+  for (size_t sid = 0; sid < storage_pool_.size(); ++sid) {
+    storage_pool_[sid].CopyFrom(old_pool[sid]);
+  }
+  // Entries shared with another runtime through ShareParams are kept.
+  for (size_t i = 0; i < data_entry_.size(); ++i) {
+    int storage_id = attrs_.storage_id[i];
+    if (data_entry_[i]->data != old_pool[storage_id]->data) continue;
+    data_entry_[i] = storage_pool_[storage_id].CreateView(data_entry_[i].Shape(),
+                                                          data_entry_[i]->dtype);
+  }
+  this->SetupOpExecs();
+  if (use_streams_) {
+    // The waits depend on which entries share bytes in the arena.
+    this->FreeStreams();
+    this->SetupStreamSchedule();
+  }
+}
+
+/*!
+ * \brief Get the size of the storage arena of a device.
+ * \param device_type The device type.
+ * \return The arena size in bytes.
+ */
+size_t GraphRuntime::GetStorageArenaSize(int device_type) const {
+  std::vector<size_t> offset;
+  auto arena_size = this->PlanStorageArena(&offset);
+  auto it = arena_size.find(device_type);
+  return it == arena_size.end() ? 0 : it->second;
+}
 /*!
  * \brief Initialize the graph executor with graph and context.
  * \param graph_json The execution graph.
@@ -251,8 +368,7 @@ void GraphRuntime::SetupStorage() {
     vtype.push_back(tvm::runtime::String2DLDataType(s_type));
   }
 
-  // Size and device type of each storage pool entry.
-  std::vector<PoolEntry> pool_entry;
+  pool_entry_.clear();
   // Find the maximum space size.
   for (size_t i = 0; i < attrs_.shape.size(); ++i) {
     int storage_id = attrs_.storage_id[i];
@@ -272,28 +388,17 @@ void GraphRuntime::SetupStorage() {
     size_t bytes = ((bits + 7U) / 8U) * size;
 
     uint32_t sid = static_cast<uint32_t>(storage_id);
-    if (sid >= pool_entry.size()) {
-      pool_entry.resize(sid + 1, {0, -1});
+    if (sid >= pool_entry_.size()) {
+      pool_entry_.resize(sid + 1, {0, -1});
     } else {
-      CHECK(pool_entry[sid].device_type == -1 || pool_entry[sid].device_type == device_type)
+      CHECK(pool_entry_[sid].device_type == -1 || pool_entry_[sid].device_type == device_type)
           << "The same pool entry cannot be assigned to multiple devices";
     }
-    pool_entry[sid].size = std::max(pool_entry[sid].size, bytes);
-    pool_entry[sid].device_type = device_type;
+    pool_entry_[sid].size = std::max(pool_entry_[sid].size, bytes);
+    pool_entry_[sid].device_type = device_type;
   }
 
-  // Allocate the space.
-  for (const auto& pit : pool_entry) {
-    std::vector<int64_t> shape;
-    // This for loop is very fast since there are usually only a couple of
-    // devices available on the same hardware.
-    const auto& cit = std::find_if(ctxs_.begin(), ctxs_.end(), [&pit](const TVMContext& c) {
-      return pit.device_type == static_cast<int>(c.device_type);
-    });
-    TVMContext ctx = cit == ctxs_.end() ? ctxs_[0] : *cit;
-    shape.push_back(static_cast<int64_t>(pit.size + 3) / 4);
-    storage_pool_.push_back(NDArray::Empty(shape, DLDataType{kDLFloat, 32, 1}, ctx));
-  }
+  this->AllocateStoragePool();
 
   // Assign the pooled entries. A unified memory pool is used to simplifiy
   // memory assignment for each node entry. The allocated memory on each device
@@ -309,9 +414,172 @@ void GraphRuntime::SetupStorage() {
   }
 }
 
+TVMContext GraphRuntime::PoolEntryContext(int device_type) const {
+  // This for loop is very fast since there are usually only a couple of
+  // devices available on the same hardware.
+  const auto& cit = std::find_if(ctxs_.begin(), ctxs_.end(), [device_type](const TVMContext& c) {
+    return device_type == static_cast<int>(c.device_type);
+  });
+  return cit == ctxs_.end() ? ctxs_[0] : *cit;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> GraphRuntime::StorageLiveIntervals() const {
+  uint32_t num_nodes = this->GetNumOfNodes();
+  std::vector<std::pair<uint32_t, uint32_t>> live(pool_entry_.size(), {num_nodes, 0});
+  auto use = [this, &live](uint32_t eid, uint32_t nid) {
+    auto& interval = live[attrs_.storage_id[eid]];
+    interval.first = std::min(interval.first, nid);
+    interval.second = std::max(interval.second, nid);
+  };
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    const auto& inode = nodes_[nid];
+    if (inode.op_type == "null") {
+      // Inputs and parameters are kept between runs.
+      use(this->entry_id(nid, 0), 0);
+      use(this->entry_id(nid, 0), num_nodes);
+      continue;
+    }
+    for (const auto& e : inode.inputs) {
+      use(this->entry_id(e), nid);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      use(this->entry_id(nid, index), nid);
+    }
+  }
+  for (const auto& e : outputs_) {
+    use(this->entry_id(e), num_nodes);
+  }
+  for (auto& interval : live) {
+    // An entry no node accesses is kept apart from all others.
+    if (interval.first > interval.second) interval = {0, num_nodes};
+  }
+  return live;
+}
+
+std::unordered_map<int, size_t> GraphRuntime::PlanStorageArena(std::vector<size_t>* offset) const {
+  std::vector<std::pair<uint32_t, uint32_t>> live = this->StorageLiveIntervals();
+  auto aligned_size = [this](size_t sid) {
+    return (pool_entry_[sid].size + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+  };
+  auto device_of = [this](size_t sid) {
+    return static_cast<int>(PoolEntryContext(pool_entry_[sid].device_type).device_type);
+  };
+  // Greedy by size: place the largest entries first, each at the lowest offset
+  // that does not overlap an already placed entry with an overlapping lifetime.
+  std::vector<size_t> order(pool_entry_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&aligned_size](size_t a, size_t b) {
+    return aligned_size(a) > aligned_size(b);
+  });
+  std::unordered_map<int, size_t> arena_size;
+  std::unordered_map<int, std::vector<size_t>> placed;
+  offset->assign(pool_entry_.size(), 0);
+  for (size_t sid : order) {
+    int device_type = device_of(sid);
+    std::vector<std::pair<size_t, size_t>> busy;
+    for (size_t other : placed[device_type]) {
+      if (live[other].first <= live[sid].second && live[sid].first <= live[other].second) {
+        busy.emplace_back((*offset)[other], (*offset)[other] + aligned_size(other));
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    size_t begin = 0;
+    for (const auto& range : busy) {
+      if (range.first >= begin + aligned_size(sid)) break;
+      begin = std::max(begin, range.second);
+    }
+    (*offset)[sid] = begin;
+    placed[device_type].push_back(sid);
+    size_t& end = arena_size[device_type];
+    end = std::max(end, begin + aligned_size(sid));
+  }
+  return arena_size;
+}
+
+std::vector<std::vector<int>> GraphRuntime::StorageArenaOverlaps() const {
+  std::vector<std::vector<int>> overlaps(pool_entry_.size());
+  for (size_t sid = 0; sid < pool_entry_.size(); ++sid) {
+    overlaps[sid].push_back(static_cast<int>(sid));
+  }
+  if (!use_storage_arena_) return overlaps;
+  std::vector<size_t> offset;
+  this->PlanStorageArena(&offset);
+  for (size_t a = 0; a < pool_entry_.size(); ++a) {
+    int device_type = static_cast<int>(PoolEntryContext(pool_entry_[a].device_type).device_type);
+    if (!details::SupportsStorageArena(device_type)) continue;
+    for (size_t b = a + 1; b < pool_entry_.size(); ++b) {
+      if (PoolEntryContext(pool_entry_[b].device_type).device_type != device_type) continue;
+      if (offset[a] < offset[b] + pool_entry_[b].size &&
+          offset[b] < offset[a] + pool_entry_[a].size) {
+        overlaps[a].push_back(static_cast<int>(b));
+        overlaps[b].push_back(static_cast<int>(a));
+      }
+    }
+  }
+  return overlaps;
+}
+
+void GraphRuntime::AllocateStoragePool() {
+  storage_pool_.clear();
+  std::vector<size_t> offset;
+  std::unordered_map<int, NDArray> arena;
+  if (use_storage_arena_) {
+    for (const auto& kv : this->PlanStorageArena(&offset)) {
+      TVMContext ctx = PoolEntryContext(kv.first);
+      if (!details::SupportsStorageArena(kv.first) || kv.second == 0) continue;
+      if (user_arena_.defined() && user_arena_->ctx.device_type == ctx.device_type) {
+        CHECK_EQ(user_arena_->ctx.device_id, ctx.device_id)
+            << "The storage arena is on a different device than the graph";
+        CHECK_GE(GetDataSize(*user_arena_.operator->()), kv.second)
+            << "The storage arena is too small, it needs " << kv.second << " bytes";
+        CHECK_EQ(reinterpret_cast<size_t>(static_cast<char*>(user_arena_->data) +
+                                          user_arena_->byte_offset) %
+                     kAllocAlignment,
+                 0)
+            << "The storage arena must be aligned to " << kAllocAlignment << " bytes";
+        arena[kv.first] = user_arena_;
+        continue;
+      }
+      size_t alignment = kAllocAlignment;
+      size_t nbytes = kv.second;
+      bool huge_pages = use_huge_pages_ && ctx.device_type == kDLCPU;
+      if (huge_pages) {
+        alignment = details::kHugePageSize;
+        nbytes = (nbytes + alignment - 1) / alignment * alignment;
+      }
+      void* data = DeviceAPI::Get(ctx)->AllocDataSpace(ctx, nbytes, alignment,
+                                                       DLDataType{kDLUInt, 8, 1});
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      if (huge_pages && madvise(data, nbytes, MADV_HUGEPAGE) != 0) {
+        LOG(WARNING) << "madvise(MADV_HUGEPAGE) failed, the arena uses regular pages";
+      }
+#endif
+      arena[kv.first] = details::ArenaChunk::Make(data, ctx, nbytes, NDArray());
+    }
+  }
+
+  // Allocate the space.
+  for (size_t sid = 0; sid < pool_entry_.size(); ++sid) {
+    const auto& pit = pool_entry_[sid];
+    TVMContext ctx = PoolEntryContext(pit.device_type);
+    auto it = arena.find(static_cast<int>(ctx.device_type));
+    if (it != arena.end()) {
+      const NDArray& base = it->second;
+      char* data = static_cast<char*>(base->data) + base->byte_offset + offset[sid];
+      storage_pool_.push_back(details::ArenaChunk::Make(data, ctx, pit.size, base));
+      continue;
+    }
+    std::vector<int64_t> shape;
+    shape.push_back(static_cast<int64_t>(pit.size + 3) / 4);
+    storage_pool_.push_back(NDArray::Empty(shape, DLDataType{kDLFloat, 32, 1}, ctx));
+  }
+}
+
 void GraphRuntime::SetupOpExecs() {
   op_execs_.resize(this->GetNumOfNodes());
-  input_dltensors_.resize(num_node_entries());
+  op_args_.resize(this->GetNumOfNodes());
+  // The arguments are recreated, drop the pointers into the previous ones.
+  input_dltensors_.assign(num_node_entries(), std::vector<DLTensor*>());
   std::unordered_set<uint32_t> input_node_eids;
   for (size_t i = 0; i < input_nodes_.size(); i++) {
     uint32_t nid = input_nodes_[i];
@@ -335,6 +603,7 @@ void GraphRuntime::SetupOpExecs() {
 
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args, inode.inputs.size());
+    op_args_[nid] = op_args;
 
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t eid = this->entry_id(inode.inputs[i]);
@@ -346,6 +615,154 @@ void GraphRuntime::SetupOpExecs() {
   }
 }
 
+void GraphRuntime::SetupStreamSchedule() {
+  auto entry_device = [this](uint32_t eid) {
+    int device_type = static_cast<int>(ctxs_[0].device_type);
+    if (!attrs_.device_index.empty()) device_type = attrs_.device_index[eid];
+    const auto& cit = std::find_if(ctxs_.begin(), ctxs_.end(), [device_type](const TVMContext& c) {
+      return device_type == static_cast<int>(c.device_type);
+    });
+    return cit == ctxs_.end() ? ctxs_[0] : *cit;
+  };
+
+  // Queue 0 is the host, which executes synchronously. Every other device gets
+  // a compute queue followed by a copy queue.
+  queues_.clear();
+  queues_.push_back(ExecQueue{ctxs_[0], nullptr});
+  std::unordered_map<int, int> compute_queue;
+  for (uint32_t eid = 0; eid < num_node_entries(); ++eid) {
+    TVMContext ctx = entry_device(eid);
+    int device_type = static_cast<int>(ctx.device_type);
+    if (ctx.device_type == kDLCPU || compute_queue.count(device_type)) continue;
+    compute_queue[device_type] = static_cast<int>(queues_.size());
+    for (int k = 0; k < 2; ++k) {
+      TVMStreamHandle stream;
+      TVM_CCALL(TVMStreamCreate(ctx.device_type, ctx.device_id, &stream));
+      queues_.push_back(ExecQueue{ctx, stream});
+    }
+  }
+  auto queue_of = [&compute_queue](const TVMContext& ctx, bool copy) {
+    auto it = compute_queue.find(static_cast<int>(ctx.device_type));
+    if (it == compute_queue.end()) return 0;
+    return copy ? it->second + 1 : it->second;
+  };
+
+  // Derive the waits from read-after-write, write-after-read and
+  // write-after-write hazards on the storage pool. Storage is shared between
+  // nodes, so a node may also have to wait for unrelated earlier readers.
+  // Entries sharing bytes in the storage arena share their hazards on writes.
+  std::vector<std::vector<int>> overlaps = this->StorageArenaOverlaps();
+  size_t num_queues = queues_.size();
+  std::vector<int> last_writer(storage_pool_.size(), 0);
+  std::vector<std::vector<int>> readers(storage_pool_.size());
+  // Number of nodes issued on each queue.
+  std::vector<int> issued(num_queues, 0);
+  // synced[dst * num_queues + src]: Number of nodes of src that dst waited for.
+  std::vector<int> synced(num_queues * num_queues, 0);
+  node_queue_.assign(nodes_.size(), 0);
+  node_waits_.assign(nodes_.size(), std::vector<int>());
+  for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
+    const auto& inode = nodes_[nid];
+    if (inode.op_type == "null" || !op_execs_[nid]) continue;
+    int q = 0;
+    if (inode.param.func_name == "__copy") {
+      // Copies are issued on the copy queue of the non-CPU side.
+      TVMContext from = entry_device(this->entry_id(inode.inputs[0]));
+      TVMContext to = entry_device(this->entry_id(nid, 0));
+      q = from.device_type != kDLCPU ? queue_of(from, true) : queue_of(to, true);
+    } else {
+      q = queue_of(entry_device(this->entry_id(nid, 0)), false);
+    }
+    node_queue_[nid] = q;
+
+    std::vector<int> deps;
+    for (const auto& e : inode.inputs) {
+      deps.push_back(last_writer[attrs_.storage_id[this->entry_id(e)]]);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      for (int sid : overlaps[attrs_.storage_id[this->entry_id(nid, index)]]) {
+        deps.push_back(last_writer[sid]);
+        deps.insert(deps.end(), readers[sid].begin(), readers[sid].end());
+      }
+    }
+    for (int src : deps) {
+      // Work on the host is complete once it was issued.
+      if (src == 0 || src == q) continue;
+      int& done = synced[q * num_queues + src];
+      if (done >= issued[src]) continue;
+      done = issued[src];
+      node_waits_[nid].push_back(src);
+    }
+
+    for (const auto& e : inode.inputs) {
+      auto& r = readers[attrs_.storage_id[this->entry_id(e)]];
+      if (std::find(r.begin(), r.end(), q) == r.end()) r.push_back(q);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      int sid = attrs_.storage_id[this->entry_id(nid, index)];
+      last_writer[sid] = q;
+      readers[sid].clear();
+    }
+    ++issued[q];
+  }
+}
+
+void GraphRuntime::FreeStreams() {
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    TVMStreamFree(queues_[i].ctx.device_type, queues_[i].ctx.device_id, queues_[i].stream);
+  }
+  queues_.clear();
+  node_queue_.clear();
+  node_waits_.clear();
+}
+
+void GraphRuntime::WaitQueue(int src, int dst) {
+  const ExecQueue& from = queues_[src];
+  if (dst == 0 || queues_[dst].ctx.device_type != from.ctx.device_type) {
+    TVM_CCALL(TVMSynchronize(from.ctx.device_type, from.ctx.device_id, from.stream));
+  } else {
+    TVM_CCALL(TVMStreamStreamSynchronize(from.ctx.device_type, from.ctx.device_id, from.stream,
+                                         queues_[dst].stream));
+  }
+}
+
+void GraphRuntime::SetComputeStreams(bool enable) {
+  for (size_t i = 1; i < queues_.size(); i += 2) {
+    TVM_CCALL(TVMSetStream(queues_[i].ctx.device_type, queues_[i].ctx.device_id,
+                           enable ? queues_[i].stream : nullptr));
+  }
+}
+
+void GraphRuntime::RunWithStreams() {
+  // Kernels pick up the current stream of their device.
+  this->SetComputeStreams(true);
+  try {
+    for (size_t nid = 0; nid < op_execs_.size(); ++nid) {
+      if (!op_execs_[nid]) continue;
+      int q = node_queue_[nid];
+      for (int src : node_waits_[nid]) {
+        this->WaitQueue(src, q);
+      }
+      if (nodes_[nid].param.func_name == "__copy") {
+        DLTensor* from = static_cast<DLTensor*>(op_args_[nid]->arg_values[0].v_handle);
+        DLTensor* to = static_cast<DLTensor*>(op_args_[nid]->arg_values[1].v_handle);
+        TVM_CCALL(TVMArrayCopyFromTo(from, to, queues_[q].stream));
+      } else {
+        op_execs_[nid]();
+      }
+    }
+    for (size_t i = 1; i < queues_.size(); ++i) {
+      TVM_CCALL(TVMSynchronize(queues_[i].ctx.device_type, queues_[i].ctx.device_id,
+                               queues_[i].stream));
+    }
+  } catch (...) {
+    // Do not leave the streams of this runtime current when an operator fails.
+    this->SetComputeStreams(false);
+    throw;
+  }
+  this->SetComputeStreams(false);
+}
+
 std::pair<std::function<void()>, std::shared_ptr<GraphRuntime::OpArgs> > GraphRuntime::CreateTVMOp(
     const TVMOpParam& param, const std::vector<DLTensor>& args, size_t num_inputs) {
   std::shared_ptr<GraphRuntime::OpArgs> arg_ptr = std::make_shared<GraphRuntime::OpArgs>();
@@ -444,6 +861,20 @@ PackedFunc GraphRuntime::GetFunction(const std::string& name,
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "set_stream_schedule") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetStreamSchedule(args[0]);
+    });
+  } else if (name == "set_storage_arena") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      NDArray arena;
+      if (args.size() > 1 && args[1].type_code() != kTVMNullptr) arena = args[1];
+      this->SetStorageArena(arena, args[0]);
+    });
+  } else if (name == "get_storage_arena_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = static_cast<int64_t>(this->GetStorageArenaSize(args[0]));
+    });
   } else if (name == "load_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
@@ -87,6 +87,8 @@ class TVM_DLL GraphRuntime : public ModuleNode {
   const char* type_key() const final { return "GraphRuntime"; }
   void Run();
 
+  ~GraphRuntime();
+
   /*!
    * \brief Initialize the graph executor with graph and context.
    * \param graph_json The execution graph.
@@ -169,6 +171,41 @@ class TVM_DLL GraphRuntime : public ModuleNode {
    */
   void ShareParams(const GraphRuntime& other, dmlc::Stream* strm);
 
+  /*!
+   * \brief Enable or disable stream scheduled execution.
+   *
+   *  When enabled, kernels of each non-CPU device are issued on a compute
+   *  stream and cross device copies on a separate copy stream, so that data
+   *  transfer overlaps with computation. The dependencies between the streams
+   *  are derived from the graph and the storage plan.
+   *
+   * \param enable Whether to use stream scheduled execution.
+   */
+  void SetStreamSchedule(bool enable);
+
+  /*!
+   * \brief Place all storage pool entries in one contiguous arena per device.
+   *
+   *  The entries are laid out at precomputed, aligned offsets instead of being
+   *  allocated one by one. The contents of the current storage, e.g. loaded
+   *  parameters, are preserved. Devices without flat addressing keep the
+   *  per-entry allocation.
+   *
+   * \param arena The arena used for the device it resides on. When undefined,
+   *  the runtime allocates the arena itself. It must be at least
+   *  GetStorageArenaSize bytes and aligned to kAllocAlignment.
+   * \param use_huge_pages Whether to back the CPU arena allocated by the runtime
+   *  with transparent huge pages.
+   */
+  void SetStorageArena(NDArray arena, bool use_huge_pages);
+
+  /*!
+   * \brief Get the size of the storage arena of a device.
+   * \param device_type The device type.
+   * \return The arena size in bytes, 0 if the device has no storage.
+   */
+  size_t GetStorageArenaSize(int device_type) const;
+
   /*!
    * \brief Get total number of nodes.
    * \return Total number of nodes.
@@ -363,8 +400,58 @@ class TVM_DLL GraphRuntime : public ModuleNode {
     }
     CHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
   }
+  // An execution queue used by stream scheduled execution.
+  struct ExecQueue {
+    // The device of the stream, unused for the host queue.
+    TVMContext ctx;
+    // The stream, nullptr for the host queue.
+    TVMStreamHandle stream;
+  };
   /*! \brief Setup the temporal storage */
   void SetupStorage();
+  /*! \brief Allocate storage_pool_ from pool_entry_. */
+  void AllocateStoragePool();
+  /*!
+   * \brief Compute the offset of each pool entry in the arena of its device.
+   *  Entries that are never live at the same time may share bytes.
+   * \param offset The offset of each pool entry.
+   * \return The arena size of each device type.
+   */
+  std::unordered_map<int, size_t> PlanStorageArena(std::vector<size_t>* offset) const;
+  /*!
+   * \brief Compute the first and the last node accessing each pool entry, in execution order.
+   *  Entries of graph inputs and outputs are live for the whole run.
+   * \return The live interval of each pool entry.
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> StorageLiveIntervals() const;
+  /*!
+   * \brief Get the pool entries sharing bytes with each pool entry in the storage arena.
+   * \return The overlapping entries of each pool entry, including the entry itself.
+   */
+  std::vector<std::vector<int>> StorageArenaOverlaps() const;
+  /*!
+   * \brief Get the context a pool entry is allocated on.
+   * \param device_type The device type of the pool entry.
+   * \return The context.
+   */
+  TVMContext PoolEntryContext(int device_type) const;
+  /*! \brief Create the streams and compute the waits of each node. */
+  void SetupStreamSchedule();
+  /*! \brief Free the streams created by SetupStreamSchedule. */
+  void FreeStreams();
+  /*! \brief Run all the operations on their streams. */
+  void RunWithStreams();
+  /*!
+   * \brief Make the compute streams current on their devices, or restore the default streams.
+   * \param enable Whether to set the compute streams.
+   */
+  void SetComputeStreams(bool enable);
+  /*!
+   * \brief Make queue dst wait for the work issued so far on queue src.
+   * \param src The index of the queue to wait for.
+   * \param dst The index of the waiting queue.
+   */
+  void WaitQueue(int src, int dst);
   /*! \brief Setup the executors. */
   void SetupOpExecs();
   /*!
@@ -402,12 +489,30 @@ class TVM_DLL GraphRuntime : public ModuleNode {
   std::vector<TVMContext> ctxs_;
   /*! \brief Common storage pool for all devices. */
   std::vector<NDArray> storage_pool_;
+  /*! \brief Size and device type of each storage pool entry. */
+  std::vector<PoolEntry> pool_entry_;
+  /*! \brief Whether the storage pool is placed in one arena per device. */
+  bool use_storage_arena_{false};
+  /*! \brief Whether the CPU arena is backed by huge pages. */
+  bool use_huge_pages_{false};
+  /*! \brief The user supplied arena, if any. */
+  NDArray user_arena_;
   /*! \brief Data entry of each node. */
   std::vector<NDArray> data_entry_;
   /*! \brief Data alignment of each node. */
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*! \brief Arguments of the operator on each node. */
+  std::vector<std::shared_ptr<OpArgs>> op_args_;
+  /*! \brief Whether stream scheduled execution is enabled. */
+  bool use_streams_{false};
+  /*! \brief Execution queues, the first one is the host. */
+  std::vector<ExecQueue> queues_;
+  /*! \brief The queue each node is issued on. */
+  std::vector<int> node_queue_;
+  /*! \brief The queues each node waits for before it is issued. */
+  std::vector<std::vector<int>> node_waits_;
 };
 
 std::vector<TVMContext> GetAllContext(const TVMArgs& args);
@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/runtime/object_pool.cc
+ * \brief Thread-local size-class free lists used by PoolObjAllocator.
+ */
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/registry.h>
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+
+constexpr size_t kNumSizeClasses = ObjectPool::kMaxPooledSize / ObjectPool::kSizeClassUnit;
+/*! \brief The number of bytes cached by each free list. */
+constexpr size_t kMaxCachedBytes = 1 << 20;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+/*!
+ * \brief The free lists of a thread.
+ *
+ *  It is trivially destructible, so objects freed by destructors that run
+ *  after the thread local destructors still find it valid.
+ */
+struct PoolState {
+  FreeBlock* head[kNumSizeClasses];
+  size_t count[kNumSizeClasses];
+  uint64_t num_allocs;
+  uint64_t num_reused;
+  // Whether the reaper of the thread was created.
+  bool registered;
+  // Whether the thread is exiting, blocks then go straight to the heap.
+  bool exiting;
+};
+
+thread_local PoolState pool_state;
+
+void ReleaseBlocks(PoolState* state) {
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    FreeBlock* block = state->head[i];
+    while (block != nullptr) {
+      FreeBlock* next = block->next;
+      ::operator delete(block);
+      block = next;
+    }
+    state->head[i] = nullptr;
+    state->count[i] = 0;
+  }
+}
+
+/*! \brief Returns the cached blocks to the heap when the thread exits. */
+struct PoolReaper {
+  ~PoolReaper() {
+    ReleaseBlocks(&pool_state);
+    pool_state.exiting = true;
+  }
+};
+
+void RegisterReaper() {
+  static thread_local PoolReaper reaper;
+  (void)reaper;
+  pool_state.registered = true;
+}
+
+}  // namespace
+
+void* ObjectPool::Alloc(size_t size) {
+  PoolState& state = pool_state;
+  ++state.num_allocs;
+  if (size == 0 || size > kMaxPooledSize) return ::operator new(size);
+  size_t cls = (size - 1) / kSizeClassUnit;
+  FreeBlock* block = state.head[cls];
+  if (block != nullptr) {
+    state.head[cls] = block->next;
+    --state.count[cls];
+    ++state.num_reused;
+    return block;
+  }
+  // Allocate the full size class, so the block can serve any size of the class.
+  return ::operator new((cls + 1) * kSizeClassUnit);
+}
+
+void ObjectPool::Free(void* ptr, size_t size) {
+  PoolState& state = pool_state;
+  if (size == 0 || size > kMaxPooledSize || state.exiting) {
+    ::operator delete(ptr);
+    return;
+  }
+  size_t cls = (size - 1) / kSizeClassUnit;
+  if (state.count[cls] * (cls + 1) * kSizeClassUnit >= kMaxCachedBytes) {
+    ::operator delete(ptr);
+    return;
+  }
+  if (!state.registered) RegisterReaper();
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = state.head[cls];
+  state.head[cls] = block;
+  ++state.count[cls];
+}
+
+void ObjectPool::Release() { ReleaseBlocks(&pool_state); }
+
+uint64_t ObjectPool::NumAllocs() { return pool_state.num_allocs; }
+
+uint64_t ObjectPool::NumReused() { return pool_state.num_reused; }
+
+TVM_REGISTER_GLOBAL("runtime.ObjectPoolRelease").set_body_typed([]() { ObjectPool::Release(); });
+
+TVM_REGISTER_GLOBAL("runtime.ObjectPoolNumAllocs").set_body_typed([]() {
+  return static_cast<int64_t>(ObjectPool::NumAllocs());
+});
+
+TVM_REGISTER_GLOBAL("runtime.ObjectPoolNumReused").set_body_typed([]() {
+  return static_cast<int64_t>(ObjectPool::NumReused());
+});
+
+}  // namespace runtime
+}  // namespace tvm
@@ -26,6 +26,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -44,6 +45,8 @@ struct Registry::Manager {
   std::unordered_map<std::string, Registry*> fmap;
   // mutex
   std::mutex mutex;
+  // Bumped on every update of fmap, invalidates the lookup caches of the threads.
+  std::atomic<uint64_t> version{0};
 
   Manager() {}
 
@@ -56,6 +59,19 @@ struct Registry::Manager {
   }
 };
 
+/*!
+ * \brief The per thread cache of Registry::Get.
+ *
+ *  The compiler looks up the same functions over and over from many
+ *  threads, a hit does not take the global mutex. Pointers to the
+ *  functions stay valid after an update, because registries are never
+ *  freed, so the cache only has to be dropped when the version changes.
+ */
+struct RegistryLookupCache {
+  uint64_t version{0};
+  std::unordered_map<std::string, const PackedFunc*> entries;
+};
+
 Registry& Registry::set_body(PackedFunc f) {  // NOLINT(*)
   func_ = f;
   return *this;
@@ -71,6 +87,7 @@ Registry& Registry::Register(const std::string& name, bool can_override) {  // N
   Registry* r = new Registry();
   r->name_ = name;
   m->fmap[name] = r;
+  m->version.fetch_add(1, std::memory_order_release);
   return *r;
 }
 
@@ -80,15 +97,29 @@ bool Registry::Remove(const std::string& name) {
   auto it = m->fmap.find(name);
   if (it == m->fmap.end()) return false;
   m->fmap.erase(it);
+  m->version.fetch_add(1, std::memory_order_release);
   return true;
 }
 
 const PackedFunc* Registry::Get(const std::string& name) {
   Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
-  return &(it->second->func_);
+  static thread_local RegistryLookupCache cache;
+  uint64_t version = m->version.load(std::memory_order_acquire);
+  if (cache.version != version) {
+    cache.entries.clear();
+    cache.version = version;
+  }
+  auto cit = cache.entries.find(name);
+  if (cit != cache.entries.end()) return cit->second;
+  // Misses, including the functions that do not exist, are cached as well.
+  const PackedFunc* ret = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m->mutex);
+    auto it = m->fmap.find(name);
+    if (it != m->fmap.end()) ret = &(it->second->func_);
+  }
+  cache.entries[name] = ret;
+  return ret;
 }
 
 std::vector<std::string> Registry::ListNames() {
@@ -26,6 +26,9 @@
 
 #include <cstring>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #if defined(_M_X64) || defined(__x86_64__)
 #include <immintrin.h>
 #endif
@@ -159,6 +162,8 @@ class RPCModuleNode final : public ModuleNode {
       : module_handle_(module_handle), sess_(sess) {}
 
   ~RPCModuleNode() {
+    // Free the cached functions before the module that holds them.
+    func_cache_.clear();
     if (module_handle_ != nullptr) {
       try {
         sess_->FreeHandle(module_handle_, kTVMModuleHandle);
@@ -175,8 +180,17 @@ class RPCModuleNode final : public ModuleNode {
     if (module_handle_ == nullptr) {
       return WrapRemoteFunc(sess_->GetFunction(name));
     } else {
+      // The functions of a module do not change, so each name is looked up remotely only once.
+      auto it = func_cache_.find(name);
+      if (it != func_cache_.end()) {
+        return it->second;
+      }
       InitRemoteFunc(&remote_mod_get_function_, "tvm.rpc.server.ModuleGetFunction");
-      return remote_mod_get_function_(GetRef<Module>(this), name, false);
+      PackedFunc pf = remote_mod_get_function_(GetRef<Module>(this), name, false);
+      if (pf != nullptr) {
+        func_cache_[name] = pf;
+      }
+      return pf;
     }
   }
 
@@ -187,13 +201,22 @@ class RPCModuleNode final : public ModuleNode {
 
   PackedFunc GetTimeEvaluator(const std::string& name, TVMContext ctx, int number, int repeat,
                               int min_repeat_ms, const std::string& f_preproc_name) {
-    InitRemoteFunc(&remote_get_time_evaluator_, "runtime.RPCTimeEvaluator");
     // Remove session mask because we pass ctx by parts.
     int dev_type = ctx.device_type;
     CHECK_EQ(dev_type / kRPCSessMask, sess_->table_index() + 1)
         << "ValueError: Need to pass the matched remote context to RPCModule.GetTimeEvaluator";
     ctx.device_type = static_cast<DLDeviceType>(ctx.device_type % kRPCSessMask);
 
+    // The C runtime cannot return a time evaluator, it times a call on the device instead.
+    if (remote_time_evaluate_ == nullptr && remote_get_time_evaluator_ == nullptr) {
+      remote_time_evaluate_ = WrapRemoteFunc(sess_->GetFunction("tvm.rpc.server.TimeEvaluate"));
+    }
+    if (remote_time_evaluate_ != nullptr) {
+      return WrapDeviceTimeEvaluator(name, number, repeat, min_repeat_ms, f_preproc_name);
+    }
+
+    InitRemoteFunc(&remote_get_time_evaluator_, "runtime.RPCTimeEvaluator");
+
     if (module_handle_ != nullptr) {
       return remote_get_time_evaluator_(GetRef<Module>(this), name,
                                         static_cast<int>(ctx.device_type), ctx.device_id, number,
@@ -220,6 +243,35 @@ class RPCModuleNode final : public ModuleNode {
   void* module_handle() const { return module_handle_; }
 
  private:
+  PackedFunc WrapDeviceTimeEvaluator(const std::string& name, int number, int repeat,
+                                     int min_repeat_ms, const std::string& f_preproc_name) {
+    PackedFunc time_evaluate = remote_time_evaluate_;
+    Module self = GetRef<Module>(this);
+    bool is_global = module_handle_ == nullptr;
+    return PackedFunc([=](TVMArgs args, TVMRetValue* rv) {
+      const int num_leading_args = 6;
+      std::vector<TVMValue> values(num_leading_args + args.size());
+      std::vector<int> type_codes(num_leading_args + args.size());
+      TVMArgsSetter setter(values.data(), type_codes.data());
+      if (is_global) {
+        setter(0, nullptr);
+      } else {
+        setter(0, self);
+      }
+      setter(1, name);
+      setter(2, number);
+      setter(3, repeat);
+      setter(4, min_repeat_ms);
+      setter(5, f_preproc_name);
+      for (int i = 0; i < args.size(); ++i) {
+        values[num_leading_args + i] = args.values[i];
+        type_codes[num_leading_args + i] = args.type_codes[i];
+      }
+      time_evaluate.CallPacked(
+          TVMArgs(values.data(), type_codes.data(), static_cast<int>(values.size())), rv);
+    });
+  }
+
   template <typename FType>
   void InitRemoteFunc(FType* func, const std::string& name) {
     if (*func != nullptr) return;
@@ -241,12 +293,16 @@ class RPCModuleNode final : public ModuleNode {
   // remote function to get time evaluator
   TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, std::string)>
       remote_get_time_evaluator_;
+  // remote function of the C runtime that times a call on the device
+  PackedFunc remote_time_evaluate_;
   // remote function getter for modules.
   TypedPackedFunc<PackedFunc(Module, std::string, bool)> remote_mod_get_function_;
   // remote function getter for load module
   TypedPackedFunc<Module(std::string)> remote_load_module_;
   // remote function getter for load module
   TypedPackedFunc<void(Module, Module)> remote_import_module_;
+  // functions of the remote module, by name
+  std::unordered_map<std::string, PackedFunc> func_cache_;
 };
 
 void* RPCWrappedFunc::UnwrapRemoteValueToHandle(const TVMArgValue& arg) const {
@@ -0,0 +1,365 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shape_bucket_runtime.cc
+ * \brief Cache of static-shape graph runtimes for a dynamic-shape model.
+ *
+ *  The module keeps one graph runtime per input shape signature. Inputs
+ *  whose shapes have a specialization are run on the corresponding graph
+ *  runtime, others fall back to a VM compiled with Any dimensions. When a
+ *  compile callback is given, a shape signature that falls back to the VM
+ *  `hot_threshold` times is compiled in the background and used from then on.
+ *
+ *  The module can be called from several threads. Runs are serialized, because
+ *  the graph runtimes and the VM keep their inputs and outputs as state.
+ */
+#include <dmlc/logging.h>
+#include <tvm/runtime/container.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief The shape signature of a set of inputs.
+ *  Encoded as the rank of each input followed by its dimensions.
+ */
+using ShapeKey = std::vector<int64_t>;
+
+/*!
+ * \brief State shared with the background compile thread.
+ *
+ *  The compile thread is detached and owns a reference to this state, so the
+ *  runtime module can be destroyed while a compilation is still in flight
+ *  (for example when the compile callback waits for the Python GIL).
+ */
+struct ShapeBucketCompileState {
+  /*! \brief Protects all fields below. */
+  std::mutex mutex;
+  /*! \brief Signaled when a key is queued or on shutdown. */
+  std::condition_variable cv;
+  /*! \brief Keys waiting to be compiled. */
+  std::deque<ShapeKey> queue;
+  /*! \brief Keys queued or being compiled. */
+  std::set<ShapeKey> pending;
+  /*! \brief Compiled modules not yet picked up by the runtime. */
+  std::vector<std::pair<ShapeKey, Module>> ready;
+  /*! \brief Whether the owning runtime was destroyed. */
+  bool stop{false};
+  /*! \brief Whether the compile thread was started. */
+  bool started{false};
+};
+
+/*!
+ * \brief Runtime module dispatching to shape specialized graph runtimes.
+ */
+class ShapeBucketRuntime : public ModuleNode {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param vm The initialized VM module used for unseen shapes, can be undefined.
+   * \param func_name The VM function to invoke.
+   * \param hot_threshold Number of VM runs of one shape before it is compiled.
+   * \param fcompile Callback compiling a shape signature into a graph runtime, can be null.
+   */
+  ShapeBucketRuntime(Module vm, std::string func_name, int64_t hot_threshold,
+                     PackedFunc fcompile)
+      : vm_(vm),
+        vm_func_name_(func_name),
+        hot_threshold_(hot_threshold),
+        fcompile_(fcompile),
+        compile_state_(std::make_shared<ShapeBucketCompileState>()) {
+    if (vm_.defined()) {
+      vm_set_input_ = vm_.GetFunction("set_input");
+      vm_invoke_ = vm_.GetFunction("invoke");
+      CHECK(vm_set_input_ != nullptr && vm_invoke_ != nullptr)
+          << "Fallback module does not expose the VM interface";
+    }
+  }
+
+  ~ShapeBucketRuntime() {
+    {
+      std::lock_guard<std::mutex> lock(compile_state_->mutex);
+      compile_state_->stop = true;
+    }
+    compile_state_->cv.notify_all();
+  }
+
+  const char* type_key() const final { return "ShapeBucketRuntime"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "run") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::vector<NDArray> inputs;
+        for (int i = 0; i < args.num_args; ++i) {
+          inputs.push_back(args[i].operator NDArray());
+        }
+        *rv = this->Run(inputs);
+      });
+    } else if (name == "add_specialization") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        CHECK_GE(args.num_args, 1);
+        Module mod = args[0];
+        ShapeKey key;
+        for (int i = 1; i < args.num_args; ++i) {
+          key.push_back(args[i].operator int64_t());
+        }
+        this->AddSpecialization(key, mod);
+      });
+    } else if (name == "get_num_specializations") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        this->CollectCompiled();
+        *rv = static_cast<int64_t>(graphs_.size());
+      });
+    } else if (name == "get_num_fallback_runs") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *rv = num_fallback_runs_;
+      });
+    } else if (name == "get_num_pending_compiles") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(compile_state_->mutex);
+        *rv = static_cast<int64_t>(compile_state_->pending.size() - compile_state_->ready.size());
+      });
+    } else {
+      return PackedFunc();
+    }
+  }
+
+  /*!
+   * \brief Register a graph runtime for one shape signature.
+   * \param key The shape signature.
+   * \param mod The graph runtime module.
+   */
+  void AddSpecialization(const ShapeKey& key, Module mod) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    this->InsertSpecialization(key, mod);
+  }
+
+  /*!
+   * \brief Run the model on the given inputs.
+   * \param inputs The inputs in the order of the model parameters.
+   * \return The outputs. Outputs of a graph runtime specialization alias its
+   *  internal storage and are overwritten by the next run with the same shapes.
+   */
+  Array<NDArray> Run(const std::vector<NDArray>& inputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ShapeKey key = EncodeShapes(inputs);
+    auto it = graphs_.find(key);
+    if (it == graphs_.end()) {
+      this->CollectCompiled();
+      it = graphs_.find(key);
+    }
+    if (it != graphs_.end()) {
+      const GraphEntry& entry = it->second;
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        entry.set_input(static_cast<int>(i), inputs[i]);
+      }
+      entry.run();
+      std::vector<NDArray> outputs;
+      for (int i = 0; i < entry.num_outputs; ++i) {
+        outputs.push_back(entry.get_output(i));
+      }
+      return Array<NDArray>(outputs.begin(), outputs.end());
+    }
+    CHECK(vm_invoke_ != nullptr) << "No specialization for the input shapes and no VM fallback";
+    ++num_fallback_runs_;
+    if (fcompile_ != nullptr && ++fallback_count_[key] == hot_threshold_) {
+      this->EnqueueCompile(key);
+    }
+    return RunVM(inputs);
+  }
+
+ private:
+  struct GraphEntry {
+    Module mod;
+    PackedFunc set_input;
+    PackedFunc run;
+    PackedFunc get_output;
+    int num_outputs{0};
+  };
+
+  /*! \brief Register a specialization, mutex_ must be held. */
+  void InsertSpecialization(const ShapeKey& key, Module mod) {
+    GraphEntry entry;
+    entry.mod = mod;
+    entry.set_input = mod.GetFunction("set_input");
+    entry.run = mod.GetFunction("run");
+    entry.get_output = mod.GetFunction("get_output");
+    PackedFunc get_num_outputs = mod.GetFunction("get_num_outputs");
+    CHECK(entry.set_input != nullptr && entry.run != nullptr && entry.get_output != nullptr &&
+          get_num_outputs != nullptr)
+        << "Specialization does not expose the graph runtime interface";
+    entry.num_outputs = get_num_outputs();
+    graphs_[key] = entry;
+  }
+
+  static ShapeKey EncodeShapes(const std::vector<NDArray>& inputs) {
+    ShapeKey key;
+    for (const NDArray& arr : inputs) {
+      key.push_back(arr->ndim);
+      key.insert(key.end(), arr->shape, arr->shape + arr->ndim);
+    }
+    return key;
+  }
+
+  Array<NDArray> RunVM(const std::vector<NDArray>& inputs) {
+    std::vector<TVMValue> values(inputs.size() + 1);
+    std::vector<int> codes(inputs.size() + 1);
+    TVMArgsSetter setter(values.data(), codes.data());
+    setter(0, vm_func_name_);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      setter(i + 1, inputs[i]);
+    }
+    TVMRetValue rv;
+    vm_set_input_.CallPacked(TVMArgs(values.data(), codes.data(), values.size()), &rv);
+    ObjectRef ret = vm_invoke_(vm_func_name_);
+    std::vector<NDArray> outputs;
+    if (const auto* adt = ret.as<ADTObj>()) {
+      for (size_t i = 0; i < adt->size; ++i) {
+        outputs.push_back(Downcast<NDArray>((*adt)[i]));
+      }
+    } else {
+      outputs.push_back(Downcast<NDArray>(ret));
+    }
+    return Array<NDArray>(outputs.begin(), outputs.end());
+  }
+
+  void EnqueueCompile(const ShapeKey& key) {
+    std::shared_ptr<ShapeBucketCompileState> state = compile_state_;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!state->pending.insert(key).second) return;
+      state->queue.push_back(key);
+      if (!state->started) {
+        state->started = true;
+        PackedFunc fcompile = fcompile_;
+        std::thread([state, fcompile]() { CompileLoop(state, fcompile); }).detach();
+      }
+    }
+    state->cv.notify_one();
+  }
+
+  static void CompileLoop(std::shared_ptr<ShapeBucketCompileState> state, PackedFunc fcompile) {
+    while (true) {
+      ShapeKey key;
+      {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock, [&state]() { return state->stop || !state->queue.empty(); });
+        if (state->stop) return;
+        key = state->queue.front();
+        state->queue.pop_front();
+      }
+      std::vector<TVMValue> values(key.size());
+      std::vector<int> codes(key.size());
+      TVMArgsSetter setter(values.data(), codes.data());
+      for (size_t i = 0; i < key.size(); ++i) {
+        setter(i, key[i]);
+      }
+      Module mod;
+      try {
+        TVMRetValue rv;
+        fcompile.CallPacked(TVMArgs(values.data(), codes.data(), values.size()), &rv);
+        mod = rv;
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Background compilation of a hot shape failed: " << e.what();
+      }
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (mod.defined()) {
+          state->ready.emplace_back(key, mod);
+        } else {
+          state->pending.erase(key);
+        }
+      }
+      state->cv.notify_all();
+    }
+  }
+
+  /*! \brief Move modules compiled in the background into the cache, mutex_ must be held. */
+  void CollectCompiled() {
+    std::vector<std::pair<ShapeKey, Module>> ready;
+    {
+      std::lock_guard<std::mutex> lock(compile_state_->mutex);
+      ready.swap(compile_state_->ready);
+      for (const auto& kv : ready) {
+        compile_state_->pending.erase(kv.first);
+      }
+    }
+    for (const auto& kv : ready) {
+      this->InsertSpecialization(kv.first, kv.second);
+      fallback_count_.erase(kv.first);
+    }
+  }
+
+  /*! \brief Serializes runs and protects the specializations and counters below. */
+  std::mutex mutex_;
+  /*! \brief Graph runtime specializations keyed by shape signature. */
+  std::map<ShapeKey, GraphEntry> graphs_;
+  /*! \brief Number of VM runs per shape signature without specialization. */
+  std::map<ShapeKey, int64_t> fallback_count_;
+  /*! \brief Total number of VM runs. */
+  int64_t num_fallback_runs_{0};
+  /*! \brief The fallback VM module. */
+  Module vm_;
+  /*! \brief The VM function to invoke. */
+  std::string vm_func_name_;
+  /*! \brief The VM set_input function. */
+  PackedFunc vm_set_input_;
+  /*! \brief The VM invoke function. */
+  PackedFunc vm_invoke_;
+  /*! \brief Number of VM runs of a shape before it is compiled. */
+  int64_t hot_threshold_;
+  /*! \brief The compile callback. */
+  PackedFunc fcompile_;
+  /*! \brief State shared with the compile thread. */
+  std::shared_ptr<ShapeBucketCompileState> compile_state_;
+};
+
+// Arguments: vm, func_name, hot_threshold, fcompile. The VM and the compile
+// callback can be None.
+TVM_REGISTER_GLOBAL("tvm.shape_bucket_runtime.create").set_body([](TVMArgs args, TVMRetValue* rv) {
+  CHECK_EQ(args.num_args, 4) << "Expect vm, func_name, hot_threshold and fcompile";
+  Module vm;
+  if (args[0].type_code() != kTVMNullptr) vm = args[0];
+  std::string func_name = args[1];
+  int64_t hot_threshold = args[2];
+  PackedFunc fcompile;
+  if (args[3].type_code() != kTVMNullptr) fcompile = args[3];
+  *rv = Module(make_object<ShapeBucketRuntime>(vm, func_name, hot_threshold, fcompile));
+});
+
+}  // namespace runtime
+}  // namespace tvm
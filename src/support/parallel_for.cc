@@ -24,7 +24,14 @@
 #include <dmlc/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -93,5 +100,114 @@ void parallel_for(int begin, int end, const std::function<void(int)>& f, int ste
   }
 }
 
+/*!
+ * \brief A process-wide pool of worker threads that run queued closures.
+ *  The threads are started on first use and live until the process exits.
+ */
+class WorkerPool {
+ public:
+  static WorkerPool* Global() {
+    // Leaked on purpose, the workers may still wait on it while static objects are destroyed.
+    static WorkerPool* pool = new WorkerPool();
+    return pool;
+  }
+
+  /*!
+   * \brief Queue a closure to be run by one of the workers.
+   * \param task The closure, it must not throw.
+   */
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  WorkerPool() {
+    int num_workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    for (int i = 0; i < num_workers; ++i) {
+      std::thread([this]() { this->Run(); }).detach();
+    }
+  }
+
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !queue_.empty(); });
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+};
+
+void parallel_for_dynamic(int begin, int end, int num_threads,
+                          const std::function<void(int thread_id, int index)>& f) {
+  CHECK_GE(num_threads, 1) << "parallel_for_dynamic needs at least one thread";
+  if (begin >= end) return;
+  num_threads = std::min(num_threads, end - begin);
+  if (num_threads == 1) {
+    for (int i = begin; i < end; ++i) f(0, i);
+    return;
+  }
+  // State shared with the helpers. A helper that starts after the caller has finished the
+  // loop returns without touching f, so the caller only waits for the helpers that are running.
+  struct Job {
+    const std::function<void(int, int)>* f;
+    int end;
+    std::atomic<int> next;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int num_running{0};
+    bool closed{false};
+    std::exception_ptr error;
+  };
+  auto job = std::make_shared<Job>();
+  job->f = &f;
+  job->end = end;
+  job->next = begin;
+  auto run = [](Job* job, int thread_id) {
+    for (int i = job->next++; i < job->end; i = job->next++) {
+      try {
+        (*job->f)(thread_id, i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (!job->error) job->error = std::current_exception();
+        job->next = job->end;
+      }
+    }
+  };
+  WorkerPool* pool = WorkerPool::Global();
+  for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+    pool->Submit([job, run, thread_id]() {
+      {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (job->closed) return;
+        ++job->num_running;
+      }
+      run(job.get(), thread_id);
+      {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        --job->num_running;
+      }
+      job->cv.notify_all();
+    });
+  }
+  run(job.get(), 0);
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->closed = true;
+  job->cv.wait(lock, [&job]() { return job->num_running == 0; });
+  if (job->error) std::rethrow_exception(job->error);
+}
+
 }  // namespace support
 }  // namespace tvm
@@ -0,0 +1,251 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file persistent_map.h
+ * \brief Persistent hash map based on a hash array mapped trie.
+ *
+ *  Map<K, V>::Set copies the whole map when the map is shared, which makes
+ *  patterns such as "copy the substitution map, add one binding, recurse"
+ *  quadratic. PersistentMap copies only the path from the root to the
+ *  updated entry, so copies are O(1) and updates are O(log32 n) no matter
+ *  how many versions of the map are alive. Nodes that are not shared are
+ *  updated in place, like the copy-on-write of Map.
+ *
+ *  No pass uses it yet; apps/benchmark/map_bench.cc measures it against Map.
+ */
+#ifndef TVM_SUPPORT_PERSISTENT_MAP_H_
+#define TVM_SUPPORT_PERSISTENT_MAP_H_
+
+#include <dmlc/logging.h>
+#include <tvm/runtime/container.h>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace support {
+
+/*!
+ * \brief A persistent hash map.
+ *
+ *  Copying the map is O(1) and the copies are independent: updating one
+ *  does not affect the others. The trie follows the CHAMP layout, each
+ *  node keeps its inline entries and its children in two arrays indexed
+ *  by the popcount of a 32 bit bitmap.
+ *
+ * \tparam K The key type.
+ * \tparam V The value type.
+ * \tparam Hash The hash function of the keys.
+ * \tparam Equal The equality of the keys.
+ */
+template <typename K, typename V, typename Hash = runtime::ObjectHash,
+          typename Equal = runtime::ObjectEqual>
+class PersistentMap {
+ public:
+  /*! \return The number of entries. */
+  size_t size() const { return size_; }
+  /*! \return Whether the map is empty. */
+  bool empty() const { return size_ == 0; }
+  /*!
+   * \brief Find the value of a key.
+   * \param key The key.
+   * \return Pointer to the value, nullptr if the key is not in the map.
+   */
+  const V* find(const K& key) const {
+    size_t hash = Hash()(key);
+    const Node* node = root_.get();
+    for (uint32_t shift = 0; node != nullptr; shift += kBits) {
+      if (shift >= kMaxShift) {
+        for (const auto& kv : node->data) {
+          if (Equal()(kv.first, key)) return &kv.second;
+        }
+        return nullptr;
+      }
+      uint32_t bit = Bit(hash, shift);
+      if (node->datamap & bit) {
+        const auto& kv = node->data[Index(node->datamap, bit)];
+        return Equal()(kv.first, key) ? &kv.second : nullptr;
+      }
+      if ((node->nodemap & bit) == 0) return nullptr;
+      node = node->children[Index(node->nodemap, bit)].get();
+    }
+    return nullptr;
+  }
+  /*! \return The number of entries with the key, 0 or 1. */
+  size_t count(const K& key) const { return find(key) != nullptr ? 1 : 0; }
+  /*!
+   * \brief Get the value of a key that is in the map.
+   * \param key The key.
+   * \return The value.
+   */
+  const V& at(const K& key) const {
+    const V* value = find(key);
+    CHECK(value != nullptr) << "IndexError: key is not in PersistentMap";
+    return *value;
+  }
+  /*!
+   * \brief Insert or update an entry, the copies of this map are unchanged.
+   * \param key The key.
+   * \param value The value.
+   */
+  void Set(const K& key, const V& value) {
+    if (Insert(&root_, key, value, Hash()(key), 0)) ++size_;
+  }
+  /*!
+   * \brief Remove a key if it is in the map, the copies of this map are unchanged.
+   * \param key The key.
+   */
+  void erase(const K& key) {
+    if (find(key) == nullptr) return;
+    Erase(&root_, key, Hash()(key), 0);
+    if (--size_ == 0) root_ = nullptr;
+  }
+  /*!
+   * \brief Visit all the entries, in an unspecified order.
+   * \param fvisit The visitor, called with the key and the value.
+   */
+  template <typename FVisit>
+  void ForEach(FVisit fvisit) const {
+    if (root_ != nullptr) Visit(root_.get(), fvisit);
+  }
+
+ private:
+  /*! \brief The number of hash bits consumed by each level. */
+  static constexpr uint32_t kBits = 5;
+  /*! \brief Keys whose hashes agree on all the bits below are kept in a list. */
+  static constexpr uint32_t kMaxShift = (sizeof(size_t) * 8 / kBits) * kBits;
+
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+  struct Node {
+    /*! \brief The slots that hold an entry. */
+    uint32_t datamap{0};
+    /*! \brief The slots that hold a child. */
+    uint32_t nodemap{0};
+    std::vector<std::pair<K, V>> data;
+    std::vector<NodePtr> children;
+  };
+
+  static uint32_t Bit(size_t hash, uint32_t shift) {
+    return uint32_t(1) << ((hash >> shift) & ((1 << kBits) - 1));
+  }
+  /*! \brief The position of the slot bit among the occupied slots of the bitmap. */
+  static size_t Index(uint32_t bitmap, uint32_t bit) {
+    uint32_t x = bitmap & (bit - 1);
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+  }
+  /*! \brief Get a node that can be updated in place, copy it if it is shared. */
+  static Node* Mutable(NodePtr* node) {
+    if (*node == nullptr) {
+      *node = std::make_shared<Node>();
+    } else if (node->use_count() != 1) {
+      *node = std::make_shared<Node>(**node);
+    }
+    return node->get();
+  }
+  /*! \return Whether a new entry was added. */
+  static bool Insert(NodePtr* slot, const K& key, const V& value, size_t hash, uint32_t shift) {
+    Node* node = Mutable(slot);
+    if (shift >= kMaxShift) {
+      for (auto& kv : node->data) {
+        if (Equal()(kv.first, key)) {
+          kv.second = value;
+          return false;
+        }
+      }
+      node->data.emplace_back(key, value);
+      return true;
+    }
+    uint32_t bit = Bit(hash, shift);
+    if (node->nodemap & bit) {
+      return Insert(&node->children[Index(node->nodemap, bit)], key, value, hash, shift + kBits);
+    }
+    if (node->datamap & bit) {
+      size_t index = Index(node->datamap, bit);
+      auto& kv = node->data[index];
+      if (Equal()(kv.first, key)) {
+        kv.second = value;
+        return false;
+      }
+      // Move the colliding entry and the new one to a child.
+      NodePtr child;
+      Insert(&child, kv.first, kv.second, Hash()(kv.first), shift + kBits);
+      Insert(&child, key, value, hash, shift + kBits);
+      node->data.erase(node->data.begin() + index);
+      node->datamap ^= bit;
+      node->nodemap |= bit;
+      node->children.insert(node->children.begin() + Index(node->nodemap, bit), std::move(child));
+      return true;
+    }
+    node->datamap |= bit;
+    node->data.insert(node->data.begin() + Index(node->datamap, bit), std::make_pair(key, value));
+    return true;
+  }
+  /*! \brief Remove a key that is in the trie. */
+  static void Erase(NodePtr* slot, const K& key, size_t hash, uint32_t shift) {
+    Node* node = Mutable(slot);
+    if (shift >= kMaxShift) {
+      for (auto it = node->data.begin(); it != node->data.end(); ++it) {
+        if (Equal()(it->first, key)) {
+          node->data.erase(it);
+          return;
+        }
+      }
+      return;
+    }
+    uint32_t bit = Bit(hash, shift);
+    if (node->datamap & bit) {
+      node->data.erase(node->data.begin() + Index(node->datamap, bit));
+      node->datamap ^= bit;
+      return;
+    }
+    size_t index = Index(node->nodemap, bit);
+    NodePtr& child = node->children[index];
+    Erase(&child, key, hash, shift + kBits);
+    // Keep the trie canonical: a child with a single entry is inlined.
+    if (child->nodemap == 0 && child->data.size() <= 1) {
+      if (child->data.size() == 1) {
+        std::pair<K, V> kv = std::move(child->data[0]);
+        node->datamap |= bit;
+        node->data.insert(node->data.begin() + Index(node->datamap, bit), std::move(kv));
+      }
+      node->children.erase(node->children.begin() + index);
+      node->nodemap ^= bit;
+    }
+  }
+  template <typename FVisit>
+  static void Visit(const Node* node, FVisit& fvisit) {
+    for (const auto& kv : node->data) fvisit(kv.first, kv.second);
+    for (const auto& child : node->children) Visit(child.get(), fvisit);
+  }
+
+  /*! \brief The root of the trie. */
+  NodePtr root_;
+  /*! \brief The number of entries. */
+  size_t size_{0};
+};
+
+}  // namespace support
+}  // namespace tvm
+#endif  // TVM_SUPPORT_PERSISTENT_MAP_H_
@@ -24,6 +24,9 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/target/target_info.h>
 
+#include <string>
+#include <utility>
+
 namespace tvm {
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
@@ -38,7 +41,34 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
 
 TVM_REGISTER_NODE_TYPE(MemoryInfoNode);
 
+// The innermost MemoryInfoScope of the current thread.
+static thread_local const MemoryInfoScope* memory_info_scope = nullptr;
+
+MemoryInfoScope::MemoryInfoScope(Map<String, MemoryInfo> infos)
+    : infos_(std::move(infos)), prev_(memory_info_scope) {
+  memory_info_scope = this;
+}
+
+MemoryInfoScope::~MemoryInfoScope() { memory_info_scope = prev_; }
+
+Map<String, MemoryInfo> ResolveMemoryInfo() {
+  const std::string prefix = "tvm.info.mem.";
+  Map<String, MemoryInfo> infos;
+  for (const std::string& name : runtime::Registry::ListNames()) {
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      MemoryInfo info = (*runtime::Registry::Get(name))();
+      infos.Set(name.substr(prefix.size()), info);
+    }
+  }
+  return infos;
+}
+
 MemoryInfo GetMemoryInfo(const std::string& scope) {
+  if (memory_info_scope != nullptr) {
+    const Map<String, MemoryInfo>& infos = memory_info_scope->infos_;
+    auto it = infos.find(scope);
+    return it != infos.end() ? (*it).second : MemoryInfo();
+  }
   std::string fname = "tvm.info.mem." + scope;
   const runtime::PackedFunc* f = runtime::Registry::Get(fname);
   if (f == nullptr) {
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file calculate_workspace.cc
+ * \brief Calculate the peak workspace memory of a function.
+ */
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+namespace tvm {
+namespace tir {
+
+class WorkspaceCalculator : public StmtVisitor {
+ public:
+  explicit WorkspaceCalculator(int64_t alignment) : alignment_(alignment) {}
+
+  int64_t peak_bytes() const { return has_dynamic_workspace_ ? -1 : peak_bytes_; }
+
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::storage_scope) {
+      const auto* buffer = op->node.as<VarNode>();
+      const auto* scope = op->value.as<StringImmNode>();
+      CHECK(buffer != nullptr && scope != nullptr);
+      scope_[buffer] = scope->value;
+    }
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    int64_t bytes = WorkspaceBytes(op);
+    live_bytes_ += bytes;
+    peak_bytes_ = std::max(peak_bytes_, live_bytes_);
+    StmtVisitor::VisitStmt_(op);
+    live_bytes_ -= bytes;
+  }
+
+ private:
+  // Bytes of the workspace of an allocation, 0 if it does not allocate a workspace.
+  int64_t WorkspaceBytes(const AllocateNode* op) {
+    auto it = scope_.find(op->buffer_var.get());
+    if (it != scope_.end() && it->second != "global") return 0;
+    int64_t nbytes = op->dtype.bytes() * op->dtype.lanes();
+    int64_t constant_size = op->constant_allocation_size();
+    if (constant_size <= 0) {
+      // LowerTVMBuiltin always allocates a workspace for a size that is not a constant.
+      has_dynamic_workspace_ = true;
+      return 0;
+    }
+    // Same rule as LowerTVMBuiltin on the CPU.
+    if (constant_size * nbytes < runtime::kMaxStackAlloca) return 0;
+    return (constant_size * nbytes + alignment_ - 1) / alignment_ * alignment_;
+  }
+
+  int64_t alignment_;
+  int64_t live_bytes_{0};
+  int64_t peak_bytes_{0};
+  bool has_dynamic_workspace_{false};
+  std::unordered_map<const VarNode*, std::string> scope_;
+};
+
+int64_t CalculateWorkspaceBytes(const PrimFunc& func, int64_t alignment) {
+  CHECK_GT(alignment, 0);
+  WorkspaceCalculator calculator(alignment);
+  calculator(func->body);
+  return calculator.peak_bytes();
+}
+
+TVM_REGISTER_GLOBAL("tir.analysis.calculate_workspace_bytes")
+    .set_body_typed([](PrimFunc func, int64_t alignment) {
+      return CalculateWorkspaceBytes(func, alignment);
+    });
+
+}  // namespace tir
+}  // namespace tvm
@@ -23,12 +23,25 @@
  */
 #include <tvm/node/repr_printer.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
+#include <tvm/target/target.h>
+#include <tvm/target/target_info.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
 
+// Number of threads that run the functions of a PrimFuncPass.
+// 0 runs them sequentially, a negative value uses all hardware threads.
+// Passes always run sequentially when the context has a trace function.
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.parallel_function_passes", Integer);
+
 /*!
  * \brief Function level pass that applies transformations to all
  *        TIR functions within the module.
@@ -41,6 +54,9 @@ class PrimFuncPassNode : public PassNode {
   /*! \brief The pass function called on each. */
   runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func;
 
+  /*! \brief Whether pass_func can be called concurrently on different functions. */
+  bool thread_safe{true};
+
   void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("pass_info", &pass_info); }
 
   /*!
@@ -58,6 +74,22 @@ class PrimFuncPassNode : public PassNode {
    */
   PassInfo Info() const override { return pass_info; }
 
+  /*!
+   * \brief Get the number of threads to run the pass with.
+   * \param pass_ctx The pass context.
+   * \param num_funcs The number of functions in the module.
+   */
+  int NumThreads(const PassContext& pass_ctx, size_t num_funcs) const;
+
+  /*!
+   * \brief Run pass_func on all PrimFuncs of the module using a pool of threads.
+   * \param mod The module.
+   * \param pass_ctx The pass context.
+   * \param num_threads The number of threads.
+   * \return The updated module.
+   */
+  IRModule RunParallel(IRModule mod, const PassContext& pass_ctx, int num_threads) const;
+
   static constexpr const char* _type_key = "tir.PrimFuncPass";
   TVM_DECLARE_FINAL_OBJECT_INFO(PrimFuncPassNode, PassNode);
 };
@@ -68,28 +100,97 @@ class PrimFuncPass : public Pass {
    * \brief The constructor
    * \param pass_func The packed function which implements a pass.
    * \param pass_info The pass info.
+   * \param thread_safe Whether pass_func can run concurrently on different functions.
    */
   TVM_DLL PrimFuncPass(
       runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-      PassInfo pass_info);
+      PassInfo pass_info, bool thread_safe = true);
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFuncPass, Pass, PrimFuncPassNode);
 };
 
 PrimFuncPass::PrimFuncPass(
     runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-    PassInfo pass_info) {
+    PassInfo pass_info, bool thread_safe) {
   auto n = make_object<PrimFuncPassNode>();
   n->pass_func = std::move(pass_func);
   n->pass_info = std::move(pass_info);
+  n->thread_safe = thread_safe;
   data_ = std::move(n);
 }
 
+// Whether the current thread runs a function of a parallel PrimFuncPass.
+static thread_local bool in_parallel_pass = false;
+
+/*! \brief Mark the current thread as running a parallel PrimFuncPass, restored on exit. */
+struct ParallelPassScope {
+  bool prev{in_parallel_pass};
+  ParallelPassScope() { in_parallel_pass = true; }
+  ~ParallelPassScope() { in_parallel_pass = prev; }
+};
+
+int PrimFuncPassNode::NumThreads(const PassContext& pass_ctx, size_t num_funcs) const {
+  // Trace functions can be defined in python, and nested passes would call them on the workers.
+  if (!thread_safe || in_parallel_pass || num_funcs < 2 || pass_ctx->trace_func != nullptr) {
+    return 1;
+  }
+  int64_t num_threads =
+      pass_ctx->GetConfig<Integer>("tir.parallel_function_passes", Integer(0)).value()->value;
+  if (num_threads < 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  return static_cast<int>(std::max<int64_t>(
+      1, std::min<int64_t>(num_threads, static_cast<int64_t>(num_funcs))));
+}
+
+IRModule PrimFuncPassNode::RunParallel(IRModule mod, const PassContext& pass_ctx,
+                                       int num_threads) const {
+  std::vector<GlobalVar> gvars;
+  std::vector<PrimFunc> funcs;
+  for (const auto& kv : mod->functions) {
+    if (kv.second->IsInstance<PrimFuncNode>()) {
+      gvars.push_back(kv.first);
+      funcs.push_back(Downcast<PrimFunc>(kv.second));
+    }
+  }
+  // The pass context and the target scope are thread local, enter them on each thread.
+  // The memory info functions can be defined in python, so resolve them on this thread.
+  Target target = Target::Current(true);
+  Map<String, MemoryInfo> memory_infos = ResolveMemoryInfo();
+  auto run = [&](int, int i) {
+    With<PassContext> ctx_scope(pass_ctx);
+    MemoryInfoScope memory_info_scope(memory_infos);
+    std::unique_ptr<With<Target>> target_scope;
+    if (target.defined()) target_scope.reset(new With<Target>(target));
+    ParallelPassScope parallel_scope;
+    funcs[i] = pass_func(funcs[i], mod, pass_ctx);
+  };
+  // Functions differ a lot in size, so the threads take them one at a time.
+  support::parallel_for_dynamic(0, static_cast<int>(funcs.size()), num_threads, run);
+
+  IRModuleNode* mod_ptr = mod.CopyOnWrite();
+  for (size_t i = 0; i < gvars.size(); ++i) {
+    if (funcs[i].defined()) {
+      mod_ptr->functions.Set(gvars[i], funcs[i]);
+    } else {
+      // automatic removal of None
+      mod_ptr->functions.CopyOnWrite()->erase(gvars[i]);
+    }
+  }
+  return mod;
+}
+
 // Perform Module -> Module optimizations at the PrimFunc level.
 IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx) const {
   const PassInfo& pass_info = Info();
   CHECK(mod.defined());
   pass_ctx.Trace(mod, pass_info, true);
+  int num_threads = NumThreads(pass_ctx, mod->functions.size());
+  if (num_threads > 1) {
+    mod = RunParallel(std::move(mod), pass_ctx, num_threads);
+    pass_ctx.Trace(mod, pass_info, false);
+    return mod;
+  }
   std::vector<ObjectRef> deleted_list;
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
@@ -118,9 +219,9 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe) {
   PassInfo pass_info = PassInfo(opt_level, name, required);
-  return PrimFuncPass(pass_func, pass_info);
+  return PrimFuncPass(pass_func, pass_info, thread_safe);
 }
 
 TVM_REGISTER_NODE_TYPE(PrimFuncPassNode);
@@ -128,7 +229,10 @@ TVM_REGISTER_NODE_TYPE(PrimFuncPassNode);
 TVM_REGISTER_GLOBAL("tir.transform.CreatePrimFuncPass")
     .set_body_typed(
         [](runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)> pass_func,
-           PassInfo pass_info) { return PrimFuncPass(pass_func, pass_info); });
+           PassInfo pass_info) {
+          // Functions from the frontend may need an interpreter lock held by the caller.
+          return PrimFuncPass(pass_func, pass_info, false);
+        });
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<PrimFuncPassNode>([](const ObjectRef& ref, ReprPrinter* p) {
@@ -142,7 +142,8 @@ Pass LowerCustomDatatypes() {
     n->body = CustomDatatypesLowerer(target.value()->kind->name)(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LowerCustomDatatypes", {});
+  // The lowering functions can be registered from python.
+  return CreatePrimFuncPass(pass_func, 0, "tir.LowerCustomDatatypes", {}, false);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LowerCustomDatatypes").set_body_typed(LowerCustomDatatypes);
@@ -314,7 +314,8 @@ Pass LowerIntrin() {
         IntrinInjecter(&analyzer, target.value()->kind->name, mtriple.value())(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.LowerIntrin", {});
+  // The intrinsic rules can be registered from python.
+  return CreatePrimFuncPass(pass_func, 0, "tir.LowerIntrin", {}, false);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.LowerIntrin").set_body_typed(LowerIntrin);
@@ -27,6 +27,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../../src/support/persistent_map.h"
+
 using namespace tvm;
 using namespace tvm::tir;
 using namespace tvm::runtime;
@@ -367,6 +369,36 @@ TEST(Map, Erase) {
   }
 }
 
+TEST(PersistentMap, Basic) {
+  using namespace tvm;
+  support::PersistentMap<String, Integer> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.Set(std::to_string(i), i);
+  }
+  auto map2 = map;
+  map2.Set("0", -1);
+  map2.Set("x", 1);
+  map2.erase("1");
+  CHECK_EQ(map.size(), 1000);
+  CHECK_EQ(map2.size(), 1000);
+  CHECK_EQ(map.at("0")->value, 0);
+  CHECK_EQ(map2.at("0")->value, -1);
+  CHECK_EQ(map.count("x"), 0);
+  CHECK_EQ(map.count("1"), 1);
+  CHECK_EQ(map2.count("1"), 0);
+  int64_t sum = 0;
+  map.ForEach([&](const String& key, const Integer& value) {
+    CHECK_EQ(std::to_string(value->value), std::string(key));
+    sum += value->value;
+  });
+  CHECK_EQ(sum, 999 * 1000 / 2);
+  for (int i = 0; i < 1000; ++i) {
+    map.erase(std::to_string(i));
+  }
+  CHECK(map.empty());
+  CHECK_EQ(map2.at("999")->value, 999);
+}
+
 TEST(String, MoveFromStd) {
   using namespace std;
   string source = "this is a string";
@@ -0,0 +1,270 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <dmlc/logging.h>
+#include <gtest/gtest.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace tvm::runtime;
+
+/*!
+ * \brief A second device simulated on the host, registered as ext_dev.
+ *
+ *  Copies issued on a stream are deferred until the stream is synchronized
+ *  or another stream waits for it. Kernels run when they are called. So a
+ *  missing wait between the compute and the copy stream shows up as stale data.
+ */
+class SimDeviceAPI final : public DeviceAPI {
+ public:
+  struct Stream {
+    std::vector<std::function<void()>> pending;
+  };
+
+  void SetDevice(TVMContext ctx) final {}
+  void GetAttr(TVMContext ctx, DeviceAttrKind kind, TVMRetValue* rv) final {
+    if (kind == kExist) *rv = 1;
+  }
+  void* AllocDataSpace(TVMContext ctx, size_t nbytes, size_t alignment,
+                       DLDataType type_hint) final {
+    return std::malloc(nbytes);
+  }
+  void FreeDataSpace(TVMContext ctx, void* ptr) final { std::free(ptr); }
+  void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset,
+                      size_t num_bytes, TVMContext ctx_from, TVMContext ctx_to,
+                      DLDataType type_hint, TVMStreamHandle stream) final {
+    const char* src = static_cast<const char*>(from) + from_offset;
+    char* dst = static_cast<char*>(to) + to_offset;
+    if (stream == nullptr) {
+      std::memcpy(dst, src, num_bytes);
+    } else {
+      static_cast<Stream*>(stream)->pending.push_back(
+          [dst, src, num_bytes]() { std::memcpy(dst, src, num_bytes); });
+    }
+  }
+  TVMStreamHandle CreateStream(TVMContext ctx) final { return new Stream(); }
+  void FreeStream(TVMContext ctx, TVMStreamHandle stream) final {
+    Flush(stream);
+    delete static_cast<Stream*>(stream);
+  }
+  void StreamSync(TVMContext ctx, TVMStreamHandle stream) final { Flush(stream); }
+  void SetStream(TVMContext ctx, TVMStreamHandle stream) final { current_stream = stream; }
+  void SyncStreamFromTo(TVMContext ctx, TVMStreamHandle event_src,
+                        TVMStreamHandle event_dst) final {
+    ++num_stream_waits;
+    Flush(event_src);
+  }
+
+  static SimDeviceAPI* Global() {
+    static SimDeviceAPI* inst = new SimDeviceAPI();
+    return inst;
+  }
+
+  /*! \brief The stream set by the graph runtime. */
+  TVMStreamHandle current_stream{nullptr};
+  /*! \brief The number of waits between two streams of the device. */
+  int num_stream_waits{0};
+
+ private:
+  static void Flush(TVMStreamHandle stream) {
+    if (stream == nullptr) return;
+    auto* s = static_cast<Stream*>(stream);
+    for (const auto& f : s->pending) f();
+    s->pending.clear();
+  }
+};
+
+TVM_REGISTER_GLOBAL("device_api.ext_dev").set_body([](TVMArgs args, TVMRetValue* rv) {
+  DeviceAPI* ptr = SimDeviceAPI::Global();
+  *rv = static_cast<void*>(ptr);
+});
+
+/*! \brief Element-wise float kernels that run on the host memory of both devices. */
+class SimKernelModuleNode final : public ModuleNode {
+ public:
+  const char* type_key() const final { return "sim_kernel"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "add") return Binary([](float a, float b) { return a + b; });
+    if (name == "sub") return Binary([](float a, float b) { return a - b; });
+    if (name == "mul") return Binary([](float a, float b) { return a * b; });
+    if (name == "fail") {
+      return PackedFunc([](TVMArgs args, TVMRetValue* rv) { LOG(FATAL) << "kernel failed"; });
+    }
+    return PackedFunc();
+  }
+
+ private:
+  static PackedFunc Binary(std::function<float(float, float)> f) {
+    return PackedFunc([f](TVMArgs args, TVMRetValue* rv) {
+      DLTensor* a = args[0];
+      DLTensor* b = args[1];
+      DLTensor* out = args[2];
+      if (out->ctx.device_type == kDLExtDev) {
+        // Kernels of the simulated device are issued on its compute stream.
+        CHECK(SimDeviceAPI::Global()->current_stream != nullptr);
+      }
+      for (int64_t i = 0; i < out->shape[0]; ++i) {
+        static_cast<float*>(out->data)[i] =
+            f(static_cast<float*>(a->data)[i], static_cast<float*>(b->data)[i]);
+      }
+    });
+  }
+};
+
+std::string TvmOp(const std::string& name, const std::string& func_name, int num_inputs,
+                  const std::string& inputs) {
+  return "{\"op\": \"tvm_op\", \"name\": \"" + name +
+         "\", \"attrs\": {\"flatten_data\": \"0\", \"func_name\": \"" + func_name +
+         "\", \"num_inputs\": \"" + std::to_string(num_inputs) +
+         "\", \"num_outputs\": \"1\"}, \"inputs\": [" + inputs + "]}";
+}
+
+std::string Graph(const std::vector<std::string>& nodes, const std::string& arg_nodes,
+                  const std::string& storage_id, const std::string& device_index) {
+  std::string json = "{\"nodes\": [";
+  std::string row_ptr = "0";
+  std::string shapes, dltypes;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    std::string sep = i == 0 ? "" : ", ";
+    json += sep + nodes[i];
+    row_ptr += ", " + std::to_string(i + 1);
+    shapes += sep + "[4]";
+    dltypes += sep + "\"float32\"";
+  }
+  json += "], \"arg_nodes\": [" + arg_nodes + "], \"node_row_ptr\": [" + row_ptr +
+          "], \"heads\": [[" + std::to_string(nodes.size() - 1) +
+          ", 0, 0]], \"attrs\": {\"storage_id\": [\"list_int\", [" + storage_id +
+          "]], \"shape\": [\"list_shape\", [" + shapes + "]], \"device_index\": [\"list_int\", [" +
+          device_index + "]], \"dltype\": [\"list_str\", [" + dltypes + "]]}}";
+  return json;
+}
+
+Module CreateStreamScheduledRuntime(const std::string& json) {
+  const PackedFunc* graph_runtime = Registry::Get("tvm.graph_runtime.create");
+  Module kernels(make_object<SimKernelModuleNode>());
+  Module mod = (*graph_runtime)(json, kernels, static_cast<int>(kDLCPU), 0,
+                                static_cast<int>(kDLExtDev), 0);
+  mod.GetFunction("set_stream_schedule")(true);
+  return mod;
+}
+
+}  // namespace
+
+TEST(GraphRuntimeStream, CrossQueueHazards) {
+  /* The add and mul run on the simulated device and share a storage entry.
+   * The mul must wait on the copy stream for the copy of the add result,
+   * otherwise the deferred copy reads the result of the mul:
+   *
+   *            A    B           (cpu)
+   *            |    |
+   *         copy    copy        (copy stream)
+   *           | \  / |
+   *           |  add |          (compute stream, storage 4)
+   *           |   |  |
+   *           |  copy|          (copy stream)
+   *            \    /
+   *             mul             (compute stream, storage 4)
+   *              |
+   *             copy            (copy stream)
+   *
+   *   out = copy(add) - copy(mul) on the cpu
+   */
+  std::vector<std::string> nodes = {
+      "{\"op\": \"null\", \"name\": \"A\", \"inputs\": []}",
+      "{\"op\": \"null\", \"name\": \"B\", \"inputs\": []}",
+      TvmOp("__copy_a", "__copy", 1, "[0, 0, 0]"),
+      TvmOp("__copy_b", "__copy", 1, "[1, 0, 0]"),
+      TvmOp("add", "add", 2, "[2, 0, 0], [3, 0, 0]"),
+      TvmOp("__copy_add", "__copy", 1, "[4, 0, 0]"),
+      TvmOp("mul", "mul", 2, "[2, 0, 0], [3, 0, 0]"),
+      TvmOp("__copy_mul", "__copy", 1, "[6, 0, 0]"),
+      TvmOp("sub", "sub", 2, "[5, 0, 0], [7, 0, 0]"),
+  };
+  Module mod = CreateStreamScheduledRuntime(
+      Graph(nodes, "0, 1", "0, 1, 2, 3, 4, 5, 4, 6, 7", "1, 1, 12, 12, 12, 1, 12, 1, 1"));
+  PackedFunc set_input = mod.GetFunction("set_input");
+  PackedFunc run = mod.GetFunction("run");
+  PackedFunc get_output = mod.GetFunction("get_output");
+
+  SimDeviceAPI* sim = SimDeviceAPI::Global();
+  sim->num_stream_waits = 0;
+  // Run with different inputs, so that a missing wait reads stale or overwritten data.
+  for (int trial = 0; trial < 3; ++trial) {
+    NDArray a = NDArray::Empty({4}, {kDLFloat, 32, 1}, {kDLCPU, 0});
+    NDArray b = NDArray::Empty({4}, {kDLFloat, 32, 1}, {kDLCPU, 0});
+    for (int i = 0; i < 4; ++i) {
+      static_cast<float*>(a->data)[i] = i + trial;
+      static_cast<float*>(b->data)[i] = 2 * i - trial;
+    }
+    set_input("A", a);
+    set_input("B", b);
+    run();
+    NDArray out = get_output(0);
+    for (int i = 0; i < 4; ++i) {
+      float x = i + trial, y = 2 * i - trial;
+      CHECK_LT(std::fabs(static_cast<float*>(out->data)[i] - ((x + y) - x * y)), 1e-5);
+    }
+  }
+  // The add waits for the copy stream, the mul for the copy of the add result,
+  // and the last copy for the compute stream.
+  CHECK_GE(sim->num_stream_waits, 3 * 3);
+  CHECK(sim->current_stream == nullptr);
+}
+
+TEST(GraphRuntimeStream, ResetStreamOnError) {
+  std::vector<std::string> nodes = {
+      "{\"op\": \"null\", \"name\": \"A\", \"inputs\": []}",
+      TvmOp("__copy_a", "__copy", 1, "[0, 0, 0]"),
+      TvmOp("fail", "fail", 1, "[1, 0, 0]"),
+      TvmOp("__copy_fail", "__copy", 1, "[2, 0, 0]"),
+  };
+  Module mod =
+      CreateStreamScheduledRuntime(Graph(nodes, "0", "0, 1, 2, 3", "1, 12, 12, 1"));
+  NDArray a = NDArray::Empty({4}, {kDLFloat, 32, 1}, {kDLCPU, 0});
+  mod.GetFunction("set_input")("A", a);
+
+  bool exception = false;
+  try {
+    mod.GetFunction("run")();
+  } catch (const dmlc::Error& e) {
+    exception = true;
+  }
+  CHECK(exception);
+  // The compute stream of the runtime is no longer the current stream of the device.
+  CHECK(SimDeviceAPI::Global()->current_stream == nullptr);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  return RUN_ALL_TESTS();
+}
@@ -96,6 +96,24 @@ TEST(ObjectHierachy, Basic) {
   CHECK(refB.as<ObjB>() != nullptr);
 }
 
+TEST(ObjectPool, Reuse) {
+  using namespace tvm::runtime;
+  using namespace tvm::test;
+
+  ObjectPool::Release();
+  ObjectRef refA(PoolObjAllocator().make_object<ObjA>());
+  CHECK_EQ(refA->type_index(), ObjA::RuntimeTypeIndex());
+  const Object* addr = refA.get();
+  refA = ObjectRef(nullptr);
+  // The freed block is handed out again for an object of the same size class.
+  uint64_t num_reused = ObjectPool::NumReused();
+  ObjectRef refB(PoolObjAllocator().make_object<ObjB>());
+  CHECK_EQ(refB.get(), addr);
+  CHECK_EQ(ObjectPool::NumReused(), num_reused + 1);
+  CHECK(refB.as<ObjB>() != nullptr);
+  ObjectPool::Release();
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   testing::FLAGS_gtest_death_test_style = "threadsafe";
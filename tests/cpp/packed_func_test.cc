@@ -25,6 +25,9 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/transform.h>
 
+#include <thread>
+#include <vector>
+
 TEST(PackedFunc, Basic) {
   using namespace tvm;
   using namespace tvm::tir;
@@ -308,6 +311,30 @@ TEST(TypedPackedFunc, RValue) {
   }
 }
 
+TEST(Registry, UpdateAfterGet) {
+  using namespace tvm::runtime;
+  const std::string name = "testing.registry_update_after_get";
+  CHECK(Registry::Get(name) == nullptr);
+  Registry::Register(name).set_body_typed([]() { return 1; });
+  const PackedFunc* f = Registry::Get(name);
+  CHECK(f != nullptr);
+  CHECK_EQ((*f)().operator int(), 1);
+  Registry::Register(name, true).set_body_typed([]() { return 2; });
+  // The cached lookup is dropped by the update, in this thread and others.
+  std::vector<std::thread> threads;
+  std::vector<int> results(4, 0);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (int k = 0; k < 100; ++k) results[i] = (*Registry::Get(name))();
+    });
+  }
+  for (auto& t : threads) t.join();
+  for (int r : results) CHECK_EQ(r, 2);
+  CHECK_EQ((*Registry::Get(name))().operator int(), 2);
+  CHECK(Registry::Remove(name));
+  CHECK(Registry::Get(name) == nullptr);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   testing::FLAGS_gtest_death_test_style = "threadsafe";
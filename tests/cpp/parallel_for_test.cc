@@ -21,6 +21,8 @@
 #include <gtest/gtest.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
 TEST(ParallelFor, Basic) {
@@ -118,6 +120,77 @@ TEST(ParallelFor, Exception) {
   CHECK(exception);
 }
 
+TEST(ParallelForDynamic, Basic) {
+  using tvm::support::parallel_for_dynamic;
+
+  std::vector<int> a(1000, 0);
+  parallel_for_dynamic(0, 1000, 4, [&a](int thread_id, int i) {
+    CHECK_GE(thread_id, 0);
+    CHECK_LT(thread_id, 4);
+    a[i] += i;
+  });
+  for (int i = 0; i < 1000; i++) {
+    CHECK_EQ(a[i], i);
+  }
+  // More threads than indexes, and an empty range.
+  parallel_for_dynamic(0, 2, 16, [&a](int thread_id, int i) { a[i] = -1; });
+  CHECK_EQ(a[0], -1);
+  CHECK_EQ(a[1], -1);
+  parallel_for_dynamic(5, 5, 4, [](int thread_id, int i) { LOG(FATAL) << "unreachable"; });
+}
+
+TEST(ParallelForDynamic, Nested) {
+  using tvm::support::parallel_for_dynamic;
+
+  // Use more threads than the pool has, so the loops cannot all get a worker.
+  int num_threads = 2 * static_cast<int>(std::thread::hardware_concurrency()) + 2;
+  std::vector<std::vector<int>> a(64, std::vector<int>(64, 0));
+  parallel_for_dynamic(0, 64, num_threads, [&](int, int i) {
+    parallel_for_dynamic(0, 64, num_threads, [&](int, int j) { a[i][j] = i * j; });
+  });
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 64; j++) {
+      CHECK_EQ(a[i][j], i * j);
+    }
+  }
+}
+
+TEST(ParallelForDynamic, Concurrent) {
+  using tvm::support::parallel_for_dynamic;
+
+  std::atomic<int> sum{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&sum]() {
+      for (int k = 0; k < 10; k++) {
+        parallel_for_dynamic(0, 100, 4, [&sum](int, int i) { sum += i; });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK_EQ(sum.load(), 4 * 10 * 4950);
+}
+
+TEST(ParallelForDynamic, Exception) {
+  using tvm::support::parallel_for_dynamic;
+
+  bool exception = false;
+  try {
+    parallel_for_dynamic(0, 100, 4, [](int, int i) {
+      if (i == 50) LOG(FATAL) << "error";
+    });
+  } catch (const dmlc::Error& e) {
+    exception = true;
+  }
+  CHECK(exception);
+  // The pool is still usable afterwards.
+  std::atomic<int> count{0};
+  parallel_for_dynamic(0, 100, 4, [&count](int, int) { ++count; });
+  CHECK_EQ(count.load(), 100);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   testing::FLAGS_gtest_death_test_style = "threadsafe";
@@ -0,0 +1,247 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/crt/binary_graph_runtime.h>
+#include <tvm/runtime/crt/crt.h>
+#include <tvm/runtime/crt/memory.h>
+
+#include <cstring>
+
+#include "crt_config.h"
+#include "platform.cc"
+
+namespace {
+
+constexpr uint32_t kAlignment = 64;
+
+extern "C" int AddOne(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_val,
+                      int* ret_type_code, void* resource_handle) {
+  const DLTensor* x = static_cast<const DLTensor*>(args[0].v_handle);
+  const DLTensor* w = static_cast<const DLTensor*>(args[1].v_handle);
+  DLTensor* y = static_cast<DLTensor*>(args[2].v_handle);
+  float* sum = static_cast<float*>(TVMBackendAllocWorkspace(kDLCPU, 0, 16, kDLFloat, 32));
+  if (sum == nullptr) {
+    return -1;
+  }
+  for (int i = 0; i < 4; ++i) {
+    sum[i] = static_cast<const float*>(x->data)[i] + static_cast<const float*>(w->data)[i];
+  }
+  for (int i = 0; i < 4; ++i) {
+    static_cast<float*>(y->data)[i] = sum[i] + 1;
+  }
+  return TVMBackendFreeWorkspace(kDLCPU, 0, sum);
+}
+
+// y = add_one(x, w), where w is a param stored in the graph. This is the layout
+// tvm.micro.serialize_graph produces for the same graph.
+struct TestGraph {
+  TVMBinaryGraphHeader header;
+  TVMBinaryGraphTensor tensors[3];
+  int64_t shapes[2];
+  TVMBinaryGraphStorage storages[3];
+  TVMBinaryGraphInput inputs[1];
+  uint32_t outputs[1];
+  TVMBinaryGraphOp ops[1];
+  uint32_t op_args[3];
+  TVMBinaryGraphParam params[1];
+  alignas(kAlignment) float w[4];
+  char strings[10];
+};
+
+#define OFFSET(field) static_cast<uint32_t>(offsetof(TestGraph, field))
+
+void MakeGraph(TestGraph* g) {
+  memset(g, 0, sizeof(*g));
+  g->header = {TVM_BINARY_GRAPH_MAGIC,
+               TVM_BINARY_GRAPH_VERSION,
+               sizeof(TestGraph),
+               kAlignment,
+               2 * kAlignment,
+               3,
+               OFFSET(tensors),
+               OFFSET(shapes),
+               3,
+               OFFSET(storages),
+               1,
+               OFFSET(inputs),
+               1,
+               OFFSET(outputs),
+               1,
+               OFFSET(ops),
+               3,
+               OFFSET(op_args),
+               1,
+               OFFSET(params),
+               OFFSET(strings),
+               0};
+  for (uint32_t i = 0; i < 3; ++i) {
+    g->tensors[i] = {i, 0, 2, kDLFloat, 32, 1};
+  }
+  g->tensors[1].storage_id = TVM_BINARY_GRAPH_PARAM_STORAGE;
+  g->shapes[0] = 1;
+  g->shapes[1] = 4;
+  g->storages[0] = {0, 16};
+  g->storages[1] = {kAlignment, 0};
+  g->storages[2] = {kAlignment, 16};
+  g->inputs[0] = {0, 0};
+  g->outputs[0] = 2;
+  g->ops[0] = {2, 0, 3, 0};
+  g->op_args[0] = 0;
+  g->op_args[1] = 1;
+  g->op_args[2] = 2;
+  g->params[0] = {1, OFFSET(w), sizeof(g->w), 0};
+  for (int i = 0; i < 4; ++i) g->w[i] = 10 * i;
+  memcpy(g->strings, "x\0add_one", 10);
+}
+
+alignas(256) uint8_t crt_memory[64 * 1024];
+// Globals, since the fixture is allocated by operator new which may not honor alignas.
+alignas(kAlignment) TestGraph test_graph;
+
+class BinaryGraphRuntimeTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ASSERT_EQ(kTvmErrorNoError, TVMInitializeRuntime(crt_memory, sizeof(crt_memory), 8));
+    ASSERT_EQ(0,
+              TVMFuncRegisterGlobal("add_one", reinterpret_cast<TVMFunctionHandle>(&AddOne), 0));
+  }
+
+  void SetUp() override { MakeGraph(&test_graph); }
+
+  uint8_t memory_[1024];
+};
+
+}  // namespace
+
+TEST_F(BinaryGraphRuntimeTest, Run) {
+  size_t memory_size = TVMBinaryGraphRuntime_MemorySize(&test_graph, sizeof(test_graph));
+  ASSERT_GT(memory_size, 2 * kAlignment);
+  ASSERT_LE(memory_size, sizeof(memory_));
+  int leak_before = vleak_size;
+
+  TVMBinaryGraphRuntime runtime;
+  DLContext ctx = {kDLCPU, 0};
+  ASSERT_EQ(kTvmErrorNoError,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+  // Nothing is allocated from the CRT heap.
+  EXPECT_EQ(leak_before, vleak_size);
+
+  ASSERT_EQ(0, TVMBinaryGraphRuntime_GetInputIndex(&runtime, "x"));
+  EXPECT_EQ(-1, TVMBinaryGraphRuntime_GetInputIndex(&runtime, "w"));
+  DLTensor* x = TVMBinaryGraphRuntime_GetInput(&runtime, 0);
+  ASSERT_NE(nullptr, x);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(x->data) % kAlignment);
+  for (int i = 0; i < 4; ++i) static_cast<float*>(x->data)[i] = i;
+
+  ASSERT_EQ(0, TVMBinaryGraphRuntime_Run(&runtime));
+  DLTensor* y = TVMBinaryGraphRuntime_GetOutput(&runtime, 0);
+  ASSERT_NE(nullptr, y);
+  EXPECT_EQ(2, y->ndim);
+  EXPECT_EQ(4, y->shape[1]);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(11 * i + 1, static_cast<float*>(y->data)[i]);
+  }
+  // The param is used in place.
+  EXPECT_EQ(test_graph.w, runtime.tensors[1].data);
+  EXPECT_EQ(nullptr, TVMBinaryGraphRuntime_GetOutput(&runtime, 1));
+}
+
+TEST_F(BinaryGraphRuntimeTest, KernelWorkspace) {
+  test_graph.header.kernel_workspace_size = kAlignment;
+  size_t memory_size = TVMBinaryGraphRuntime_MemorySize(&test_graph, sizeof(test_graph));
+  ASSERT_LE(memory_size, sizeof(memory_));
+  TVMBinaryGraphRuntime runtime;
+  DLContext ctx = {kDLCPU, 0};
+  ASSERT_EQ(kTvmErrorNoError,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+  DLTensor* x = TVMBinaryGraphRuntime_GetInput(&runtime, 0);
+  for (int i = 0; i < 4; ++i) static_cast<float*>(x->data)[i] = i;
+
+  // The workspace of the kernel comes from the runtime memory, not from the heap.
+  int leak_before = vleak_size;
+  ASSERT_EQ(0, TVMBinaryGraphRuntime_Run(&runtime));
+  EXPECT_EQ(leak_before, vleak_size);
+  EXPECT_EQ(kAlignment, runtime.kernel_workspace.peak);
+  EXPECT_EQ(0, runtime.kernel_workspace.used);
+  EXPECT_GE(runtime.kernel_workspace.data, memory_);
+  EXPECT_LE(runtime.kernel_workspace.data + kAlignment, memory_ + memory_size);
+  DLTensor* y = TVMBinaryGraphRuntime_GetOutput(&runtime, 0);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(11 * i + 1, static_cast<float*>(y->data)[i]);
+  }
+  // The heap is used again after the run.
+  void* ptr = TVMBackendAllocWorkspace(kDLCPU, 0, 16, kDLFloat, 32);
+  EXPECT_NE(nullptr, ptr);
+  EXPECT_EQ(0, TVMBackendFreeWorkspace(kDLCPU, 0, ptr));
+
+  // A kernel workspace smaller than the plan fails the run instead of using the heap.
+  test_graph.header.kernel_workspace_size = 8;
+  ASSERT_EQ(kTvmErrorNoError,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, sizeof(memory_)));
+  EXPECT_NE(0, TVMBinaryGraphRuntime_Run(&runtime));
+}
+
+TEST_F(BinaryGraphRuntimeTest, Invalid) {
+  TVMBinaryGraphRuntime runtime;
+  DLContext ctx = {kDLCPU, 0};
+  size_t memory_size = TVMBinaryGraphRuntime_MemorySize(&test_graph, sizeof(test_graph));
+  EXPECT_EQ(kTvmErrorGraphRuntimeMemoryTooSmall,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size - 1));
+  EXPECT_EQ(kTvmErrorGraphRuntimeInvalidGraph,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph) - 1, NULL, ctx,
+                                       memory_, memory_size));
+  test_graph.op_args[2] = 3;
+  EXPECT_EQ(kTvmErrorGraphRuntimeInvalidGraph,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+  MakeGraph(&test_graph);
+  memcpy(test_graph.strings, "x\0add_two", 10);
+  EXPECT_EQ(kTvmErrorFunctionNameNotFound,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+  // shape_index + ndim wraps around in 32 bits.
+  MakeGraph(&test_graph);
+  test_graph.tensors[0].shape_index = 0xFFFFFFFF;
+  EXPECT_EQ(kTvmErrorGraphRuntimeInvalidGraph,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+  // The shapes are read in place as int64_t.
+  MakeGraph(&test_graph);
+  test_graph.header.shapes_offset += 4;
+  EXPECT_EQ(kTvmErrorGraphRuntimeMisaligned,
+            TVMBinaryGraphRuntime_Init(&runtime, &test_graph, sizeof(test_graph), NULL, ctx,
+                                       memory_, memory_size));
+}
+
+TEST_F(BinaryGraphRuntimeTest, MemorySizeOfShortGraph) {
+  EXPECT_EQ(0, TVMBinaryGraphRuntime_MemorySize(&test_graph, sizeof(TVMBinaryGraphHeader) - 1));
+  EXPECT_NE(0, TVMBinaryGraphRuntime_MemorySize(&test_graph, sizeof(TVMBinaryGraphHeader)));
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  return RUN_ALL_TESTS();
+}
@@ -22,6 +22,7 @@
 #include <tvm/runtime/crt/rpc_common/frame_buffer.h>
 #include <tvm/runtime/crt/rpc_common/framing.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -304,6 +305,48 @@ TEST_P(UnframerTestParameterized, TestArbitraryPacketReset) {
   }
 }
 
+TEST(FramingTest, LargePayloadRoundTrip) {
+  // Long runs go through the in place paths, escape codes through the buffered ones.
+  std::string payload(5000, 'a');
+  for (size_t i = 0; i < payload.size(); i++) {
+    payload[i] = static_cast<char>((i * 7919) % 251);
+  }
+  for (size_t i = 1000; i < 1100; i++) {
+    payload[i] = '\xff';
+  }
+  for (size_t i = 3000; i < payload.size(); i += 61) {
+    payload[i] = '\xff';
+  }
+
+  BufferWriteStream<8192> wire;
+  Framer framer{&wire};
+  EXPECT_EQ(kTvmErrorNoError, framer.StartPacket(payload.size()));
+  // Write the payload in uneven chunks.
+  for (size_t i = 0; i < payload.size(); i += 1234) {
+    size_t chunk = std::min<size_t>(1234, payload.size() - i);
+    EXPECT_EQ(kTvmErrorNoError,
+              framer.WritePayloadChunk(reinterpret_cast<const uint8_t*>(&payload[i]), chunk));
+  }
+  EXPECT_EQ(kTvmErrorNoError, framer.FinishPacket());
+  std::string wire_data = wire.BufferContents();
+
+  for (size_t chunk_size : {1, 3, 127, 128, 129, 4096, 8192}) {
+    BufferWriteStream<8192> unframed;
+    Unframer unframer{&unframed};
+    for (size_t i = 0; i < wire_data.size(); i += chunk_size) {
+      size_t chunk = std::min<size_t>(chunk_size, wire_data.size() - i);
+      size_t bytes_consumed;
+      EXPECT_EQ(kTvmErrorNoError,
+                unframer.Write(reinterpret_cast<const uint8_t*>(&wire_data[i]), chunk,
+                               &bytes_consumed));
+      EXPECT_EQ(chunk, bytes_consumed);
+    }
+    EXPECT_TRUE(unframed.packet_done());
+    EXPECT_TRUE(unframed.is_valid());
+    EXPECT_EQ(payload, unframed.BufferContents());
+  }
+}
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 INSTANTIATE_TEST_CASE_P(UnframerTests, UnframerTestParameterized,
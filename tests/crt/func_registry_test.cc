@@ -167,7 +167,7 @@ static void snprintf_truncate(char* target, size_t bytes, const char* str) {
 TEST(MutableFuncRegistry, Create) {
   uint8_t mem_buffer[kTvmAverageFuncEntrySizeBytes * 3];
   // A substring used to create function names for testing.
-  const char* function_name_chars = "abcdefghijklmnopqrstuvwxyzyxw";
+  const char* function_name_chars = "abcdefghijklmnopqrstuvwxyzyxwvutsrqp";
 
   // function_name_chars is used to produce 2 function names. The second one is expected to
   // overfill `names`; assert there are at least enough data in function_name_chars to do this.
@@ -233,6 +233,49 @@ TEST(MutableFuncRegistry, Create) {
   }
 }
 
+TEST(MutableFuncRegistry, HashedLookup) {
+  uint8_t mem_buffer[kTvmAverageFuncEntrySizeBytes * 64];
+  TVMMutableFuncRegistry reg;
+  EXPECT_EQ(kTvmErrorNoError, TVMMutableFuncRegistry_Create(&reg, mem_buffer, sizeof(mem_buffer)));
+
+  char name[16];
+  for (int i = 0; i < 64; i++) {
+    snprintf(name, sizeof(name), "func%d", i);
+    EXPECT_EQ(kTvmErrorNoError,
+              TVMMutableFuncRegistry_Set(&reg, name, (TVMBackendPackedCFunc)(uintptr_t)(i + 1), 0));
+  }
+  EXPECT_EQ(64, reg.registry.names[0]);
+
+  // The hash table and the linear scan of the names agree.
+  for (int i = 0; i < 64; i++) {
+    snprintf(name, sizeof(name), "func%d", i);
+    tvm_function_index_t hashed_index = 100;
+    tvm_function_index_t scanned_index = 200;
+    EXPECT_EQ(kTvmErrorNoError, TVMMutableFuncRegistry_Lookup(&reg, name, &hashed_index));
+    EXPECT_EQ(kTvmErrorNoError, TVMFuncRegistry_Lookup(&reg.registry, name, &scanned_index));
+    EXPECT_EQ(i, hashed_index);
+    EXPECT_EQ(i, scanned_index);
+  }
+
+  tvm_function_index_t func_index = 100;
+  EXPECT_EQ(kTvmErrorFunctionNameNotFound,
+            TVMMutableFuncRegistry_Lookup(&reg, "func", &func_index));
+  EXPECT_EQ(kTvmErrorFunctionNameNotFound,
+            TVMMutableFuncRegistry_Lookup(&reg, "func64", &func_index));
+  EXPECT_EQ(100, func_index);
+
+  // Override keeps the index.
+  EXPECT_EQ(kTvmErrorFunctionAlreadyDefined,
+            TVMMutableFuncRegistry_Set(&reg, "func7", (TVMBackendPackedCFunc)(uintptr_t)100, 0));
+  EXPECT_EQ(kTvmErrorNoError,
+            TVMMutableFuncRegistry_Set(&reg, "func7", (TVMBackendPackedCFunc)(uintptr_t)100, 1));
+  EXPECT_EQ(kTvmErrorNoError, TVMMutableFuncRegistry_Lookup(&reg, "func7", &func_index));
+  EXPECT_EQ(7, func_index);
+  TVMBackendPackedCFunc func = NULL;
+  EXPECT_EQ(kTvmErrorNoError, TVMFuncRegistry_GetByIndex(&reg.registry, func_index, &func));
+  EXPECT_EQ((TVMBackendPackedCFunc)(uintptr_t)100, func);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   testing::FLAGS_gtest_death_test_style = "threadsafe";
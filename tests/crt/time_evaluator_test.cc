@@ -0,0 +1,233 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/crt.h>
+#include <tvm/runtime/crt/time_evaluator.h>
+
+#include <cstring>
+
+#include "platform.cc"
+
+namespace {
+
+// A fake device clock, advanced by the timed functions.
+double now_us = 0;
+double timer_start_us = -1;
+// The resolution of the timer, 0 for an exact timer.
+double timer_tick_us = 0;
+int num_calls = 0;
+int num_preproc_calls = 0;
+
+}  // namespace
+
+extern "C" {
+
+int TVMPlatformTimerStart() {
+  if (timer_start_us >= 0) {
+    return -1;
+  }
+  timer_start_us = now_us;
+  return 0;
+}
+
+int TVMPlatformTimerStop(double* res_us) {
+  if (timer_start_us < 0) {
+    return -1;
+  }
+  *res_us = now_us - timer_start_us;
+  if (timer_tick_us > 0) {
+    *res_us = static_cast<int>(*res_us / timer_tick_us) * timer_tick_us;
+  }
+  timer_start_us = -1;
+  return 0;
+}
+
+static int TakesTenMicroseconds(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                                int* ret_type_code, void* resource_handle) {
+  now_us += 10;
+  num_calls++;
+  return num_args == 1 && type_codes[0] == kDLInt && args[0].v_int64 == 42 ? 0 : -1;
+}
+
+static int Instant(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                   int* ret_type_code, void* resource_handle) {
+  num_calls++;
+  return 0;
+}
+
+static int Preproc(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                   int* ret_type_code, void* resource_handle) {
+  // Not timed.
+  now_us += 1000;
+  num_preproc_calls++;
+  return 0;
+}
+
+static int Fails(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_value,
+                 int* ret_type_code, void* resource_handle) {
+  return -2;
+}
+}
+
+class TimeEvaluatorTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    static uint8_t memory[64 * 1024];
+    ASSERT_EQ(kTvmErrorNoError, TVMInitializeRuntime(memory, sizeof(memory), 8));
+    ASSERT_EQ(kTvmErrorNoError, TVMTimeEvaluator_RegisterGlobals());
+    ASSERT_EQ(0, TVMFuncRegisterGlobal("ten_us", (TVMFunctionHandle)&TakesTenMicroseconds, 0));
+    ASSERT_EQ(0, TVMFuncRegisterGlobal("instant", (TVMFunctionHandle)&Instant, 0));
+    ASSERT_EQ(0, TVMFuncRegisterGlobal("preproc", (TVMFunctionHandle)&Preproc, 0));
+    ASSERT_EQ(0, TVMFuncRegisterGlobal("fails", (TVMFunctionHandle)&Fails, 0));
+  }
+
+  void SetUp() override {
+    num_calls = 0;
+    num_preproc_calls = 0;
+    timer_tick_us = 0;
+    arg_.v_int64 = 42;
+    arg_type_code_ = kDLInt;
+  }
+
+  TVMFunctionHandle GetGlobal(const char* name) {
+    TVMFunctionHandle func = nullptr;
+    EXPECT_EQ(0, TVMFuncGetGlobal(name, &func));
+    return func;
+  }
+
+  TVMValue arg_;
+  int arg_type_code_;
+};
+
+TEST_F(TimeEvaluatorTest, Run) {
+  double results[3];
+  ASSERT_EQ(0, TVMTimeEvaluator_Run(GetGlobal("ten_us"), &arg_, &arg_type_code_, 1, 4, 3, 0,
+                                    GetGlobal("preproc"), results));
+  EXPECT_EQ(12, num_calls);
+  EXPECT_EQ(3, num_preproc_calls);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_DOUBLE_EQ(10e-6, results[i]);
+  }
+}
+
+TEST_F(TimeEvaluatorTest, MinRepeatMs) {
+  // 1 call takes 10us, so 101 calls are needed to reach 1ms.
+  double result;
+  ASSERT_EQ(0, TVMTimeEvaluator_Run(GetGlobal("ten_us"), &arg_, &arg_type_code_, 1, 1, 1, 1,
+                                    nullptr, &result));
+  EXPECT_EQ(1 + 101, num_calls);
+  EXPECT_DOUBLE_EQ(10e-6, result);
+}
+
+TEST_F(TimeEvaluatorTest, CoarseTimer) {
+  // The timer reads 0 until 100 calls, so number doubles from 1 to 128.
+  timer_tick_us = 1000;
+  double result;
+  ASSERT_EQ(0, TVMTimeEvaluator_Run(GetGlobal("ten_us"), &arg_, &arg_type_code_, 1, 1, 1, 1,
+                                    nullptr, &result));
+  EXPECT_EQ(255, num_calls);
+  EXPECT_DOUBLE_EQ(1000e-6 / 128, result);
+}
+
+TEST_F(TimeEvaluatorTest, TimerDoesNotTick) {
+  double result;
+  EXPECT_EQ(-1, TVMTimeEvaluator_Run(GetGlobal("instant"), &arg_, &arg_type_code_, 1, 1, 1, 1,
+                                     nullptr, &result));
+  // 20 rounds of 1, 2, 4, ... calls.
+  EXPECT_EQ((1 << 20) - 1, num_calls);
+  EXPECT_LT(timer_start_us, 0);
+}
+
+TEST_F(TimeEvaluatorTest, Error) {
+  double result;
+  EXPECT_EQ(-2, TVMTimeEvaluator_Run(GetGlobal("fails"), &arg_, &arg_type_code_, 1, 4, 1, 0,
+                                     nullptr, &result));
+  // The timer is stopped.
+  EXPECT_LT(timer_start_us, 0);
+  arg_.v_int64 = 0;
+  EXPECT_EQ(-1, TVMTimeEvaluator_Run(GetGlobal("ten_us"), &arg_, &arg_type_code_, 1, 4, 1, 0,
+                                     nullptr, &result));
+  EXPECT_LT(timer_start_us, 0);
+}
+
+TEST_F(TimeEvaluatorTest, TimeEvaluate) {
+  TVMValue args[7];
+  int type_codes[7];
+  args[0].v_handle = nullptr;
+  type_codes[0] = kTVMNullptr;
+  args[1].v_str = "ten_us";
+  type_codes[1] = kTVMStr;
+  args[2].v_int64 = 5;
+  args[3].v_int64 = 2;
+  args[4].v_int64 = 0;
+  type_codes[2] = type_codes[3] = type_codes[4] = kDLInt;
+  args[5].v_str = "preproc";
+  type_codes[5] = kTVMStr;
+  args[6] = arg_;
+  type_codes[6] = arg_type_code_;
+
+  TVMValue ret_value;
+  int ret_type_code;
+  ASSERT_EQ(0, TVMFuncCall(GetGlobal("tvm.rpc.server.TimeEvaluate"), args, type_codes, 7,
+                           &ret_value, &ret_type_code));
+  ASSERT_EQ(kTVMBytes, ret_type_code);
+  const TVMByteArray* blob = static_cast<const TVMByteArray*>(ret_value.v_handle);
+  ASSERT_EQ(2 * sizeof(double), blob->size);
+  double results[2];
+  memcpy(results, blob->data, sizeof(results));
+  EXPECT_DOUBLE_EQ(10e-6, results[0]);
+  EXPECT_DOUBLE_EQ(10e-6, results[1]);
+  // One call is skipped before timing.
+  EXPECT_EQ(1 + 2 * 5, num_calls);
+  EXPECT_EQ(2, num_preproc_calls);
+
+  args[5].v_str = "no_such_function";
+  EXPECT_NE(0, TVMFuncCall(GetGlobal("tvm.rpc.server.TimeEvaluate"), args, type_codes, 7,
+                           &ret_value, &ret_type_code));
+}
+
+TEST_F(TimeEvaluatorTest, CallRepeated) {
+  TVMValue args[4];
+  int type_codes[4];
+  args[0].v_handle = nullptr;
+  type_codes[0] = kTVMNullptr;
+  args[1].v_str = "ten_us";
+  type_codes[1] = kTVMStr;
+  args[2].v_int64 = 7;
+  type_codes[2] = kDLInt;
+  args[3] = arg_;
+  type_codes[3] = arg_type_code_;
+
+  TVMValue ret_value;
+  int ret_type_code;
+  ASSERT_EQ(0, TVMFuncCall(GetGlobal("tvm.rpc.server.CallRepeated"), args, type_codes, 4,
+                           &ret_value, &ret_type_code));
+  ASSERT_EQ(kDLFloat, ret_type_code);
+  EXPECT_DOUBLE_EQ(10e-6, ret_value.v_float64);
+  EXPECT_EQ(7, num_calls);
+}
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  return RUN_ALL_TESTS();
+}
@@ -90,6 +90,133 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.asnumpy(), np_out, rtol=1e-5)
 
 
+def _stable_argsort(np_data, axis, is_ascend):
+    keys = np_data if is_ascend else -np_data
+    return np.argsort(keys, axis=axis, kind="stable")
+
+
+def test_argsort_large():
+    # Rows long enough for the radix sort, and enough of them to sort in parallel.
+    ctx = tvm.cpu(0)
+    for dtype, dshape, axis in [
+        ("float32", (64, 3000), 1),
+        ("float64", (2, 1000, 8), 1),
+        ("int32", (40, 2000), -1),
+        ("int64", (2000, 20), 0),
+    ]:
+        data = te.placeholder(dshape, name="data", dtype=dtype)
+        for is_ascend in [True, False]:
+            out = te.extern(
+                data.shape,
+                [data],
+                lambda ins, outs: tvm.tir.call_packed(
+                    "tvm.contrib.sort.argsort", ins[0], outs[0], axis, is_ascend
+                ),
+                dtype="int32",
+                name="argsort_tensor",
+            )
+            s = te.create_schedule(out.op)
+            f = tvm.build(s, [data, out], "llvm")
+            # Few distinct values, so the ties check the sort is stable.
+            np_data = np.random.randint(-50, 50, size=dshape).astype(dtype)
+            if dtype.startswith("float"):
+                np_data = np_data / 4
+                np_data.flat[:2] = [-0.0, 0.0]
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.zeros(dshape, dtype=out.dtype), ctx)
+            f(a, b)
+            tvm.testing.assert_allclose(b.asnumpy(), _stable_argsort(np_data, axis, is_ascend))
+
+
+def test_topk_large():
+    ctx = tvm.cpu(0)
+    dshape = (32, 5000)
+    for dtype in ["float32", "int64"]:
+        data = te.placeholder(dshape, name="data", dtype=dtype)
+        # Small k selects with a heap, large k sorts the whole row.
+        for k, is_ascend in [(5, False), (5, True), (1000, False)]:
+            values, indices = te.extern(
+                [(dshape[0], k), (dshape[0], k)],
+                [data],
+                lambda ins, outs: tvm.tir.call_packed(
+                    "tvm.contrib.sort.topk", ins[0], outs[0], outs[1], k, 1, "both", is_ascend
+                ),
+                dtype=[dtype, "int32"],
+                name="topk_tensor",
+            )
+            s = te.create_schedule(values.op)
+            f = tvm.build(s, [data, values, indices], "llvm")
+            np_data = np.random.randint(-100, 100, size=dshape).astype(dtype)
+            np_indices = _stable_argsort(np_data, 1, is_ascend)[:, :k]
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.zeros((dshape[0], k), dtype=dtype), ctx)
+            c = tvm.nd.array(np.zeros((dshape[0], k), dtype="int32"), ctx)
+            f(a, b, c)
+            tvm.testing.assert_allclose(c.asnumpy(), np_indices)
+            tvm.testing.assert_allclose(b.asnumpy(), np.take_along_axis(np_data, np_indices, 1))
+
+
+def test_argsort_nan():
+    # NaN is last in ascending and first in descending order, for rows sorted by comparison
+    # and for rows long enough for the radix sort.
+    ctx = tvm.cpu(0)
+    for size in [50, 1000]:
+        data = te.placeholder((2, size), name="data")
+        for is_ascend in [True, False]:
+            out = te.extern(
+                data.shape,
+                [data],
+                lambda ins, outs: tvm.tir.call_packed(
+                    "tvm.contrib.sort.argsort", ins[0], outs[0], 1, is_ascend
+                ),
+                dtype="int32",
+                name="argsort_tensor",
+            )
+            s = te.create_schedule(out.op)
+            f = tvm.build(s, [data, out], "llvm")
+            np_data = np.random.randint(-10, 10, size=data.shape).astype("float32")
+            np_data[:, ::7] = np.nan
+            np_data[1, ::14] = -np.nan
+            np_data[:, 1:3] = [np.inf, -np.inf]
+            expected = []
+            for row in np_data:
+                nan = np.flatnonzero(np.isnan(row))
+                num = np.flatnonzero(~np.isnan(row))
+                num = num[_stable_argsort(row[num], 0, is_ascend)]
+                expected.append(np.concatenate([num, nan] if is_ascend else [nan, num]))
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.zeros(data.shape, dtype=out.dtype), ctx)
+            f(a, b)
+            tvm.testing.assert_allclose(b.asnumpy(), np.array(expected))
+
+
+def test_sort_negative_sort_num():
+    data = te.placeholder((3, 4), name="data")
+    sort_num = te.placeholder((3,), name="sort_num", dtype="int32")
+    out = te.extern(
+        data.shape,
+        [data, sort_num],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.sort.argsort_nms", ins[0], ins[1], outs[0], 1, True
+        ),
+        dtype="int32",
+        name="sort_tensor",
+    )
+    ctx = tvm.cpu(0)
+    s = te.create_schedule(out.op)
+    f = tvm.build(s, [data, sort_num, out], "llvm")
+    np_data = np.array([[4, 3, 2, 1]] * 3, dtype="float32")
+    a = tvm.nd.array(np_data, ctx)
+    b = tvm.nd.array(np.array([-1, 0, 2], dtype="int32"), ctx)
+    c = tvm.nd.array(np.zeros(data.shape, dtype=out.dtype), ctx)
+    f(a, b, c)
+    tvm.testing.assert_allclose(c.asnumpy(), [[0, 1, 2, 3], [0, 1, 2, 3], [1, 0, 2, 3]])
+
+
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_argsort_large()
+    test_topk_large()
+    test_argsort_nan()
+    test_sort_negative_sort_num()
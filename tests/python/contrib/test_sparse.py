@@ -115,7 +115,37 @@ def test_sparse_array_tuple():
     tvm.testing.assert_allclose(c.asnumpy(), a.asnumpy() * 2.0, rtol=1e-5)
 
 
+def test_sparse_array_formats():
+    dtype = "float32"
+    ctx = tvm.cpu(0)
+    a = np.random.uniform(size=(8, 12)).astype(dtype)
+    a[a < 0.7] = 0.0
+    a[2:4, 4:8] = 0.0
+    bsr = tvmsp.array(a, ctx, stype="bsr", blocksize=(2, 4))
+    assert bsr.stype == "bsr" and bsr.blocksize == (2, 4)
+    assert bsr.data.shape[1:] == (2, 4)
+    assert bsr.indptr.shape == (5,)
+    tvm.testing.assert_allclose(bsr.asnumpy(), a)
+    # The arrays round trip through the tuple constructor.
+    bsr = tvmsp.array((bsr.data, bsr.indices, bsr.indptr), ctx, shape=a.shape, stype="bsr")
+    tvm.testing.assert_allclose(bsr.asnumpy(), a)
+
+    ell = tvmsp.array(a, ctx, stype="ell")
+    assert ell.stype == "ell"
+    assert ell.data.shape == (8, np.count_nonzero(a, axis=1).max())
+    assert ell.indices.shape == ell.data.shape
+    tvm.testing.assert_allclose(ell.asnumpy(), a)
+
+    A = tvmsp.placeholder(shape=(8, 12), nonzeros=3, name="A", stype="bsr", blocksize=(2, 4))
+    assert A.stype == "bsr"
+    assert tuple(A.data.shape) == (3, 2, 4) and tuple(A.indptr.shape) == (5,)
+    A = tvmsp.placeholder(shape=(8, 12), nonzeros=3, name="A", stype="ell")
+    assert A.stype == "ell"
+    assert tuple(A.data.shape) == (8, 3) and tuple(A.indices.shape) == (8, 3)
+
+
 if __name__ == "__main__":
     test_static_tensor()
     test_dynamic_tensor()
     test_sparse_array_tuple()
+    test_sparse_array_formats()
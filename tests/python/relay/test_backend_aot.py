@@ -0,0 +1,59 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import ctypes
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import util
+from tvm.relay.backend import aot
+
+
+def test_aot_c_host():
+    x = relay.var("x", shape=(2, 8), dtype="float32")
+    w = relay.var("w", shape=(4, 8), dtype="float32")
+    y = relay.nn.relu(relay.nn.dense(x, w))
+    z = relay.exp(y) + relay.const(1.0)
+    mod = tvm.IRModule.from_expr(relay.Function([x, w], relay.Tuple([y, z])))
+    x_data = np.random.uniform(-1, 1, size=(2, 8)).astype("float32")
+    w_data = np.random.uniform(-1, 1, size=(4, 8)).astype("float32")
+
+    lib = aot.build(mod, target="c", params={"w": w_data}, mod_name="model")
+    source = lib.imported_modules[0].get_source()
+    assert "model_run_model" in source
+    # Kernels are called directly, without looking them up.
+    assert "TVMFuncCall" not in source and "TVMBackendGetFuncFromEnv" not in source
+
+    temp = util.tempdir()
+    path = temp.relpath("model.so")
+    lib.export_library(path)
+    dll = ctypes.CDLL(path)
+    y_out = np.zeros((2, 4), dtype="float32")
+    z_out = np.zeros((2, 4), dtype="float32")
+    inputs = (ctypes.c_void_p * 1)(x_data.ctypes.data)
+    outputs = (ctypes.c_void_p * 2)(y_out.ctypes.data, z_out.ctypes.data)
+    for _ in range(2):
+        assert dll.model_run_model(inputs, outputs) == 0
+        y_ref = np.maximum(np.dot(x_data, w_data.T), 0)
+        tvm.testing.assert_allclose(y_out, y_ref, rtol=1e-5)
+        tvm.testing.assert_allclose(z_out, np.exp(y_ref) + 1, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    test_aot_c_host()
@@ -194,6 +194,23 @@ def test_compile_engine():
     engine.dump()
 
 
+def test_compile_engine_reuse_hash():
+    engine = relay.backend.compile_engine.get()
+    engine.clear()
+    x = relay.var("x", shape=(10,))
+    func = relay.Function([x], relay.add(x, x))
+    func = relay.transform.InferType()(tvm.IRModule.from_expr(func))["main"]
+    copy = relay.Function(func.params, func.body, func.ret_type, func.type_params, func.attrs)
+    # A new key for the function of a cached key, or for a copy, hits the same entry.
+    z1 = engine.lower(func, "llvm")
+    assert engine.lower(func, "llvm").same_as(z1)
+    assert engine.lower(copy, "llvm").same_as(z1)
+    # The entries and the hashes of their functions are dropped together.
+    engine.clear()
+    assert not engine.items()
+    assert not engine.lower(func, "llvm").same_as(z1)
+
+
 def test_compile_placeholder_bypass():
     engine = relay.backend.compile_engine.get()
     x = relay.var("x", shape=(2, 3))
@@ -263,6 +280,7 @@ if __name__ == "__main__":
     test_get_valid_implementations()
     test_select_implementation()
     test_compile_engine()
+    test_compile_engine_reuse_hash()
     test_compile_placeholder_bypass()
     test_compile_injective_with_tuple()
     test_compile_tuple_dup()
@@ -144,6 +144,73 @@ def test_plan_memory():
     assert len(device_types) == 1
 
 
+def _storage_ids(smap):
+    storage_ids = set()
+    for v in smap.values():
+        for x in v[0]:
+            storage_ids.add(x.value)
+    return storage_ids
+
+
+def test_plan_memory_inplace():
+    x = relay.var("x", shape=(10,))
+    z = relay.exp(x)
+    for _ in range(4):
+        z = relay.exp(z)
+    func = relay.Function([x], z)
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.FuseOps(0)(mod)
+    func = mod["main"]
+
+    # Without in-place reuse, the chain alternates between two buffers.
+    assert len(_storage_ids(relay.backend._backend.GraphPlanMemory(func))) == 3
+    stats = relay.backend._backend.GraphPlanMemoryStats(func)
+    assert stats["activation_bytes"].value == 80
+    assert stats["peak_live_bytes"].value == 80
+
+    with tvm.transform.PassContext(config={"relay.GraphPlanMemory.inplace": True}):
+        assert len(_storage_ids(relay.backend._backend.GraphPlanMemory(func))) == 2
+        stats = relay.backend._backend.GraphPlanMemoryStats(func)
+    assert stats["activation_bytes"].value == 40
+    assert stats["peak_live_bytes"].value == 40
+
+
+def test_plan_memory_reuse_small_blocks():
+    x = relay.var("x", shape=(1,))
+    z = relay.broadcast_to(relay.exp(x), (64,))
+    func = relay.Function([x], relay.exp(z))
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.FuseOps(0)(mod)
+    func = mod["main"]
+
+    # By default a free block 64 times smaller than the request is not reused.
+    assert len(_storage_ids(relay.backend._backend.GraphPlanMemory(func))) == 4
+    assert relay.backend._backend.GraphPlanMemoryStats(func)["activation_bytes"].value == 516
+
+    with tvm.transform.PassContext(config={"relay.GraphPlanMemory.reuse_small_blocks": True}):
+        assert len(_storage_ids(relay.backend._backend.GraphPlanMemory(func))) == 3
+        stats = relay.backend._backend.GraphPlanMemoryStats(func)
+    assert stats["activation_bytes"].value == 512
+
+
+def test_inplace_execution():
+    x = relay.var("x", shape=(4, 8))
+    y = relay.var("y", shape=(8,))
+    # transpose is injective but not element-wise and must not run in place.
+    z = relay.transpose(relay.exp(x))
+    z = relay.add(relay.sigmoid(z), relay.const(1.0))
+    z = relay.nn.bias_add(relay.transpose(z), y)
+    func = relay.Function([x, y], z)
+    x_data = np.random.rand(4, 8).astype("float32")
+    y_data = np.random.rand(8).astype("float32")
+    ref_res = 1.0 / (1.0 + np.exp(-np.exp(x_data))) + 1.0 + y_data
+    with tvm.transform.PassContext(opt_level=0, config={"relay.GraphPlanMemory.inplace": True}):
+        graph, lib, params = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    mod = graph_runtime.create(graph, lib, tvm.cpu())
+    mod.run(x=x_data, y=y_data)
+    tvm.testing.assert_allclose(mod.get_output(0).asnumpy(), ref_res, rtol=1e-5)
+
+
 @tvm.testing.uses_gpu
 def test_gru_like():
     def unit(rnn_dim):
@@ -184,6 +251,9 @@ def test_gru_like():
 
 if __name__ == "__main__":
     test_plan_memory()
+    test_plan_memory_inplace()
+    test_plan_memory_reuse_small_blocks()
+    test_inplace_execution()
     test_with_params()
     test_add_op_scalar()
     test_add_op_tensor()
@@ -1460,8 +1460,10 @@ def test_conv2d_int8_intrinsics():
             return "pmaddubs" in asm
         elif "cascadelake" in target:
             return "vpdpbusd" in asm
+        elif "core-avx2" in target:
+            return "vpmaddwd" in asm
         else:
-            assert False, "Target should be Skylake or Cascadelake"
+            assert False, "Target should be Skylake, Cascadelake or AVX2"
 
     # TODO(@anijain2305, @icemelon9): disable conv2d_int8 for NHWC data layout.
     #   Re-enable this after adding conv2d_NCHWc_int8 support for NHWC.
@@ -1543,7 +1545,7 @@ def test_conv2d_int8_intrinsics():
 
     # Check that a vectorized instruction is generated for older Intel
     # generations, because we default to NCHWc layout.
-    target = "llvm -mcpu=core-avx2"
+    target = "llvm -mcpu=corei7-avx"
     fast_int8_dtypes = ("uint8", "int8", "int32")
     asm = _compile(
         ic=16,
@@ -1556,6 +1558,22 @@ def test_conv2d_int8_intrinsics():
     # Check that vector int mult and add instructions are generated.
     assert "vpmulld" in asm and "vpadd" in asm
 
+    # AVX2 uses the exact int16 vpmaddwd dot product when LLVM supports the
+    # int8 schedules, and the vectorized NCHWc fallback otherwise.
+    target = "llvm -mcpu=core-avx2"
+    asm = _compile(
+        ic=16,
+        oc=32,
+        target=target,
+        data_layout="NCHW",
+        kernel_layout="OIHW",
+        dtypes=fast_int8_dtypes,
+    )
+    if llvm_version >= 8:
+        assert _has_fast_int8_instructions(asm, target)
+    else:
+        assert "vpmulld" in asm and "vpadd" in asm
+
 
 @tvm.testing.uses_gpu
 def test_depthwise_conv2d_int8():
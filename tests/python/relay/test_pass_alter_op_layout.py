@@ -22,6 +22,7 @@ from tvm import relay
 from tvm.relay import transform, analysis
 from tvm.relay.testing.temp_op_attr import TempOpAttr
 from tvm.relay.testing import run_infer_type
+from tvm.contrib import graph_runtime
 import numpy as np
 import tvm.testing
 
@@ -1115,6 +1116,57 @@ def test_alter_op_with_global_var():
     assert tvm.ir.structural_equal(a, b, map_free_vars=True), "Actual = \n" + str(a)
 
 
+@tvm.testing.requires_llvm
+def test_alter_layout_dense_int8_x86():
+    """Check that the int8 dense weight is packed once in the graph."""
+    if tvm.target.codegen.llvm_version_major() < 8:
+        print("Skip because the int8 intrinsics need LLVM 8")
+        return
+    target = "llvm -mcpu=core-avx2"
+    M, N, K = 16, 64, 256
+
+    def before():
+        x = relay.var("x", shape=(M, K), dtype="uint8")
+        w = relay.var("w", shape=(N, K), dtype="int8")
+        y = relay.nn.dense(x, w, out_dtype="int32")
+        y = relay.Function(analysis.free_vars(y), y)
+        return y
+
+    def alter_dense(attrs, inputs, tinfos, out_type):
+        from tvm import topi
+
+        with tvm.target.Target(target):
+            return topi.nn.dense_alter_layout(attrs, inputs, tinfos, out_type)
+
+    def expected():
+        x = relay.var("x", shape=(M, K), dtype="uint8")
+        w = relay.var("w", shape=(N, K), dtype="int8")
+        w = relay.layout_transform(w, "NC", "NC8n4c")
+        y = relay.nn.contrib_dense_pack(x, w, weight_layout="NC8n4c", out_dtype="int32")
+        y = relay.Function(analysis.free_vars(y), y)
+        return y
+
+    with TempOpAttr("nn.dense", "FTVMAlterOpLayout", alter_dense):
+        a = before()
+        a = run_opt_pass(a, transform.AlterOpLayout())
+        b = run_opt_pass(expected(), transform.InferType())
+
+    assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a)
+
+    # The packed weight is a constant after FoldConstant, check the results
+    # on the full range of the inputs.
+    x_np = np.random.randint(low=0, high=256, size=(M, K)).astype("uint8")
+    w_np = np.random.randint(low=-128, high=128, size=(N, K)).astype("int8")
+    ref = np.dot(x_np.astype("int32"), w_np.T.astype("int32"))
+    mod = tvm.IRModule.from_expr(before())
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target, params={"w": w_np})
+    m = graph_runtime.GraphModule(lib["default"](tvm.cpu(0)))
+    m.set_input("x", x_np)
+    m.run()
+    tvm.testing.assert_allclose(m.get_output(0).asnumpy(), ref, rtol=0)
+
+
 if __name__ == "__main__":
     test_alter_op()
     test_alter_return_none()
@@ -1136,3 +1188,4 @@ if __name__ == "__main__":
     test_alter_layout_nhwc_arm()
     test_alter_layout_nhwc_int8_aarch64()
     test_alter_op_with_global_var()
+    test_alter_layout_dense_int8_x86()
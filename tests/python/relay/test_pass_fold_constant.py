@@ -251,6 +251,22 @@ def test_fold_batch_norm():
     assert tvm.ir.structural_equal(mod["main"], expect)
 
 
+def test_fold_deep_chain():
+    c_data = np.array([1, 2, 3]).astype("float32")
+
+    def chain(init):
+        x = relay.var("x", shape=(3,), dtype="float32")
+        y = relay.add(x, init)
+        for _ in range(10000):
+            y = relay.add(y, relay.const(c_data))
+        return relay.Function([x], y)
+
+    c = relay.const(c_data)
+    zz = run_opt_pass(chain(relay.add(c, c)), transform.FoldConstant())
+    zexpected = run_opt_pass(chain(relay.const(c_data + c_data)), transform.InferType())
+    assert tvm.ir.structural_equal(zz, zexpected)
+
+
 if __name__ == "__main__":
     test_fold_const()
     test_fold_let()
@@ -260,3 +276,4 @@ if __name__ == "__main__":
     test_fold_full()
     test_fold_batch_norm()
     test_fold_ndarray_size()
+    test_fold_deep_chain()
@@ -752,6 +752,37 @@ def test_fuse_max_diamond():
     assert tvm.ir.structural_equal(fused, expected)
 
 
+def test_fuse_deep_diamonds():
+    """Post-dominators are found through long chains of diamonds."""
+
+    def before(num_diamond):
+        x = relay.var("x", shape=(10, 20))
+        out = x
+        for _ in range(num_diamond):
+            out = relay.add(relay.exp(out), relay.sqrt(out))
+        return relay.Function([x], out)
+
+    def after(num_diamond, max_fused_ops):
+        inp = relay.var("x", shape=(10, 20))
+        out = inp
+        num_fused = max_fused_ops // 3
+        for begin in range(0, num_diamond, num_fused):
+            p = relay.var("p", shape=(10, 20))
+            body = p
+            for _ in range(min(num_fused, num_diamond - begin)):
+                body = relay.add(relay.exp(body), relay.sqrt(body))
+            f = relay.Function([p], body).with_attr("Primitive", tvm.tir.IntImm("int32", 1))
+            out = relay.Call(f, [out])
+        return relay.Function([inp], out)
+
+    num_diamond = 2000
+    max_fused_ops = 30
+    with tvm.transform.PassContext(config={"relay.FuseOps.max_depth": max_fused_ops}):
+        fused = run_opt_pass(before(num_diamond), transform.FuseOps())
+    expected = run_opt_pass(after(num_diamond, max_fused_ops), transform.InferType())
+    assert tvm.ir.structural_equal(fused, expected)
+
+
 if __name__ == "__main__":
     test_fuse_simple()
     test_conv2d_fuse()
@@ -772,3 +803,4 @@ if __name__ == "__main__":
     test_fuse_gather_nd()
     test_fuse_bcast_reduce_scalar()
     test_fuse_max_diamond()
+    test_fuse_deep_diamonds()
@@ -287,6 +287,41 @@ def test_function_pass():
     test_pass_run()
 
 
+def test_function_pass_incremental():
+    x = relay.var("x", shape=(10,))
+    callee = relay.GlobalVar("callee")
+    caller = relay.GlobalVar("caller")
+    other = relay.GlobalVar("other")
+    top = relay.GlobalVar("top")
+    mod = tvm.IRModule(
+        {
+            callee: relay.Function([x], relay.log(x)),
+            caller: relay.Function([x], callee(x)),
+            top: relay.Function([x], caller(x)),
+            other: relay.Function([x], relay.exp(x)),
+        }
+    )
+    mod = _transform.InferType()(mod)
+
+    @_transform.function_pass(opt_level=1)
+    def rewrite_callee(func, mod, ctx):
+        if func.same_as(mod[callee]):
+            return relay.Function([x], relay.log(relay.add(x, x)))
+        return func
+
+    # By default every function is checked again.
+    updated = rewrite_callee(mod)
+    assert not updated[other].same_as(mod[other])
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        updated = rewrite_callee(mod)
+    # Only the rewritten function and its callers, also indirect ones, are checked again.
+    assert updated[other].same_as(mod[other])
+    assert not updated[caller].same_as(mod[caller])
+    assert not updated[top].same_as(mod[top])
+    assert updated[caller].body.checked_type == updated[callee].checked_type.ret_type
+    check_func(updated[callee], relay.Function([x], relay.log(relay.add(x, x))))
+
+
 def test_module_class_pass():
     @tvm.transform.module_pass(opt_level=1)
     class TestPipeline:
@@ -0,0 +1,180 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+
+def get_conv2d_epilogue(rounding="UPWARD"):
+    np.random.seed(0)
+    data = relay.var("data", shape=(1, 4, 8, 8), dtype="uint8")
+    weight = relay.const(np.random.randint(-128, 128, (8, 4, 3, 3)).astype("int8"))
+    out = relay.qnn.op.conv2d(
+        data,
+        weight,
+        input_zero_point=relay.const(120, "int32"),
+        kernel_zero_point=relay.const(0, "int32"),
+        input_scale=relay.const(0.05, "float32"),
+        kernel_scale=relay.const(np.random.uniform(0.01, 0.05, 8).astype("float32")),
+        kernel_size=(3, 3),
+        channels=8,
+        padding=(1, 1),
+    )
+    bias = relay.const(np.random.randint(-5000, 5000, 8).astype("int32"))
+    out = relay.nn.bias_add(out, bias)
+    out = relay.qnn.op.requantize(
+        out,
+        input_scale=relay.const(np.random.uniform(0.0005, 0.0025, 8).astype("float32")),
+        input_zero_point=relay.const(0, "int32"),
+        output_scale=relay.const(0.2, "float32"),
+        output_zero_point=relay.const(10, "int32"),
+        axis=1,
+        rounding=rounding,
+        out_dtype="uint8",
+    )
+    out = relay.clip(out, a_min=10, a_max=200)
+    return tvm.IRModule.from_expr(relay.Function([data], out))
+
+
+def get_dense_epilogue():
+    np.random.seed(1)
+    data = relay.var("data", shape=(3, 4), dtype="uint8")
+    weight = relay.const(np.random.randint(-128, 128, (16, 4)).astype("int8"))
+    out = relay.qnn.op.dense(
+        data,
+        weight,
+        input_zero_point=relay.const(128, "int32"),
+        kernel_zero_point=relay.const(0, "int32"),
+        input_scale=relay.const(0.5, "float32"),
+        kernel_scale=relay.const(0.5, "float32"),
+        units=16,
+    )
+    out = relay.add(out, relay.const(np.random.randint(-100, 100, (1, 16)).astype("int32")))
+    out = relay.qnn.op.requantize(
+        out,
+        input_scale=relay.const(0.25, "float32"),
+        input_zero_point=relay.const(3, "int32"),
+        output_scale=relay.const(64.0, "float32"),
+        output_zero_point=relay.const(-2, "int32"),
+        out_dtype="int32",
+    )
+    out = relay.cast(relay.clip(out, a_min=-128, a_max=127), "int8")
+    return tvm.IRModule.from_expr(relay.Function([data], out))
+
+
+def fuse(mod):
+    return relay.qnn.transform.FuseRequantize()(mod)
+
+
+def primitive_ops(mod):
+    """The op names of each primitive function the build lowers."""
+    with tvm.transform.PassContext(opt_level=3):
+        mod, _ = relay.optimize(mod, "llvm")
+    stages = []
+
+    def visit(node):
+        if isinstance(node, relay.Function) and node.attrs and "Primitive" in node.attrs:
+            ops = set()
+            relay.analysis.post_order_visit(
+                node.body,
+                lambda x: ops.add(x.op.name)
+                if isinstance(x, relay.Call) and isinstance(x.op, tvm.ir.Op)
+                else None,
+            )
+            stages.append(ops)
+
+    relay.analysis.post_order_visit(mod["main"], visit)
+    return stages
+
+
+def run(mod, data):
+    with tvm.transform.PassContext(opt_level=3):
+        graph, lib, params = relay.build(mod, "llvm")
+    rt_mod = graph_runtime.create(graph, lib, ctx=tvm.cpu(0))
+    rt_mod.set_input("data", data)
+    rt_mod.set_input(**params)
+    rt_mod.run()
+    return rt_mod.get_output(0).asnumpy()
+
+
+def test_fuse_conv2d_epilogue():
+    mod = fuse(get_conv2d_epilogue())
+    call = mod["main"].body
+    assert call.op.name == "qnn.fixed_point_requantize"
+    assert call.args[0].op.name == "qnn.conv2d"
+    assert call.attrs.out_min == 10 and call.attrs.out_max == 200
+    assert call.attrs.out_dtype == "uint8"
+    assert call.attrs.compute_dtype == "int64"
+    # The zero point of the requantize input is folded into the bias.
+    assert call.args[1].data.shape == (8,)
+
+    data = np.random.randint(0, 256, (1, 4, 8, 8)).astype("uint8")
+    np.testing.assert_equal(run(mod, data), run(get_conv2d_epilogue(), data))
+
+
+def test_fuse_dense_epilogue_int32():
+    mod = fuse(get_dense_epilogue())
+    call = mod["main"].body
+    assert call.op.name == "qnn.fixed_point_requantize"
+    assert call.args[0].op.name == "qnn.dense"
+    # The clip and the cast are folded, and the small reduction keeps the products in int32.
+    assert call.attrs.out_dtype == "int8"
+    assert call.attrs.compute_dtype == "int32"
+    assert call.attrs.fractional_bits < 31
+
+    data = np.random.randint(0, 256, (3, 4)).astype("uint8")
+    np.testing.assert_equal(run(mod, data), run(get_dense_epilogue(), data))
+
+
+def test_keep_tonearest():
+    mod = fuse(get_conv2d_epilogue(rounding="TONEAREST"))
+    assert mod["main"].body.op.name == "clip"
+    assert mod["main"].body.args[0].op.name == "qnn.requantize"
+
+
+def test_build_keeps_fused_epilogue():
+    # The build does not fuse on its own.
+    for ops in primitive_ops(get_dense_epilogue()):
+        assert "qnn.fixed_point_requantize" not in ops
+    # The fused op reaches the lowering, in the same stage as its producer. The conv2d
+    # can be altered to a blocked layout, so match the producer by name.
+    for get_mod, producer in [(get_dense_epilogue, "dense"), (get_conv2d_epilogue, "conv2d")]:
+        stages = primitive_ops(fuse(get_mod()))
+        stages = [ops for ops in stages if any(producer in name for name in ops)]
+        assert len(stages) == 1
+        assert "qnn.fixed_point_requantize" in stages[0]
+        assert "qnn.requantize" not in stages[0] and "clip" not in stages[0]
+
+
+def test_canonicalize_fused_epilogue():
+    # External codegens get the fused op lowered to core Relay ops, with the same result.
+    mod = relay.transform.InferType()(fuse(get_dense_epilogue()))
+    mod = relay.qnn.transform.CanonicalizeOps()(mod)
+    assert "qnn." not in mod.astext(show_meta_data=False)
+
+    data = np.random.randint(0, 256, (3, 4)).astype("uint8")
+    np.testing.assert_equal(run(mod, data), run(get_dense_epilogue(), data))
+
+
+if __name__ == "__main__":
+    test_fuse_conv2d_epilogue()
+    test_fuse_dense_epilogue_int32()
+    test_keep_tonearest()
+    test_build_keeps_fused_epilogue()
+    test_canonicalize_fused_epilogue()
@@ -0,0 +1,78 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+
+def random_pruned_hwio(shape, blocksize, density):
+    """A HWIO kernel whose (out_channel, kh * kw * in_channel) matrix has dense blocks."""
+    w = np.random.randn(*shape).astype("float32")
+    mat = w.reshape(-1, shape[-1]).T
+    mask = np.random.random((mat.shape[0] // blocksize[0], mat.shape[1] // blocksize[1]))
+    mat = mat * np.kron(mask < density, np.ones(blocksize))
+    return np.ascontiguousarray(mat.T).reshape(shape).astype("float32")
+
+
+def run_func(func, params, x):
+    with tvm.transform.PassContext(opt_level=3):
+        graph, lib, new_params = relay.build(func, "llvm", params=params)
+    m = graph_runtime.create(graph, lib, tvm.cpu(0))
+    m.set_input("data", tvm.nd.array(x.astype("float32")))
+    m.set_input(**new_params)
+    m.run()
+    return m.get_output(0).asnumpy()
+
+
+def test_bsr_sparse_conv2d():
+    data = relay.var("data", shape=(1, 10, 10, 16), dtype="float32")
+    x = relay.nn.relu(data)
+    w1 = relay.var("weight1", shape=(3, 3, 16, 32), dtype="float32")
+    y = relay.nn.conv2d(
+        x, w1, kernel_size=(3, 3), padding=(1, 1), data_layout="NHWC", kernel_layout="HWIO"
+    )
+    w2 = relay.var("weight2", shape=(1, 1, 32, 64), dtype="float32")
+    y = relay.nn.conv2d(
+        y, w2, kernel_size=(1, 1), strides=(2, 2), data_layout="NHWC", kernel_layout="HWIO"
+    )
+    # A dense weight stays a conv2d.
+    w3 = relay.var("weight3", shape=(1, 1, 64, 8), dtype="float32")
+    y = relay.nn.conv2d(y, w3, kernel_size=(1, 1), data_layout="NHWC", kernel_layout="HWIO")
+    z = relay.nn.relu(y)
+    func = relay.Function(relay.analysis.free_vars(z), z)
+
+    params = {
+        "weight1": tvm.nd.array(random_pruned_hwio((3, 3, 16, 32), (8, 1), 0.1)),
+        "weight2": tvm.nd.array(random_pruned_hwio((1, 1, 32, 64), (8, 1), 0.1)),
+        "weight3": tvm.nd.array(np.random.randn(1, 1, 64, 8).astype("float32")),
+    }
+
+    x_np = np.random.randn(1, 10, 10, 16).astype("float32")
+    dense_output = run_func(func, params, x_np)
+    sparse_func, params = relay.data_dep_optimization.bsr_conv2d.convert(
+        func, params, (8, 1), 0.5
+    )
+    assert "weight1.data" in params and "weight2.data" in params and "weight3" in params
+    assert "nn.sparse_conv2d" in sparse_func.astext()
+    sparse_output = run_func(sparse_func, params, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-4, rtol=1e-4)
+
+
+if __name__ == "__main__":
+    test_bsr_sparse_conv2d()
@@ -393,5 +393,59 @@ def @main(%f: float32) -> float32 {
     tvm.ir.assert_structural_equal(mod["main"].body.type_args, [relay.TensorType((), "float32")])
 
 
+def test_deep_dataflow():
+    x = relay.var("x", shape=(1, 4), dtype="float32")
+    y = x
+    for i in range(10000):
+        if i % 100 == 0:
+            y = relay.TupleGetItem(relay.Tuple([y, x]), 0)
+        y = relay.add(y, relay.const(1.0))
+    func = relay.Function([x], y)
+    func = run_infer_type(func)
+    tvm.ir.assert_structural_equal(func.ret_type, relay.TensorType((1, 4), "float32"))
+    assert func.body.args[0].checked_type == func.ret_type
+
+
+def test_incremental():
+    x = relay.var("x", shape=(2, 4), dtype="float32")
+    w = relay.var("w", shape=(4, 4), dtype="float32")
+    func = relay.Function([x, w], relay.nn.relu(relay.nn.dense(x, w)))
+    func = transform.InferType()(tvm.IRModule.from_expr(func))["main"]
+
+    # Rebuild the function around the dense, which keeps its checked type.
+    dense = func.body.args[0]
+    v = relay.var("v")
+    z = relay.Tuple([dense, relay.add(dense, relay.const(1.0))])
+    body = relay.Let(v, z, relay.sigmoid(relay.TupleGetItem(v, 1)))
+    mod = tvm.IRModule({"main": relay.Function(func.params, body)})
+
+    full = transform.InferType()(mod)
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        incremental = transform.InferType()(mod)
+    tvm.ir.assert_structural_equal(incremental, full)
+    tvm.ir.assert_structural_equal(incremental["main"].checked_type, full["main"].checked_type)
+    assert analysis.well_formed(incremental["main"])
+
+
+def test_incremental_callee_type_change():
+    x = relay.var("x", shape=(10,))
+    callee = relay.GlobalVar("callee")
+    mod = tvm.IRModule({callee: relay.Function([x], relay.log(x))})
+    mod["main"] = relay.Function([x], relay.nn.relu(callee(x)))
+    main_var = mod.get_global_var("main")
+
+    # Change the signature of the callee and keep the typed caller as it is.
+    y = relay.var("y", shape=(10,))
+    new_callee = run_infer_type(relay.Function([y], relay.sum(y)))
+    mod = tvm.IRModule({callee: new_callee, main_var: mod[main_var]})
+
+    full = transform.InferType()(mod)
+    assert full["main"].checked_type.ret_type == relay.TensorType((), "float32")
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": True}):
+        incremental = transform.InferType()(mod)
+    tvm.ir.assert_structural_equal(incremental["main"].checked_type, full["main"].checked_type)
+    tvm.ir.assert_structural_equal(incremental["main"], full["main"])
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -65,6 +65,27 @@ def verify_batch_matmul(batch, M, N, K):
         check_device(device, ctx)
 
 
+def verify_batch_matmul_int8_x86(batch, M, N, K):
+    x = te.placeholder((batch, M, K), name="x", dtype="uint8")
+    y = te.placeholder((batch, N, K), name="y", dtype="int8")
+    a_np = np.random.randint(low=0, high=256, size=(batch, M, K)).astype("uint8")
+    b_np = np.random.randint(low=-128, high=128, size=(batch, N, K)).astype("int8")
+    c_np = tvm.topi.testing.batch_matmul(a_np.astype("int32"), b_np.astype("int32"))
+
+    target = "llvm -mcpu=core-avx2"
+    with tvm.target.Target(target):
+        out = topi.x86.batch_matmul_int8(x, y)
+        s = topi.x86.schedule_batch_matmul_int8([out])
+    f = tvm.build(s, [x, y, out], target, name="batch_matmul_int8")
+    assert "vpmaddwd" in f.get_source("asm")
+    ctx = tvm.cpu(0)
+    a = tvm.nd.array(a_np, ctx)
+    b = tvm.nd.array(b_np, ctx)
+    c = tvm.nd.array(np.zeros(get_const_tuple(out.shape), dtype="int32"), ctx)
+    f(a, b, c)
+    tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=0)
+
+
 @tvm.testing.uses_gpu
 def test_batch_matmul():
     verify_batch_matmul(1, 16, 16, 32)
@@ -73,5 +94,15 @@ def test_batch_matmul():
     verify_batch_matmul(30, 16, 20, 32)
 
 
+@tvm.testing.requires_llvm
+def test_batch_matmul_int8_x86():
+    if tvm.target.codegen.llvm_version_major() < 8:
+        print("Skip because the int8 intrinsics need LLVM 8")
+        return
+    verify_batch_matmul_int8_x86(1, 16, 16, 32)
+    verify_batch_matmul_int8_x86(5, 12, 24, 64)
+
+
 if __name__ == "__main__":
     test_batch_matmul()
+    test_batch_matmul_int8_x86()
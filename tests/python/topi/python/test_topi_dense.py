@@ -128,6 +128,59 @@ def verify_dense_int8(batch, in_dim, out_dim, use_bias=True):
         check_device(device)
 
 
+def requantize_python(acc, multiplier, shift, zero_point, out_dtype):
+    """Reference of topi.nn.fixed_point_requantize, rounding like tir.q_multiply_shift"""
+    x = acc.astype("int64")
+    total_shift = 31 + max(-shift, 0)
+    x = (x << max(shift, 0)) * multiplier
+    x = ((x + (1 << (total_shift - 1))) >> total_shift) + zero_point
+    info = np.iinfo(out_dtype)
+    return np.clip(x, info.min, info.max).astype(out_dtype)
+
+
+def verify_dense_int8_x86(batch, in_dim, out_dim, use_bias=True, requantize=False):
+    A = te.placeholder((batch, in_dim), name="A", dtype="uint8")
+    B = te.placeholder((out_dim, in_dim), name="B", dtype="int8")
+    C = te.placeholder((out_dim,), name="C", dtype="int32")
+    multiplier, shift = topi.nn.get_fixed_point_multiplier_shift(0.0123)
+
+    a_np = np.random.randint(low=0, high=256, size=(batch, in_dim)).astype("uint8")
+    b_np = np.random.randint(low=-128, high=128, size=(out_dim, in_dim)).astype("int8")
+    c_np = np.random.randint(low=-1000, high=1000, size=(out_dim,)).astype("int32")
+    d_np = np.dot(a_np.astype("int32"), b_np.T.astype("int32"))
+    if use_bias:
+        d_np += c_np
+    if requantize:
+        d_np = requantize_python(d_np, multiplier, shift, 10, "uint8")
+
+    def check_target(target, run):
+        with tvm.target.Target(target):
+            D = topi.x86.dense_int8(A, B, C if use_bias else None, "int32")
+            if requantize:
+                D = topi.nn.fixed_point_requantize(D, multiplier, shift, 10, "uint8")
+            s = topi.x86.schedule_dense_int8([D])
+        f = tvm.build(s, [A, B, C, D], target, name="dense_int8")
+        asm = f.get_source("asm")
+        if "core-avx2" in target:
+            assert "vpmaddwd" in asm
+        else:
+            assert "pmaddubs" in asm or "vpdpbusd" in asm
+        if not run:
+            return
+        ctx = tvm.cpu(0)
+        a = tvm.nd.array(a_np, ctx)
+        b = tvm.nd.array(b_np, ctx)
+        c = tvm.nd.array(c_np, ctx)
+        d = tvm.nd.array(np.zeros(get_const_tuple(D.shape), dtype=D.dtype), ctx)
+        f(a, b, c, d)
+        tvm.testing.assert_allclose(d.asnumpy(), d_np, rtol=0)
+
+    # Only AVX2 code runs on the host, the AVX512 kernels are compiled.
+    check_target("llvm -mcpu=core-avx2", True)
+    check_target("llvm -mcpu=skylake-avx512", False)
+    check_target("llvm -mcpu=cascadelake", False)
+
+
 @tvm.testing.uses_gpu
 def test_dense():
     verify_dense(1, 1024, 1000, use_bias=True)
@@ -145,6 +198,17 @@ def test_dense_int8():
         verify_dense_int8(2, 1024, 1000, use_bias=False)
 
 
+@tvm.testing.requires_llvm
+def test_dense_int8_x86():
+    if tvm.target.codegen.llvm_version_major() < 8:
+        print("Skip because the int8 intrinsics need LLVM 8")
+        return
+    verify_dense_int8_x86(1, 1024, 1008, use_bias=True)
+    verify_dense_int8_x86(16, 256, 64, use_bias=False)
+    verify_dense_int8_x86(16, 256, 64, use_bias=True, requantize=True)
+
+
 if __name__ == "__main__":
     test_dense()
     test_dense_int8()
+    test_dense_int8_x86()
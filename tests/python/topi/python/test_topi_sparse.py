@@ -33,6 +33,11 @@ _sparse_dense_implement = {
     "x86": (topi.nn.sparse_dense, topi.x86.schedule_sparse_dense),
 }
 
+_sparse_conv2d_implement = {
+    "generic": (topi.nn.sparse_conv2d, topi.generic.schedule_sparse_conv2d),
+    "x86": (topi.nn.sparse_conv2d, topi.x86.schedule_sparse_conv2d),
+}
+
 
 def verify_dynamic_csrmv(batch, in_dim, out_dim, use_bias=True):
     nr, nc, n = te.var("nr"), te.var("nc"), te.var("n")
@@ -421,6 +426,107 @@ def test_sparse_dense_bsr_randomized():
             check_device(device)
 
 
+def verify_sparse_conv2d(in_shape, kernel, out_channel, stride, padding, blocksize, use_relu):
+    kernel_h, kernel_w = kernel
+    X_np = np.random.randn(*in_shape).astype("float32")
+    W_np = np.random.randn(kernel_h, kernel_w, in_shape[3], out_channel).astype("float32")
+    # Prune the HWIO kernel by blocks of its (out_channel, kernel_h * kernel_w * in_channel) matrix.
+    W_mat = W_np.reshape(-1, out_channel).T
+    mask = np.random.random((out_channel // blocksize[0], W_mat.shape[1] // blocksize[1])) < 0.2
+    W_mat = W_mat * np.kron(mask, np.ones(blocksize)).astype("float32")
+    W_np = np.ascontiguousarray(W_mat.T).reshape(W_np.shape)
+    if blocksize == (1, 1):
+        W_sp_np = sp.csr_matrix(W_mat)
+    else:
+        W_sp_np = sp.bsr_matrix(W_mat, blocksize=blocksize)
+    Y_np = tvm.topi.testing.conv2d_nhwc_python(X_np, W_np, stride, padding)
+    if use_relu:
+        Y_np = np.maximum(Y_np, 0.0)
+
+    W_data = te.placeholder(shape=W_sp_np.data.shape, dtype=str(W_sp_np.data.dtype))
+    W_indices = te.placeholder(shape=W_sp_np.indices.shape, dtype=str(W_sp_np.indices.dtype))
+    W_indptr = te.placeholder(shape=W_sp_np.indptr.shape, dtype=str(W_sp_np.indptr.dtype))
+    X = te.placeholder(shape=X_np.shape, dtype=str(X_np.dtype))
+
+    for device in ["llvm"]:
+        ctx = tvm.context(device, 0)
+        fcompute, fschedule = tvm.topi.testing.dispatch(device, _sparse_conv2d_implement)
+        with tvm.target.Target(device):
+            Y = fcompute(X, W_data, W_indices, W_indptr, kernel, stride, padding)
+            if use_relu:
+                Y = topi.nn.relu(Y)
+            s = fschedule([Y])
+            func = tvm.build(s, [X, W_data, W_indices, W_indptr, Y])
+            Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype=Y_np.dtype), ctx=ctx)
+            func(
+                tvm.nd.array(X_np, ctx=ctx),
+                tvm.nd.array(W_sp_np.data, ctx=ctx),
+                tvm.nd.array(W_sp_np.indices, ctx=ctx),
+                tvm.nd.array(W_sp_np.indptr, ctx=ctx),
+                Y_tvm,
+            )
+            tvm.testing.assert_allclose(Y_tvm.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
+def test_sparse_conv2d():
+    # 1x1 kernels are a sparse dense of the pixels.
+    verify_sparse_conv2d((1, 8, 8, 32), (1, 1), 64, (1, 1), (0, 0), (1, 1), use_relu=False)
+    verify_sparse_conv2d((2, 8, 8, 32), (1, 1), 64, (2, 2), (0, 0), (16, 1), use_relu=True)
+    verify_sparse_conv2d((1, 7, 9, 8), (3, 3), 16, (1, 1), (1, 1), (1, 1), use_relu=True)
+    verify_sparse_conv2d((1, 7, 9, 8), (3, 3), 16, (2, 1), (1, 0), (8, 4), use_relu=False)
+
+
+def test_sparse_dense_ell():
+    M, N, K = 3, 24, 40
+    X_np = np.random.randn(M, K).astype("float32")
+    W_np = np.random.randn(N, K).astype("float32") * (np.random.random((N, K)) < 0.2)
+    B_np = np.random.randn(N).astype("float32")
+    W_ell = tvmsp.array(W_np.astype("float32"), stype="ell")
+    Y_np = X_np.dot(W_np.T) + B_np
+
+    X = te.placeholder(shape=X_np.shape, dtype="float32")
+    B = te.placeholder(shape=B_np.shape, dtype="float32")
+    W = tvmsp.placeholder(shape=W_np.shape, nonzeros=W_ell.data.shape[1], stype="ell")
+    Y = topi.sparse.dense(X, W, B)
+    s = te.create_schedule(Y.op)
+    func = tvm.build(s, [X, W.data, W.indices, B, Y], "llvm")
+    Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype="float32"))
+    func(tvm.nd.array(X_np), W_ell.data, W_ell.indices, tvm.nd.array(B_np), Y_tvm)
+    tvm.testing.assert_allclose(Y_tvm.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
+def test_sparse_dense_bsr_placeholder():
+    M, N, K, BS_R, BS_C = 3, 24, 40, 4, 2
+    X_np = np.random.randn(M, K).astype("float32")
+    W_np = np.asarray(random_bsr_matrix(N, K, BS_R, BS_C, density=0.2, dtype="float32").todense())
+    B_np = np.random.randn(N).astype("float32")
+    W_bsr = tvmsp.array(W_np, stype="bsr", blocksize=(BS_R, BS_C))
+    Y_np = X_np.dot(W_np.T) + B_np
+
+    X = te.placeholder(shape=X_np.shape, dtype="float32")
+    B = te.placeholder(shape=B_np.shape, dtype="float32")
+    W = tvmsp.placeholder(
+        shape=W_np.shape, nonzeros=W_bsr.data.shape[0], stype="bsr", blocksize=(BS_R, BS_C)
+    )
+    Y = topi.sparse.dense(X, W, B)
+    s = te.create_schedule(Y.op)
+    func = tvm.build(s, [X, W.data, W.indices, W.indptr, B, Y], "llvm")
+    Y_tvm = tvm.nd.array(np.zeros(Y_np.shape, dtype="float32"))
+    func(tvm.nd.array(X_np), W_bsr.data, W_bsr.indices, W_bsr.indptr, tvm.nd.array(B_np), Y_tvm)
+    tvm.testing.assert_allclose(Y_tvm.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+
+
+def test_sparse_default_block_size():
+    assert topi.nn.sparse_default_block_size() == (1, 1)
+    for target, blocksize in [
+        ("llvm -mcpu=skylake-avx512", (16, 1)),
+        ("llvm -mcpu=core-avx2", (8, 1)),
+        ("llvm -device=arm_cpu -mtriple=aarch64-linux-gnu", (4, 1)),
+    ]:
+        with tvm.target.Target(target):
+            assert tuple(topi.nn.sparse_default_block_size()) == blocksize
+
+
 if __name__ == "__main__":
     test_csrmv()
     test_csrmm()
@@ -429,3 +535,7 @@ if __name__ == "__main__":
     test_sparse_dense_bsr()
     test_sparse_dense_bsr_randomized()
     test_sparse_transpose_csr()
+    test_sparse_conv2d()
+    test_sparse_dense_ell()
+    test_sparse_dense_bsr_placeholder()
+    test_sparse_default_block_size()
@@ -916,6 +916,46 @@ def test_cast_simplify():
                 ck.verify(tvm.tir.Cast(dtype1, tvm.tir.const(i, dtype2)), tvm.tir.const(i, dtype1))
 
 
+def test_simplify_cache():
+    analyzer = tvm.arith.Analyzer()
+    x, y = te.var("x"), te.var("y")
+    expr = tvm.tir.floordiv(x * 4 + y, 4)
+    assert analyzer.simplify_cache_stats == (0, 0)
+    first = analyzer.simplify(expr)
+    # The same expression reuses the memoized result.
+    hits, misses = analyzer.simplify_cache_stats
+    assert analyzer.simplify(expr).same_as(first)
+    assert analyzer.simplify_cache_stats == (hits + 1, misses)
+    # Entries are keyed by identity, an equal expression is simplified again.
+    second = analyzer.simplify(tvm.tir.floordiv(x * 4 + y, 4))
+    assert analyzer.simplify_cache_stats[0] == hits + 1
+    tvm.ir.assert_structural_equal(first, second)
+
+    # Constraints and bindings invalidate the memo.
+    constraint = y < 4
+    reference = tvm.arith.Analyzer()
+    with reference.constraint_scope(constraint):
+        expected = reference.simplify(expr)
+    with analyzer.constraint_scope(constraint):
+        tvm.ir.assert_structural_equal(analyzer.simplify(expr), expected)
+    tvm.ir.assert_structural_equal(analyzer.simplify(expr), first)
+    analyzer.bind(y, tvm.ir.Range(0, 4))
+    tvm.ir.assert_structural_equal(analyzer.simplify(expr), x)
+
+
+def test_simplify_cache_reduce():
+    analyzer = tvm.arith.Analyzer()
+    A = te.placeholder((16,), name="A")
+    k1 = te.reduce_axis((0, 16), name="k")
+    k2 = te.reduce_axis((0, 16), name="k")
+    # Structurally equal reductions over distinct axes keep their own axis.
+    r1 = analyzer.canonical_simplify(te.sum(A[k1] + 0, axis=k1))
+    r2 = analyzer.canonical_simplify(te.sum(A[k2] + 0, axis=k2))
+    assert r1.axis[0].same_as(k1)
+    assert r2.axis[0].same_as(k2)
+    assert r2.source[0].indices[0].same_as(k2.var)
+
+
 if __name__ == "__main__":
     test_floordiv_index_simplify()
     test_floormod_index_simplify()
@@ -932,3 +972,5 @@ if __name__ == "__main__":
     test_logical_simplify()
     test_let_simplify()
     test_cast_simplify()
+    test_simplify_cache()
+    test_simplify_cache_reduce()
@@ -20,6 +20,7 @@ import copy
 import glob
 import os
 import pty
+import struct
 import sys
 import subprocess
 import textwrap
@@ -29,6 +30,7 @@ import numpy as np
 import tvm
 import tvm.relay
 import tvm.micro
+from tvm.contrib import cc, util
 from tvm.micro import transport
 
 from tvm.topi.util import get_const_tuple
@@ -102,6 +104,41 @@ def test_compile_runtime():
         assert (C_data.asnumpy() == np.array([6, 7])).all()
 
 
+def _check_timed_add(time_add):
+    """Run time_add(sess, system_lib, A, B, C) on the add function of _make_add_sess."""
+    workspace = tvm.micro.Workspace()
+
+    with _make_add_sess(workspace) as sess:
+        A_data = tvm.nd.array(np.array([2, 3], dtype="int8"), ctx=sess.context)
+        B_data = tvm.nd.array(np.array([4], dtype="int8"), ctx=sess.context)
+        C_data = tvm.nd.array(np.array([0, 0], dtype="int8"), ctx=sess.context)
+
+        time_add(sess, sess.get_system_lib(), A_data, B_data, C_data)
+        assert (C_data.asnumpy() == np.array([6, 7])).all()
+
+
+def test_call_repeated():
+    """Test timing a function on the device."""
+
+    def time_add(sess, system_lib, *args):
+        call_repeated = sess._rpc.get_function("tvm.rpc.server.CallRepeated")
+        assert call_repeated(system_lib, "add", 10, *args) > 0
+
+    _check_timed_add(time_add)
+
+
+def test_time_evaluator():
+    """Test timing a function with the time evaluator of the device."""
+
+    def time_add(sess, system_lib, *args):
+        timer = system_lib.time_evaluator("add", sess.context, number=5, repeat=3)
+        result = timer(*args)
+        assert len(result.results) == 3
+        assert all(t > 0 for t in result.results)
+
+    _check_timed_add(time_add)
+
+
 def test_reset():
     """Test when the remote end resets during a session."""
     workspace = tvm.micro.Workspace()
@@ -144,7 +181,138 @@ def test_graph_runtime():
         assert (out.asnumpy() == np.array([6, 10])).all()
 
 
+def test_binary_graph():
+    """Test the binary graph run in place by the C runtime."""
+    relay_mod = tvm.parser.fromtext(
+        """
+      #[version = "0.0.5"]
+      def @main(%a : Tensor[(1, 2), uint8], %b : Tensor[(1, 2), uint8]) {
+          %0 = %a + %b;
+          %0
+      }"""
+    )
+    params = {"b": np.array([[4, 7]], dtype="uint8")}
+    build_module = tvm.relay.build_module.BuildModule()
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        graph_json, _, _ = build_module.build(relay_mod, target=TARGET)
+    # The add kernel needs no workspace.
+    assert tvm.micro.kernel_workspace_size(build_module.get_irmodule()) == 0
+
+    blob = tvm.micro.serialize_graph(graph_json, params, kernel_workspace_size=256)
+    header = tvm.micro.binary_graph.parse_header(blob)
+    assert header["total_size"] == len(blob)
+    assert header["num_inputs"] == 1 and header["num_params"] == 1
+    assert header["num_ops"] == 1 and header["num_op_args"] == 3
+    _, data_offset, nbytes, _ = struct.unpack_from("<4I", blob, header["params_offset"])
+    assert data_offset % header["alignment"] == 0 and nbytes == 2
+    assert bytes(blob[data_offset : data_offset + 2]) == bytes([4, 7])
+    # Only the storages of a and of the output are in the workspace.
+    assert header["workspace_size"] == 2 * header["alignment"]
+    assert header["kernel_workspace_size"] == 256
+    # Alignment padding, workspace, kernel workspace, then 3 DLTensors, 1 function
+    # and the values and type codes of 3 arguments on a 32 bit device.
+    assert tvm.micro.memory_size(blob) == 63 + 128 + 256 + 120 + 8 + 24 + 16
+
+
+# Loads a binary graph from a file with the C runtime, runs it on the input
+# given on the command line and prints the memory size and the output.
+_BINARY_GRAPH_DRIVER = """
+#include <stdio.h>
+#include <stdlib.h>
+#include <tvm/runtime/crt/binary_graph_runtime.h>
+#include <tvm/runtime/crt/crt.h>
+#include <tvm/runtime/crt/platform.h>
+
+void TVMPlatformAbort(tvm_crt_error_t code) {
+  fprintf(stderr, "TVMPlatformAbort: %x\\n", code);
+  exit(2);
+}
+
+void TVMLogf(const char* fmt, ...) {}
+
+static uint8_t crt_memory[256 * 1024];
+static uint8_t graph_memory[64 * 1024];
+static uint8_t graph[64 * 1024] __attribute__((aligned(64)));
+
+int main(int argc, char** argv) {
+  FILE* file = fopen(argv[1], "rb");
+  size_t graph_size = fread(graph, 1, sizeof(graph), file);
+  fclose(file);
+  if (TVMInitializeRuntime(crt_memory, sizeof(crt_memory), 8) != kTvmErrorNoError) return 1;
+
+  TVMFunctionHandle create_system_lib;
+  TVMValue ret_value;
+  int ret_type_code;
+  if (TVMFuncGetGlobal("runtime.SystemLib", &create_system_lib) != 0) return 1;
+  if (TVMFuncCall(create_system_lib, NULL, NULL, 0, &ret_value, &ret_type_code) != 0) return 1;
+
+  size_t memory_size = TVMBinaryGraphRuntime_MemorySize(graph, graph_size);
+  TVMBinaryGraphRuntime runtime;
+  DLContext ctx = {kDLCPU, 0};
+  if (TVMBinaryGraphRuntime_Init(&runtime, graph, graph_size, ret_value.v_handle, ctx,
+                                 graph_memory, memory_size) != kTvmErrorNoError) {
+    return 1;
+  }
+  DLTensor* a = TVMBinaryGraphRuntime_GetInput(&runtime,
+                                               TVMBinaryGraphRuntime_GetInputIndex(&runtime, "a"));
+  ((uint8_t*)a->data)[0] = atoi(argv[2]);
+  ((uint8_t*)a->data)[1] = atoi(argv[3]);
+  if (TVMBinaryGraphRuntime_Run(&runtime) != 0) return 1;
+  DLTensor* out = TVMBinaryGraphRuntime_GetOutput(&runtime, 0);
+  printf("%zu %d %d\\n", memory_size, ((uint8_t*)out->data)[0], ((uint8_t*)out->data)[1]);
+  return 0;
+}
+"""
+
+
+def test_binary_graph_round_trip():
+    """Test that the C runtime runs the binary graph serialize_graph produces."""
+    relay_mod = tvm.parser.fromtext(
+        """
+      #[version = "0.0.5"]
+      def @main(%a : Tensor[(1, 2), uint8], %b : Tensor[(1, 2), uint8]) {
+          %0 = %a + %b;
+          %0
+      }"""
+    )
+    params = {"b": np.array([[4, 7]], dtype="uint8")}
+    build_module = tvm.relay.build_module.BuildModule()
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        graph_json, lib, _ = build_module.build(relay_mod, target=TARGET)
+    blob = tvm.micro.serialize_graph(graph_json, params)
+
+    temp = util.tempdir()
+    with open(temp.relpath("graph.bin"), "wb") as graph_file:
+        graph_file.write(blob)
+    lib.save(temp.relpath("module.c"), "cc")
+    with open(temp.relpath("driver.c"), "w") as driver_file:
+        driver_file.write(_BINARY_GRAPH_DRIVER)
+    srcs = [temp.relpath("driver.c"), temp.relpath("module.c")]
+    for lib_name in ("common", "graph_runtime"):
+        srcs += glob.glob(os.path.join(tvm.micro.CRT_ROOT_DIR, lib_name, "*.c"))
+    include_dirs = [
+        os.path.join(tvm.micro.TVM_ROOT_DIR, "include"),
+        os.path.join(tvm.micro.TVM_ROOT_DIR, "3rdparty", "dlpack", "include"),
+        os.path.join(tvm.micro.CRT_ROOT_DIR, "include"),
+        os.path.join(tvm.micro.CRT_ROOT_DIR, "host"),
+    ]
+    driver = temp.relpath("driver")
+    cc.create_executable(
+        driver, srcs, ["-I" + d for d in include_dirs] + ["-lm"], cc="gcc"
+    )
+
+    output = subprocess.check_output([driver, temp.relpath("graph.bin"), "2", "3"])
+    memory_size, out_0, out_1 = [int(x) for x in output.split()]
+    assert (out_0, out_1) == (6, 10)
+    # The size computed at build time is the size the device asks for.
+    assert memory_size == tvm.micro.memory_size(blob, pointer_size=struct.calcsize("P"))
+
+
 if __name__ == "__main__":
     test_compile_runtime()
+    test_call_repeated()
+    test_time_evaluator()
     test_reset()
     test_graph_runtime()
+    test_binary_graph()
+    test_binary_graph_round_trip()
@@ -150,6 +150,27 @@ def test_dict():
     assert set(dir(x.__class__)) <= set(dir(x))
 
 
+def test_saveload_binary():
+    import numpy as np
+    from tvm import relay
+
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    w = relay.const(np.random.uniform(size=(8, 8)).astype("float32"))
+    y = relay.nn.dense(x, w)
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.add(y, relay.const(-1.5))))
+    mod = relay.transform.InferType()(mod)
+    mod2 = tvm.ir.load_binary(tvm.ir.save_binary(mod))
+    tvm.ir.assert_structural_equal(mod, mod2)
+    np.testing.assert_equal(mod2["main"].body.args[0].args[1].data.asnumpy(), w.data.asnumpy())
+
+    n = te.var("n")
+    stmt = tvm.tir.Evaluate(tvm.tir.Add(n.astype("int64"), tvm.tir.const(-(2 ** 40), "int64")))
+    tvm.ir.assert_structural_equal(stmt, tvm.ir.load_binary(tvm.ir.save_binary(stmt)))
+    smap = tvm.runtime.convert({"a": 1, "b": [1.5, "c"]})
+    smap2 = tvm.ir.load_binary(tvm.ir.save_binary(smap))
+    assert smap2["a"].value == 1 and smap2["b"][1] == "c"
+
+
 if __name__ == "__main__":
     test_string()
     test_env_func()
@@ -160,3 +181,4 @@ if __name__ == "__main__":
     test_pass_config()
     test_dict()
     test_infinity_value()
+    test_saveload_binary()
@@ -0,0 +1,111 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import threading
+
+import numpy as np
+import pytest
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import graph_runtime, batching_runtime
+
+
+def _make_mod(batch):
+    x = relay.var("x", shape=(batch, 8), dtype="float32")
+    w = relay.const(np.arange(8, dtype="float32"))
+    y = relay.add(relay.multiply(x, relay.const(2.0)), w)
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def _reference(x):
+    return x * 2.0 + np.arange(8, dtype="float32")
+
+
+def _run_concurrently(rt, num_threads):
+    inputs = [np.random.uniform(size=(1, 8)).astype("float32") for _ in range(num_threads)]
+    results = [None] * num_threads
+
+    def worker(i):
+        results[i] = rt.submit(inputs[i])[0].asnumpy()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(num_threads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    for x, res in zip(inputs, results):
+        tvm.testing.assert_allclose(res, _reference(x), rtol=1e-5)
+
+
+def _submit_many(rt, num_requests):
+    inputs = [np.random.uniform(size=(1, 8)).astype("float32") for _ in range(num_requests)]
+    results = rt.submit_many([[x] for x in inputs])
+    for x, res in zip(inputs, results):
+        tvm.testing.assert_allclose(res[0].asnumpy(), _reference(x), rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_batching_graph_runtime():
+    buckets = {}
+    for batch in [1, 2, 4]:
+        with tvm.transform.PassContext(opt_level=3):
+            lib = relay.build(_make_mod(batch), "llvm")
+        buckets[batch] = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+
+    rt = batching_runtime.create_graph(buckets, timeout_us=20000)
+    _run_concurrently(rt, 8)
+    assert rt.num_batches <= 8
+
+    # Requests queued together are coalesced into full batches of the largest bucket.
+    num_batches = rt.num_batches
+    _submit_many(rt, 8)
+    assert rt.num_batches - num_batches == 2
+
+    # A request with several rows is split back correctly.
+    x = np.random.uniform(size=(3, 8)).astype("float32")
+    tvm.testing.assert_allclose(rt.submit(x)[0].asnumpy(), _reference(x), rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_batching_vm():
+    mod = _make_mod(relay.Any())
+    exe = relay.vm.compile(mod, "llvm")
+    vm = tvm.runtime.vm.VirtualMachine(exe, tvm.cpu())
+
+    rt = batching_runtime.create_vm(vm, max_batch_size=4, timeout_us=20000)
+    _run_concurrently(rt, 8)
+    assert rt.num_batches <= 8
+
+    num_batches = rt.num_batches
+    _submit_many(rt, 6)
+    assert rt.num_batches - num_batches == 2
+
+
+@tvm.testing.requires_llvm
+def test_batching_max_batch_size():
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(_make_mod(2), "llvm")
+    buckets = {2: graph_runtime.GraphModule(lib["default"](tvm.cpu()))}
+    # A batch larger than every bucket could never be run.
+    with pytest.raises(tvm.error.TVMError):
+        batching_runtime.create_graph(buckets, max_batch_size=4)
+
+
+if __name__ == "__main__":
+    test_batching_graph_runtime()
+    test_batching_vm()
+    test_batching_max_batch_size()
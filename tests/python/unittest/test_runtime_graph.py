@@ -120,5 +120,136 @@ def test_graph_simple():
     check_sharing()
 
 
+@tvm.testing.requires_llvm
+def test_graph_stream_schedule():
+    from tvm import relay
+
+    x = relay.var("x", shape=(2, 8))
+    y = relay.var("y", shape=(2, 8))
+    z = relay.exp(relay.add(x, y))
+    z = relay.subtract(relay.multiply(z, y), x)
+    func = relay.Function([x, y], z)
+    with tvm.transform.PassContext(opt_level=0):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm")
+
+    x_in = np.random.uniform(size=(2, 8)).astype("float32")
+    y_in = np.random.uniform(size=(2, 8)).astype("float32")
+    mod = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+    mod.set_stream_schedule(True)
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(
+        mod.get_output(0).asnumpy(), np.exp(x_in + y_in) * y_in - x_in, rtol=1e-5
+    )
+    mod.set_stream_schedule(False)
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(
+        mod.get_output(0).asnumpy(), np.exp(x_in + y_in) * y_in - x_in, rtol=1e-5
+    )
+
+
+@tvm.testing.requires_llvm
+@tvm.testing.requires_cuda
+def test_graph_stream_schedule_heterogeneous():
+    from tvm import relay
+
+    # sqrt and exp run on the gpu, so the schedule issues them on the compute
+    # stream and the device copies around them on the copy stream.
+    cpu_ctx = tvm.cpu(0)
+    gpu_ctx = tvm.gpu(0)
+    x = relay.var("x", shape=(16, 32))
+    y = relay.var("y", shape=(16, 32))
+    add = relay.add(x, y)
+    sqrt = relay.annotation.on_device(relay.sqrt(add), gpu_ctx)
+    subtract = relay.subtract(sqrt, relay.log(add))
+    exp = relay.annotation.on_device(relay.exp(subtract), gpu_ctx)
+    func = relay.Function([x, y], relay.multiply(exp, add))
+    config = {"relay.fallback_device_type": cpu_ctx.device_type}
+    with tvm.transform.PassContext(opt_level=1, config=config):
+        graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), {"cpu": "llvm", "cuda": "cuda"})
+    assert gpu_ctx.device_type in json.loads(graph)["attrs"]["device_index"][1]
+
+    mod = graph_runtime.create(graph, lib, [cpu_ctx, gpu_ctx])
+    mod.set_stream_schedule(True)
+    # Run several times, so that a missing wait reads the data of the previous run.
+    for _ in range(3):
+        x_in = np.random.uniform(1, 2, size=(16, 32)).astype("float32")
+        y_in = np.random.uniform(1, 2, size=(16, 32)).astype("float32")
+        s = x_in + y_in
+        mod.run(x=x_in, y=y_in)
+        tvm.testing.assert_allclose(
+            mod.get_output(0).asnumpy(), np.exp(np.sqrt(s) - np.log(s)) * s, rtol=1e-5
+        )
+    mod.set_stream_schedule(False)
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(
+        mod.get_output(0).asnumpy(), np.exp(np.sqrt(s) - np.log(s)) * s, rtol=1e-5
+    )
+
+
+@tvm.testing.requires_llvm
+def test_graph_storage_arena():
+    from tvm import relay
+
+    x = relay.var("x", shape=(4, 16))
+    w = relay.const(np.random.uniform(size=(4, 16)).astype("float32"))
+    z = relay.nn.relu(relay.add(relay.exp(x), w))
+    func = relay.Function([x], relay.multiply(z, w))
+    with tvm.transform.PassContext(opt_level=0):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm")
+
+    x_in = np.random.uniform(size=(4, 16)).astype("float32")
+    mod = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+    mod.run(x=x_in)
+    expected = mod.get_output(0).asnumpy()
+
+    # Parameters loaded before switching to the arena are preserved.
+    mod.set_storage_arena(use_huge_pages=True)
+    mod.run(x=x_in)
+    tvm.testing.assert_allclose(mod.get_output(0).asnumpy(), expected, rtol=1e-5)
+
+    size = mod.get_storage_arena_size(tvm.cpu())
+    assert size > 0
+    arena = tvm.nd.empty((size,), "uint8", tvm.cpu())
+    mod.set_storage_arena(arena)
+    mod.run(x=x_in)
+    tvm.testing.assert_allclose(mod.get_output(0).asnumpy(), expected, rtol=1e-5)
+    # The storage now lives in the user supplied arena.
+    assert np.any(arena.asnumpy() != 0)
+
+
+@tvm.testing.requires_llvm
+def test_graph_storage_arena_reuse():
+    from tvm import relay
+
+    # The planner cannot reuse the 4096 byte block of exp(x) for the 64 byte
+    # results, but they can share its bytes in the arena once it is dead.
+    x = relay.var("x", shape=(1, 1024))
+    y = relay.exp(relay.strided_slice(relay.exp(x), begin=[0, 0], end=[1, 16]))
+    func = relay.Function([x], relay.exp(y))
+    with tvm.transform.PassContext(opt_level=0):
+        lib = relay.build(tvm.IRModule.from_expr(func), "llvm")
+
+    attrs = json.loads(lib.get_json())["attrs"]
+    entry_bytes = {}
+    for sid, shape, dtype in zip(attrs["storage_id"][1], attrs["shape"][1], attrs["dltype"][1]):
+        nbytes = int(np.prod(shape)) * np.dtype(dtype).itemsize
+        entry_bytes[sid] = max(entry_bytes.get(sid, 0), nbytes)
+    unshared = sum((nbytes + 63) // 64 * 64 for nbytes in entry_bytes.values())
+
+    x_in = np.random.uniform(size=(1, 1024)).astype("float32")
+    mod = graph_runtime.GraphModule(lib["default"](tvm.cpu()))
+    mod.set_storage_arena()
+    assert mod.get_storage_arena_size(tvm.cpu()) < unshared
+    for _ in range(2):
+        mod.run(x=x_in)
+        tvm.testing.assert_allclose(
+            mod.get_output(0).asnumpy(), np.exp(np.exp(np.exp(x_in)[:, :16])), rtol=1e-5
+        )
+
+
 if __name__ == "__main__":
     test_graph_simple()
+    test_graph_stream_schedule()
+    test_graph_stream_schedule_heterogeneous()
+    test_graph_storage_arena()
+    test_graph_storage_arena_reuse()
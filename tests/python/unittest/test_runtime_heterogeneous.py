@@ -414,6 +414,15 @@ def test_duplex_data_transferring():
             out = mod.get_output(0, tvm.nd.empty(shape))
             np.testing.assert_equal(out.asnumpy(), tensor_a + tensor_b - tensor_c + tensor_d)
 
+        def check_stream_schedule():
+            mod = graph_runtime.create(graph, mhost, ctx)
+            mod.set_stream_schedule(True)
+            mod.set_input(**params)
+            for _ in range(2):
+                mod.run()
+                out = mod.get_output(0, tvm.nd.empty(shape))
+                np.testing.assert_equal(out.asnumpy(), tensor_a + tensor_b - tensor_c + tensor_d)
+
         def check_load_module():
             temp = util.tempdir()
             path_lib = temp.relpath("deploy.so")
@@ -430,6 +439,7 @@ def test_duplex_data_transferring():
 
         check_verify()
         check_load_module()
+        check_stream_schedule()
 
     dev_tar = {"cuda": "cuda", "opencl": "opencl"}
     for device, target in dev_tar.items():
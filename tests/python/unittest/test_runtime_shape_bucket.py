@@ -0,0 +1,84 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import shape_bucket_runtime
+
+
+def _dynamic_mod():
+    x = relay.var("x", shape=(1, relay.Any()), dtype="float32")
+    y = relay.nn.relu(relay.add(x, relay.const(1.0)))
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def _check(rt, seq_len):
+    x = np.random.uniform(-1, 1, size=(1, seq_len)).astype("float32")
+    out = rt.run(x)[0].asnumpy()
+    tvm.testing.assert_allclose(out, np.maximum(x + 1.0, 0.0), rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_static_specializations():
+    rt = shape_bucket_runtime.create(
+        _dynamic_mod(), "llvm", tvm.cpu(), shapes=[[(1, 16)], [(1, 32)]]
+    )
+    assert rt.num_specializations == 2
+    _check(rt, 16)
+    _check(rt, 32)
+    assert rt.num_fallback_runs == 0
+    # Unseen shapes run on the VM.
+    _check(rt, 7)
+    assert rt.num_fallback_runs == 1
+
+
+@tvm.testing.requires_llvm
+def test_hot_shape_compilation():
+    rt = shape_bucket_runtime.create(_dynamic_mod(), "llvm", tvm.cpu(), hot_threshold=2)
+    _check(rt, 10)
+    _check(rt, 10)
+    rt.wait_for_compile()
+    assert rt.num_specializations == 1
+    _check(rt, 10)
+    assert rt.num_fallback_runs == 2
+
+
+@tvm.testing.requires_llvm
+def test_params():
+    x = relay.var("x", shape=(1, relay.Any()), dtype="float32")
+    w = relay.var("w", shape=(1, 1), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x, w], relay.nn.relu(relay.add(x, w))))
+    params = {"w": np.ones((1, 1), dtype="float32")}
+    rt = shape_bucket_runtime.create(
+        mod, "llvm", tvm.cpu(), shapes=[[(1, 16)]], params=params, hot_threshold=2
+    )
+    assert rt.num_specializations == 1
+    _check(rt, 16)
+    # A hot shape is compiled with the bound parameters too.
+    _check(rt, 10)
+    _check(rt, 10)
+    rt.wait_for_compile()
+    assert rt.num_specializations == 2
+    _check(rt, 10)
+    assert rt.num_fallback_runs == 2
+
+
+if __name__ == "__main__":
+    test_static_specializations()
+    test_hot_shape_compilation()
+    test_params()
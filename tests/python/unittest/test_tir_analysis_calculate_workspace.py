@@ -0,0 +1,56 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def test_calculate_workspace_bytes():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    # Sequential workspaces reuse the same memory, nested ones add up.
+    with ib.for_range(0, n, name="i"):
+        a = ib.allocate("float32", 1000, name="a", scope="global")
+        a[0] = 0.0
+        with ib.for_range(0, n, name="j"):
+            b = ib.allocate("int8", 3000, name="b", scope="global")
+            b[0] = tvm.tir.const(0, "int8")
+    c = ib.allocate("float32", 1500, name="c", scope="global")
+    c[0] = 0.0
+    # Small allocations stay on the stack, local ones are not workspaces.
+    d = ib.allocate("float32", 16, name="d", scope="global")
+    d[0] = 0.0
+    e = ib.allocate("float32", 100000, name="e", scope="local")
+    e[0] = 0.0
+    func = tvm.tir.PrimFunc([n], ib.get())
+
+    assert tvm.tir.analysis.calculate_workspace_bytes(func, 1) == 7000
+    assert tvm.tir.analysis.calculate_workspace_bytes(func, 64) == 4032 + 3008
+
+
+def test_calculate_workspace_bytes_dynamic():
+    ib = tvm.tir.ir_builder.create()
+    n = te.var("n")
+    a = ib.allocate("float32", n, name="a", scope="global")
+    a[0] = 0.0
+    func = tvm.tir.PrimFunc([n], ib.get())
+
+    assert tvm.tir.analysis.calculate_workspace_bytes(func, 64) == -1
+
+
+if __name__ == "__main__":
+    test_calculate_workspace_bytes()
+    test_calculate_workspace_bytes_dynamic()
@@ -14,6 +14,9 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import threading
+
+import numpy as np
 import tvm
 import tvm.testing
 from tvm import te
@@ -63,6 +66,98 @@ def test_cow_pass():
     assert func_hash == mod["main"].__hash__()
 
 
+def test_parallel_pass():
+    funcs = {}
+    for i in range(16):
+        n = te.var("n")
+        stmt = tvm.tir.Evaluate(tvm.tir.Max(n * 2 + i, n * 2 + i) + 0)
+        funcs["func%d" % i] = tvm.tir.PrimFunc([n], stmt)
+    mod = tvm.IRModule(funcs)
+    expected = tvm.tir.transform.Simplify()(mod)
+    with tvm.transform.PassContext(config={"tir.parallel_function_passes": 4}):
+        actual = tvm.tir.transform.Simplify()(mod)
+    tvm.ir.assert_structural_equal(actual, expected)
+
+    # Passes defined in python still run sequentially.
+    with tvm.transform.PassContext(config={"tir.parallel_function_passes": -1}):
+        actual = tvm.tir.transform.Apply(lambda f: f.with_attr("target_bits", 32))(mod)
+    assert all(f.attrs["target_bits"] == 32 for f in actual.functions.values())
+
+
+
+def test_parallel_pass_python_callbacks():
+    # Memory info and trace functions defined in python are only called on the
+    # launching thread, which holds the interpreter lock.
+    threads = set()
+
+    @tvm.register_func("tvm.info.mem.local.parallel_test", override=True)
+    def mem_info():
+        threads.add(threading.get_ident())
+        return tvm.ir.make_node(
+            "MemoryInfo", unit_bits=16, max_simd_bits=32, max_num_bits=1 << 30, head_address=None
+        )
+
+    funcs = {}
+    for i in range(8):
+        ib = tvm.tir.ir_builder.create()
+        n = te.var("n")
+        with ib.for_range(0, n, name="i"):
+            for name in ["A", "B"]:
+                with ib.for_range(0, 10, name="j") as j:
+                    A = ib.allocate("float32", 200 + i, name=name, scope="local.parallel_test")
+                    A[j] = 1.2
+        funcs["func%d" % i] = tvm.tir.PrimFunc([n], ib.get())
+    mod = tvm.IRModule(funcs)
+    expected = tvm.tir.transform.StorageRewrite()(mod)
+
+    def trace(mod, info, is_before):
+        threads.add(threading.get_ident())
+
+    for trace_func in [None, trace]:
+        threads.clear()
+        config = {"tir.parallel_function_passes": 4}
+        with tvm.transform.PassContext(config=config, trace=trace_func):
+            actual = tvm.tir.transform.StorageRewrite()(mod)
+        tvm.ir.assert_structural_equal(actual, expected)
+        assert threads == {threading.get_ident()}
+
+def test_parallel_pass_concurrent_builds():
+    if not tvm.runtime.enabled("llvm"):
+        print("skip because llvm is not enabled")
+        return
+
+    def build_and_check(offset, errors):
+        try:
+            funcs = {}
+            for i in range(8):
+                A = te.placeholder((16,), name="A")
+                B = te.compute((16,), lambda j: A[j] + (offset + i), name="B")
+                s = te.create_schedule(B.op)
+                name = "add%d_%d" % (offset, i)
+                funcs[name] = tvm.lower(s, [A, B], name=name)[name]
+            with tvm.transform.PassContext(config={"tir.parallel_function_passes": 4}):
+                lib = tvm.build(tvm.IRModule(funcs), target="llvm")
+            a = tvm.nd.array(np.arange(16).astype("float32"))
+            for i in range(8):
+                b = tvm.nd.empty((16,), "float32")
+                lib["add%d_%d" % (offset, i)](a, b)
+                tvm.testing.assert_allclose(b.asnumpy(), a.asnumpy() + offset + i)
+        except Exception as err:  # pylint: disable=broad-except
+            errors.append(err)
+
+    # Two builds at once share the worker threads of the parallel passes.
+    errors = []
+    threads = [threading.Thread(target=build_and_check, args=(k * 100, errors)) for k in range(2)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert not errors, errors
+
+
 if __name__ == "__main__":
     test_cow_pass()
     test_prim_func_pass()
+    test_parallel_pass()
+    test_parallel_pass_python_callbacks()
+    test_parallel_pass_concurrent_builds()